@@ -32,6 +32,9 @@
 #define ITHACA_MAX_VELOCITY_LAYERS 8
 #define ITHACA_DEFAULT_VOICE_GAIN 1.0f
 
+// Multi-timbral mode: max number of parts (= MIDI channels) sharing one voice pool
+#define ITHACA_MAX_PARTS 16
+
 // Sample rates (Hz)
 #define ITHACA_DEFAULT_SAMPLE_RATE 44100
 #define ITHACA_MIN_SAMPLE_RATE 22050
@@ -42,6 +45,11 @@
 #define ITHACA_MIN_BLOCK_SIZE 32
 #define ITHACA_MAX_BLOCK_SIZE 4096
 
+// Internal processing sub-block: every host block (any size, incl. offline
+// renders above ITHACA_MAX_BLOCK_SIZE) is split into sub-blocks of this many
+// frames so voice gain buffers, mix lanes and scratch stay L1-resident
+#define ITHACA_INTERNAL_BLOCK_SIZE 128
+
 // MIDI parameters
 #define ITHACA_MIDI_NOTE_MIN 0
 #define ITHACA_MIDI_NOTE_MAX 127
@@ -57,6 +65,17 @@
 #define ITHACA_ENVELOPE_TRIGGERS_END_ATTACK  0.99f
 #define ITHACA_ENVELOPE_TRIGGERS_END_RELEASE 0.01f
 
+// Audibility-based early voice termination: sustaining/releasing voices whose
+// estimated peak (rest of sample * envelope * velocity, master gain excluded)
+// drops below the threshold are retired with a short linear micro-fade
+#define ITHACA_ENABLE_VOICE_AUDIBILITY_CULLING 1
+#define ITHACA_VOICE_AUDIBILITY_THRESHOLD_DB -90.0f
+#define ITHACA_VOICE_RETIRE_FADE_MS 5.0f
+
+// Smoothing of shared voice parameters (master gain, static pan): time of a
+// full-range sweep, applied per sub-block while a voice plays
+#define ITHACA_VOICE_PARAM_SMOOTHING_MS 20.0f
+
 // ============================================================================
 // LOGGING - Core Logger Configuration
 // ============================================================================
@@ -90,6 +109,15 @@
 #define ITHACA_VOICE_POOL_PREALLOCATE 1
 #define ITHACA_ENABLE_DENORMAL_PROTECTION 1
 
+// Envelope tables: mmapped binary cache, later starts skip curve generation.
+// Path is relative to the working directory (invalid/stale cache is regenerated).
+#define ITHACA_ENABLE_ENVELOPE_CACHE 0
+#define ITHACA_ENVELOPE_CACHE_FILE "envelope_cache.bin"
+
+// Multi-core voice rendering: fixed number of mix lanes (= max render threads).
+// Lane count defines the summation order, so output is identical for any thread count.
+#define ITHACA_RENDER_LANES 4
+
 // ============================================================================
 // DEBUG - Development & Testing
 // ============================================================================
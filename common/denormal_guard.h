@@ -0,0 +1,107 @@
+#ifndef DENORMAL_GUARD_H
+#define DENORMAL_GUARD_H
+
+#include "IthacaConfig.h"
+
+#include <cstdint>
+
+// ===== DENORMAL PROTECTION CONFIGURATION =====
+// Fallback pro nadřazený IthacaConfig.h bez této volby
+#ifndef ITHACA_ENABLE_DENORMAL_PROTECTION
+#define ITHACA_ENABLE_DENORMAL_PROTECTION 1
+#endif
+
+#if ITHACA_ENABLE_DENORMAL_PROTECTION
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <xmmintrin.h>
+#define DENORMAL_GUARD_MXCSR 1
+#elif defined(__aarch64__)
+#define DENORMAL_GUARD_FPCR 1
+#elif defined(__arm__) && defined(__VFP_FP__) && !defined(__SOFTFP__)
+#define DENORMAL_GUARD_FPSCR 1
+#endif
+#endif
+
+/**
+ * @class ScopedDenormalProtection
+ * @brief RAII zapnutí flush-to-zero (FTZ) a denormals-are-zero (DAZ) pro aktuální vlákno
+ *
+ * Doznívající release obálky, zpětná vazba biquadů a envelope followery
+ * (HarmonicEnhancer, Limiter) klesají do subnormálních čísel, kde x86
+ * zpomalí aritmetiku o řád. Guard na vstupu do RT cesty nastaví FTZ/DAZ
+ * a v destruktoru vrátí původní stav, takže hostitel ani volající kód
+ * nic nepozná.
+ *
+ * Platformy:
+ * - x86/x64: MXCSR bity FTZ (15) a DAZ (6)
+ * - AArch64: FPCR bit FZ (24) - flush vstupů i výstupů
+ * - ARMv7 VFP: FPSCR bit FZ (24)
+ * - jinde (nebo ITHACA_ENABLE_DENORMAL_PROTECTION 0) prázdná operace
+ *
+ * Vnořené guardy jsou levné: pokud jsou bity už nastavené, registr se
+ * nepřepisuje (jen se jednou přečte).
+ *
+ * @note RT-safe, noexcept; stav FPU je per-thread - guard platí jen pro
+ *       vlákno, které ho vytvořilo (render workers mají vlastní)
+ */
+class ScopedDenormalProtection {
+public:
+    ScopedDenormalProtection() noexcept {
+#if defined(DENORMAL_GUARD_MXCSR)
+        previous_ = _mm_getcsr();
+        const uint32_t wanted = previous_ | MXCSR_FTZ | MXCSR_DAZ;
+        changed_ = wanted != previous_;
+        if (changed_) _mm_setcsr(wanted);
+#elif defined(DENORMAL_GUARD_FPCR) || defined(DENORMAL_GUARD_FPSCR)
+        previous_ = readControl();
+        const uintptr_t wanted = previous_ | FZ_BIT;
+        changed_ = wanted != previous_;
+        if (changed_) writeControl(wanted);
+#endif
+    }
+
+    ~ScopedDenormalProtection() noexcept {
+#if defined(DENORMAL_GUARD_MXCSR)
+        if (changed_) _mm_setcsr(previous_);
+#elif defined(DENORMAL_GUARD_FPCR) || defined(DENORMAL_GUARD_FPSCR)
+        if (changed_) writeControl(previous_);
+#endif
+    }
+
+    ScopedDenormalProtection(const ScopedDenormalProtection&) = delete;
+    ScopedDenormalProtection& operator=(const ScopedDenormalProtection&) = delete;
+
+private:
+#if defined(DENORMAL_GUARD_MXCSR)
+    static constexpr uint32_t MXCSR_FTZ = 0x8000;
+    static constexpr uint32_t MXCSR_DAZ = 0x0040;
+
+    uint32_t previous_ = 0;
+    bool changed_ = false;
+#elif defined(DENORMAL_GUARD_FPCR) || defined(DENORMAL_GUARD_FPSCR)
+    static constexpr uintptr_t FZ_BIT = uintptr_t(1) << 24;
+
+    static uintptr_t readControl() noexcept {
+        uintptr_t value;
+#if defined(DENORMAL_GUARD_FPCR)
+        __asm__ __volatile__("mrs %0, fpcr" : "=r"(value));
+#else
+        __asm__ __volatile__("vmrs %0, fpscr" : "=r"(value));
+#endif
+        return value;
+    }
+
+    static void writeControl(uintptr_t value) noexcept {
+#if defined(DENORMAL_GUARD_FPCR)
+        __asm__ __volatile__("msr fpcr, %0" : : "r"(value));
+#else
+        __asm__ __volatile__("vmsr fpscr, %0" : : "r"(value));
+#endif
+    }
+
+    uintptr_t previous_ = 0;
+    bool changed_ = false;
+#endif
+};
+
+#endif // DENORMAL_GUARD_H
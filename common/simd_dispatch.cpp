@@ -0,0 +1,741 @@
+/**
+ * @file simd_dispatch.cpp
+ * @brief Detekce CPU a SIMD varianty hot kernelů (skalár, SSE2, AVX2, AVX-512, NEON)
+ */
+
+#include "simd_dispatch.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SIMD_DISPATCH_SSE2 1
+#if ITHACA_ENABLE_WIDE_SIMD && (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+#include <immintrin.h>
+#define SIMD_DISPATCH_WIDE 1
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define SIMD_DISPATCH_NEON 1
+#endif
+
+#if defined(SIMD_DISPATCH_WIDE)
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define SIMD_DISPATCH_MSVC_CPUID 1
+#else
+#include <cpuid.h>
+#endif
+
+// GCC/Clang: AVX2/AVX-512 jen pro jednotlivé funkce, zbytek binárky zůstává baseline.
+// AVX-512F obsahuje FMA - GCC by v C++ (výchozí -ffp-contract=fast) spojil mul + add
+// do FMA s jiným zaokrouhlením, proto kontrakci pro tyto funkce vypíná.
+// MSVC intrinsics širších ISA povoluje bez přepínače a nekontrahuje.
+#if defined(__clang__)
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#define SIMD_TARGET_AVX512 __attribute__((target("avx512f")))
+#elif defined(__GNUC__)
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2"), optimize("fp-contract=off")))
+#define SIMD_TARGET_AVX512 __attribute__((target("avx512f"), optimize("fp-contract=off")))
+#else
+#define SIMD_TARGET_AVX2
+#define SIMD_TARGET_AVX512
+#endif
+#endif
+
+namespace {
+
+// ============================================================================
+// Skalární kernely (úroveň Scalar a zbytky SIMD smyček od indexu begin)
+// ============================================================================
+
+inline void mixStereoTail(float* outLeft, float* outRight, const float* stereoSource,
+                          const float* envelopeGains, float leftGain, float rightGain,
+                          int begin, int numSamples) noexcept {
+    for (int i = begin; i < numSamples; ++i) {
+        const float gain = envelopeGains[i];
+        outLeft[i] += stereoSource[2 * i] * gain * leftGain;
+        outRight[i] += stereoSource[2 * i + 1] * gain * rightGain;
+    }
+}
+
+inline void mixStereoRampTail(float* outLeft, float* outRight, const float* stereoSource,
+                              const float* envelopeGains, float leftGain, float rightGain,
+                              float leftStep, float rightStep, int begin, int numSamples) noexcept {
+    for (int i = begin; i < numSamples; ++i) {
+        const float gain = envelopeGains[i];
+        const float t = static_cast<float>(i + 1);
+        outLeft[i] += stereoSource[2 * i] * gain * (leftGain + leftStep * t);
+        outRight[i] += stereoSource[2 * i + 1] * gain * (rightGain + rightStep * t);
+    }
+}
+
+inline void interleaveStereoTail(const float* left, const float* right, float* interleaved,
+                                 int begin, int numSamples) noexcept {
+    for (int i = begin; i < numSamples; ++i) {
+        interleaved[2 * i] = left[i];
+        interleaved[2 * i + 1] = right[i];
+    }
+}
+
+inline void applyGainTail(float* buffer, float gain, int begin, int numSamples) noexcept {
+    for (int i = begin; i < numSamples; ++i) {
+        buffer[i] *= gain;
+    }
+}
+
+inline void applyGainRampTail(float* buffer, float start, float slope,
+                              int begin, int numSamples) noexcept {
+    for (int i = begin; i < numSamples; ++i) {
+        buffer[i] *= start + slope * static_cast<float>(i + 1);
+    }
+}
+
+inline float peakAbsTail(const float* left, const float* right, float peak,
+                         int begin, int numSamples) noexcept {
+    for (int i = begin; i < numSamples; ++i) {
+        peak = std::max(peak, std::max(std::abs(left[i]), std::abs(right[i])));
+    }
+    return peak;
+}
+
+void mixStereoScalar(float* outLeft, float* outRight, const float* stereoSource,
+                     const float* envelopeGains, float leftGain, float rightGain,
+                     int numSamples) noexcept {
+    mixStereoTail(outLeft, outRight, stereoSource, envelopeGains, leftGain, rightGain, 0, numSamples);
+}
+
+void mixStereoRampScalar(float* outLeft, float* outRight, const float* stereoSource,
+                         const float* envelopeGains, float leftGain, float rightGain,
+                         float leftStep, float rightStep, int numSamples) noexcept {
+    mixStereoRampTail(outLeft, outRight, stereoSource, envelopeGains, leftGain, rightGain,
+                      leftStep, rightStep, 0, numSamples);
+}
+
+void interleaveStereoScalar(const float* left, const float* right, float* interleaved,
+                            int numSamples) noexcept {
+    interleaveStereoTail(left, right, interleaved, 0, numSamples);
+}
+
+void applyGainScalar(float* buffer, int numSamples, float gain) noexcept {
+    applyGainTail(buffer, gain, 0, numSamples);
+}
+
+void applyGainRampScalar(float* buffer, int numSamples, float start, float slope) noexcept {
+    applyGainRampTail(buffer, start, slope, 0, numSamples);
+}
+
+float peakAbsScalar(const float* left, const float* right, int numSamples) noexcept {
+    return peakAbsTail(left, right, 0.0f, 0, numSamples);
+}
+
+constexpr SimdDispatch::Kernels SCALAR_KERNELS = {
+    SimdDispatch::Level::Scalar, "Scalar",
+    mixStereoScalar, mixStereoRampScalar, interleaveStereoScalar, applyGainScalar, applyGainRampScalar, peakAbsScalar
+};
+
+#if defined(SIMD_DISPATCH_SSE2)
+// ============================================================================
+// SSE2 (x86-64 baseline)
+// ============================================================================
+
+void mixStereoSSE2(float* outLeft, float* outRight, const float* stereoSource,
+                   const float* envelopeGains, float leftGain, float rightGain,
+                   int numSamples) noexcept {
+    const __m128 leftGain4 = _mm_set1_ps(leftGain);
+    const __m128 rightGain4 = _mm_set1_ps(rightGain);
+    int i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        const __m128 a = _mm_loadu_ps(stereoSource + 2 * i);        // L0 R0 L1 R1
+        const __m128 b = _mm_loadu_ps(stereoSource + 2 * i + 4);    // L2 R2 L3 R3
+        const __m128 l = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 r = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        const __m128 gain = _mm_loadu_ps(envelopeGains + i);
+        _mm_storeu_ps(outLeft + i, _mm_add_ps(_mm_loadu_ps(outLeft + i),
+                                              _mm_mul_ps(_mm_mul_ps(l, gain), leftGain4)));
+        _mm_storeu_ps(outRight + i, _mm_add_ps(_mm_loadu_ps(outRight + i),
+                                               _mm_mul_ps(_mm_mul_ps(r, gain), rightGain4)));
+    }
+    mixStereoTail(outLeft, outRight, stereoSource, envelopeGains, leftGain, rightGain, i, numSamples);
+}
+
+void mixStereoRampSSE2(float* outLeft, float* outRight, const float* stereoSource,
+                       const float* envelopeGains, float leftGain, float rightGain,
+                       float leftStep, float rightStep, int numSamples) noexcept {
+    const __m128 leftGain4 = _mm_set1_ps(leftGain);
+    const __m128 rightGain4 = _mm_set1_ps(rightGain);
+    const __m128 leftStep4 = _mm_set1_ps(leftStep);
+    const __m128 rightStep4 = _mm_set1_ps(rightStep);
+    const __m128i lane = _mm_setr_epi32(1, 2, 3, 4);
+    int i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        const __m128 a = _mm_loadu_ps(stereoSource + 2 * i);
+        const __m128 b = _mm_loadu_ps(stereoSource + 2 * i + 4);
+        const __m128 l = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 r = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        const __m128 gain = _mm_loadu_ps(envelopeGains + i);
+        const __m128 t = _mm_cvtepi32_ps(_mm_add_epi32(_mm_set1_epi32(i), lane));
+        const __m128 left = _mm_add_ps(leftGain4, _mm_mul_ps(leftStep4, t));
+        const __m128 right = _mm_add_ps(rightGain4, _mm_mul_ps(rightStep4, t));
+        _mm_storeu_ps(outLeft + i, _mm_add_ps(_mm_loadu_ps(outLeft + i),
+                                              _mm_mul_ps(_mm_mul_ps(l, gain), left)));
+        _mm_storeu_ps(outRight + i, _mm_add_ps(_mm_loadu_ps(outRight + i),
+                                               _mm_mul_ps(_mm_mul_ps(r, gain), right)));
+    }
+    mixStereoRampTail(outLeft, outRight, stereoSource, envelopeGains, leftGain, rightGain,
+                      leftStep, rightStep, i, numSamples);
+}
+
+void interleaveStereoSSE2(const float* left, const float* right, float* interleaved,
+                          int numSamples) noexcept {
+    int i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        const __m128 l = _mm_loadu_ps(left + i);
+        const __m128 r = _mm_loadu_ps(right + i);
+        _mm_storeu_ps(interleaved + 2 * i, _mm_unpacklo_ps(l, r));      // L0 R0 L1 R1
+        _mm_storeu_ps(interleaved + 2 * i + 4, _mm_unpackhi_ps(l, r));  // L2 R2 L3 R3
+    }
+    interleaveStereoTail(left, right, interleaved, i, numSamples);
+}
+
+void applyGainSSE2(float* buffer, int numSamples, float gain) noexcept {
+    const __m128 gain4 = _mm_set1_ps(gain);
+    int i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        _mm_storeu_ps(buffer + i, _mm_mul_ps(_mm_loadu_ps(buffer + i), gain4));
+    }
+    applyGainTail(buffer, gain, i, numSamples);
+}
+
+void applyGainRampSSE2(float* buffer, int numSamples, float start, float slope) noexcept {
+    const __m128 start4 = _mm_set1_ps(start);
+    const __m128 slope4 = _mm_set1_ps(slope);
+    const __m128i lane = _mm_setr_epi32(1, 2, 3, 4);
+    int i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        const __m128 t = _mm_cvtepi32_ps(_mm_add_epi32(_mm_set1_epi32(i), lane));
+        const __m128 gain = _mm_add_ps(start4, _mm_mul_ps(slope4, t));
+        _mm_storeu_ps(buffer + i, _mm_mul_ps(_mm_loadu_ps(buffer + i), gain));
+    }
+    applyGainRampTail(buffer, start, slope, i, numSamples);
+}
+
+float peakAbsSSE2(const float* left, const float* right, int numSamples) noexcept {
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    __m128 peak4 = _mm_setzero_ps();
+    int i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        peak4 = _mm_max_ps(peak4, _mm_and_ps(_mm_loadu_ps(left + i), absMask));
+        peak4 = _mm_max_ps(peak4, _mm_and_ps(_mm_loadu_ps(right + i), absMask));
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, peak4);
+    const float peak = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+    return peakAbsTail(left, right, peak, i, numSamples);
+}
+
+constexpr SimdDispatch::Kernels SSE2_KERNELS = {
+    SimdDispatch::Level::SSE2, "SSE2",
+    mixStereoSSE2, mixStereoRampSSE2, interleaveStereoSSE2, applyGainSSE2, applyGainRampSSE2, peakAbsSSE2
+};
+#endif
+
+#if defined(SIMD_DISPATCH_WIDE)
+// ============================================================================
+// AVX2 (8 lanes)
+// ============================================================================
+
+SIMD_TARGET_AVX2
+void mixStereoAVX2(float* outLeft, float* outRight, const float* stereoSource,
+                   const float* envelopeGains, float leftGain, float rightGain,
+                   int numSamples) noexcept {
+    const __m256 leftGain8 = _mm256_set1_ps(leftGain);
+    const __m256 rightGain8 = _mm256_set1_ps(rightGain);
+    int i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+        const __m256 a = _mm256_loadu_ps(stereoSource + 2 * i);      // L0 R0 L1 R1 | L2 R2 L3 R3
+        const __m256 b = _mm256_loadu_ps(stereoSource + 2 * i + 8);  // L4 R4 L5 R5 | L6 R6 L7 R7
+        // shuffle v rámci 128-bit půlek (L0 L1 L4 L5 | L2 L3 L6 L7), permutace 64-bit dvojic srovná pořadí
+        const __m256 l = _mm256_castpd_ps(_mm256_permute4x64_pd(
+            _mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))), _MM_SHUFFLE(3, 1, 2, 0)));
+        const __m256 r = _mm256_castpd_ps(_mm256_permute4x64_pd(
+            _mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1))), _MM_SHUFFLE(3, 1, 2, 0)));
+        const __m256 gain = _mm256_loadu_ps(envelopeGains + i);
+        _mm256_storeu_ps(outLeft + i, _mm256_add_ps(_mm256_loadu_ps(outLeft + i),
+                                                    _mm256_mul_ps(_mm256_mul_ps(l, gain), leftGain8)));
+        _mm256_storeu_ps(outRight + i, _mm256_add_ps(_mm256_loadu_ps(outRight + i),
+                                                     _mm256_mul_ps(_mm256_mul_ps(r, gain), rightGain8)));
+    }
+    mixStereoTail(outLeft, outRight, stereoSource, envelopeGains, leftGain, rightGain, i, numSamples);
+}
+
+SIMD_TARGET_AVX2
+void mixStereoRampAVX2(float* outLeft, float* outRight, const float* stereoSource,
+                       const float* envelopeGains, float leftGain, float rightGain,
+                       float leftStep, float rightStep, int numSamples) noexcept {
+    const __m256 leftGain8 = _mm256_set1_ps(leftGain);
+    const __m256 rightGain8 = _mm256_set1_ps(rightGain);
+    const __m256 leftStep8 = _mm256_set1_ps(leftStep);
+    const __m256 rightStep8 = _mm256_set1_ps(rightStep);
+    const __m256i lane = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 8);
+    int i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+        const __m256 a = _mm256_loadu_ps(stereoSource + 2 * i);
+        const __m256 b = _mm256_loadu_ps(stereoSource + 2 * i + 8);
+        const __m256 l = _mm256_castpd_ps(_mm256_permute4x64_pd(
+            _mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))), _MM_SHUFFLE(3, 1, 2, 0)));
+        const __m256 r = _mm256_castpd_ps(_mm256_permute4x64_pd(
+            _mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1))), _MM_SHUFFLE(3, 1, 2, 0)));
+        const __m256 gain = _mm256_loadu_ps(envelopeGains + i);
+        const __m256 t = _mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_set1_epi32(i), lane));
+        const __m256 left = _mm256_add_ps(leftGain8, _mm256_mul_ps(leftStep8, t));
+        const __m256 right = _mm256_add_ps(rightGain8, _mm256_mul_ps(rightStep8, t));
+        _mm256_storeu_ps(outLeft + i, _mm256_add_ps(_mm256_loadu_ps(outLeft + i),
+                                                    _mm256_mul_ps(_mm256_mul_ps(l, gain), left)));
+        _mm256_storeu_ps(outRight + i, _mm256_add_ps(_mm256_loadu_ps(outRight + i),
+                                                     _mm256_mul_ps(_mm256_mul_ps(r, gain), right)));
+    }
+    mixStereoRampTail(outLeft, outRight, stereoSource, envelopeGains, leftGain, rightGain,
+                      leftStep, rightStep, i, numSamples);
+}
+
+SIMD_TARGET_AVX2
+void interleaveStereoAVX2(const float* left, const float* right, float* interleaved,
+                          int numSamples) noexcept {
+    int i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+        const __m256 l = _mm256_loadu_ps(left + i);
+        const __m256 r = _mm256_loadu_ps(right + i);
+        const __m256 low = _mm256_unpacklo_ps(l, r);     // L0 R0 L1 R1 | L4 R4 L5 R5
+        const __m256 high = _mm256_unpackhi_ps(l, r);    // L2 R2 L3 R3 | L6 R6 L7 R7
+        _mm256_storeu_ps(interleaved + 2 * i, _mm256_permute2f128_ps(low, high, 0x20));
+        _mm256_storeu_ps(interleaved + 2 * i + 8, _mm256_permute2f128_ps(low, high, 0x31));
+    }
+    interleaveStereoTail(left, right, interleaved, i, numSamples);
+}
+
+SIMD_TARGET_AVX2
+void applyGainAVX2(float* buffer, int numSamples, float gain) noexcept {
+    const __m256 gain8 = _mm256_set1_ps(gain);
+    int i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+        _mm256_storeu_ps(buffer + i, _mm256_mul_ps(_mm256_loadu_ps(buffer + i), gain8));
+    }
+    applyGainTail(buffer, gain, i, numSamples);
+}
+
+SIMD_TARGET_AVX2
+void applyGainRampAVX2(float* buffer, int numSamples, float start, float slope) noexcept {
+    const __m256 start8 = _mm256_set1_ps(start);
+    const __m256 slope8 = _mm256_set1_ps(slope);
+    const __m256i lane = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 8);
+    int i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+        const __m256 t = _mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_set1_epi32(i), lane));
+        const __m256 gain = _mm256_add_ps(start8, _mm256_mul_ps(slope8, t));
+        _mm256_storeu_ps(buffer + i, _mm256_mul_ps(_mm256_loadu_ps(buffer + i), gain));
+    }
+    applyGainRampTail(buffer, start, slope, i, numSamples);
+}
+
+SIMD_TARGET_AVX2
+float peakAbsAVX2(const float* left, const float* right, int numSamples) noexcept {
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    __m256 peak8 = _mm256_setzero_ps();
+    int i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+        peak8 = _mm256_max_ps(peak8, _mm256_and_ps(_mm256_loadu_ps(left + i), absMask));
+        peak8 = _mm256_max_ps(peak8, _mm256_and_ps(_mm256_loadu_ps(right + i), absMask));
+    }
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, peak8);
+    float peak = lanes[0];
+    for (int lane = 1; lane < 8; ++lane) peak = std::max(peak, lanes[lane]);
+    return peakAbsTail(left, right, peak, i, numSamples);
+}
+
+constexpr SimdDispatch::Kernels AVX2_KERNELS = {
+    SimdDispatch::Level::AVX2, "AVX2",
+    mixStereoAVX2, mixStereoRampAVX2, interleaveStereoAVX2, applyGainAVX2, applyGainRampAVX2, peakAbsAVX2
+};
+
+// ============================================================================
+// AVX-512F (16 lanes)
+// ============================================================================
+
+// GCC 12 avx512fintrin.h: _mm512_undefined_ps() hlásí falešné -Wmaybe-uninitialized
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+SIMD_TARGET_AVX512
+void mixStereoAVX512(float* outLeft, float* outRight, const float* stereoSource,
+                     const float* envelopeGains, float leftGain, float rightGain,
+                     int numSamples) noexcept {
+    const __m512 leftGain16 = _mm512_set1_ps(leftGain);
+    const __m512 rightGain16 = _mm512_set1_ps(rightGain);
+    // Indexy 0-15 = a, 16-31 = b: sudé pozice = L, liché = R
+    const __m512i evenIndex = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+    const __m512i oddIndex = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+    int i = 0;
+    for (; i + 16 <= numSamples; i += 16) {
+        const __m512 a = _mm512_loadu_ps(stereoSource + 2 * i);
+        const __m512 b = _mm512_loadu_ps(stereoSource + 2 * i + 16);
+        const __m512 l = _mm512_permutex2var_ps(a, evenIndex, b);
+        const __m512 r = _mm512_permutex2var_ps(a, oddIndex, b);
+        const __m512 gain = _mm512_loadu_ps(envelopeGains + i);
+        _mm512_storeu_ps(outLeft + i, _mm512_add_ps(_mm512_loadu_ps(outLeft + i),
+                                                    _mm512_mul_ps(_mm512_mul_ps(l, gain), leftGain16)));
+        _mm512_storeu_ps(outRight + i, _mm512_add_ps(_mm512_loadu_ps(outRight + i),
+                                                     _mm512_mul_ps(_mm512_mul_ps(r, gain), rightGain16)));
+    }
+    mixStereoTail(outLeft, outRight, stereoSource, envelopeGains, leftGain, rightGain, i, numSamples);
+}
+
+SIMD_TARGET_AVX512
+void mixStereoRampAVX512(float* outLeft, float* outRight, const float* stereoSource,
+                         const float* envelopeGains, float leftGain, float rightGain,
+                         float leftStep, float rightStep, int numSamples) noexcept {
+    const __m512 leftGain16 = _mm512_set1_ps(leftGain);
+    const __m512 rightGain16 = _mm512_set1_ps(rightGain);
+    const __m512 leftStep16 = _mm512_set1_ps(leftStep);
+    const __m512 rightStep16 = _mm512_set1_ps(rightStep);
+    const __m512i evenIndex = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+    const __m512i oddIndex = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+    const __m512i lane = _mm512_setr_epi32(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+    int i = 0;
+    for (; i + 16 <= numSamples; i += 16) {
+        const __m512 a = _mm512_loadu_ps(stereoSource + 2 * i);
+        const __m512 b = _mm512_loadu_ps(stereoSource + 2 * i + 16);
+        const __m512 l = _mm512_permutex2var_ps(a, evenIndex, b);
+        const __m512 r = _mm512_permutex2var_ps(a, oddIndex, b);
+        const __m512 gain = _mm512_loadu_ps(envelopeGains + i);
+        const __m512 t = _mm512_cvtepi32_ps(_mm512_add_epi32(_mm512_set1_epi32(i), lane));
+        const __m512 left = _mm512_add_ps(leftGain16, _mm512_mul_ps(leftStep16, t));
+        const __m512 right = _mm512_add_ps(rightGain16, _mm512_mul_ps(rightStep16, t));
+        _mm512_storeu_ps(outLeft + i, _mm512_add_ps(_mm512_loadu_ps(outLeft + i),
+                                                    _mm512_mul_ps(_mm512_mul_ps(l, gain), left)));
+        _mm512_storeu_ps(outRight + i, _mm512_add_ps(_mm512_loadu_ps(outRight + i),
+                                                     _mm512_mul_ps(_mm512_mul_ps(r, gain), right)));
+    }
+    mixStereoRampTail(outLeft, outRight, stereoSource, envelopeGains, leftGain, rightGain,
+                      leftStep, rightStep, i, numSamples);
+}
+
+SIMD_TARGET_AVX512
+void interleaveStereoAVX512(const float* left, const float* right, float* interleaved,
+                            int numSamples) noexcept {
+    // Indexy 0-15 = left, 16-31 = right
+    const __m512i lowIndex = _mm512_setr_epi32(0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+    const __m512i highIndex = _mm512_setr_epi32(8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+    int i = 0;
+    for (; i + 16 <= numSamples; i += 16) {
+        const __m512 l = _mm512_loadu_ps(left + i);
+        const __m512 r = _mm512_loadu_ps(right + i);
+        _mm512_storeu_ps(interleaved + 2 * i, _mm512_permutex2var_ps(l, lowIndex, r));
+        _mm512_storeu_ps(interleaved + 2 * i + 16, _mm512_permutex2var_ps(l, highIndex, r));
+    }
+    interleaveStereoTail(left, right, interleaved, i, numSamples);
+}
+
+SIMD_TARGET_AVX512
+void applyGainAVX512(float* buffer, int numSamples, float gain) noexcept {
+    const __m512 gain16 = _mm512_set1_ps(gain);
+    int i = 0;
+    for (; i + 16 <= numSamples; i += 16) {
+        _mm512_storeu_ps(buffer + i, _mm512_mul_ps(_mm512_loadu_ps(buffer + i), gain16));
+    }
+    applyGainTail(buffer, gain, i, numSamples);
+}
+
+SIMD_TARGET_AVX512
+void applyGainRampAVX512(float* buffer, int numSamples, float start, float slope) noexcept {
+    const __m512 start16 = _mm512_set1_ps(start);
+    const __m512 slope16 = _mm512_set1_ps(slope);
+    const __m512i lane = _mm512_setr_epi32(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+    int i = 0;
+    for (; i + 16 <= numSamples; i += 16) {
+        const __m512 t = _mm512_cvtepi32_ps(_mm512_add_epi32(_mm512_set1_epi32(i), lane));
+        const __m512 gain = _mm512_add_ps(start16, _mm512_mul_ps(slope16, t));
+        _mm512_storeu_ps(buffer + i, _mm512_mul_ps(_mm512_loadu_ps(buffer + i), gain));
+    }
+    applyGainRampTail(buffer, start, slope, i, numSamples);
+}
+
+SIMD_TARGET_AVX512
+float peakAbsAVX512(const float* left, const float* right, int numSamples) noexcept {
+    __m512 peak16 = _mm512_setzero_ps();
+    int i = 0;
+    for (; i + 16 <= numSamples; i += 16) {
+        peak16 = _mm512_max_ps(peak16, _mm512_abs_ps(_mm512_loadu_ps(left + i)));
+        peak16 = _mm512_max_ps(peak16, _mm512_abs_ps(_mm512_loadu_ps(right + i)));
+    }
+    alignas(64) float lanes[16];
+    _mm512_store_ps(lanes, peak16);
+    float peak = lanes[0];
+    for (int lane = 1; lane < 16; ++lane) peak = std::max(peak, lanes[lane]);
+    return peakAbsTail(left, right, peak, i, numSamples);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+constexpr SimdDispatch::Kernels AVX512_KERNELS = {
+    SimdDispatch::Level::AVX512, "AVX-512",
+    mixStereoAVX512, mixStereoRampAVX512, interleaveStereoAVX512, applyGainAVX512, applyGainRampAVX512, peakAbsAVX512
+};
+
+// ============================================================================
+// CPU detekce (CPUID + XGETBV: instrukce i uložení registrů OS)
+// ============================================================================
+
+void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) noexcept {
+#if defined(SIMD_DISPATCH_MSVC_CPUID)
+    int values[4];
+    __cpuidex(values, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i) regs[i] = static_cast<uint32_t>(values[i]);
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+uint64_t readXcr0() noexcept {
+#if defined(SIMD_DISPATCH_MSVC_CPUID)
+    return _xgetbv(0);
+#else
+    uint32_t low, high;
+    __asm__ __volatile__("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+    return (static_cast<uint64_t>(high) << 32) | low;
+#endif
+}
+
+SimdDispatch::Level detectWideLevel() noexcept {
+    uint32_t regs[4];
+    cpuid(0, 0, regs);
+    const uint32_t maxLeaf = regs[0];
+    if (maxLeaf < 7) return SimdDispatch::Level::SSE2;
+
+    cpuid(1, 0, regs);
+    const bool osxsave = (regs[2] & (1u << 27)) != 0;
+    const bool avx = (regs[2] & (1u << 28)) != 0;
+    if (!osxsave || !avx) return SimdDispatch::Level::SSE2;
+
+    // XCR0: SSE (1) + AVX (2) stav; AVX-512 navíc opmask (5), ZMM0-15 high (6), ZMM16-31 (7)
+    const uint64_t xcr0 = readXcr0();
+    if ((xcr0 & 0x06) != 0x06) return SimdDispatch::Level::SSE2;
+
+    cpuid(7, 0, regs);
+    const bool avx2 = (regs[1] & (1u << 5)) != 0;
+    const bool avx512f = (regs[1] & (1u << 16)) != 0;
+
+    if (avx512f && avx2 && (xcr0 & 0xE6) == 0xE6) return SimdDispatch::Level::AVX512;
+    if (avx2) return SimdDispatch::Level::AVX2;
+    return SimdDispatch::Level::SSE2;
+}
+#endif
+
+#if defined(SIMD_DISPATCH_NEON)
+// ============================================================================
+// NEON (ARM)
+// ============================================================================
+
+void mixStereoNEON(float* outLeft, float* outRight, const float* stereoSource,
+                   const float* envelopeGains, float leftGain, float rightGain,
+                   int numSamples) noexcept {
+    const float32x4_t leftGain4 = vdupq_n_f32(leftGain);
+    const float32x4_t rightGain4 = vdupq_n_f32(rightGain);
+    int i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        const float32x4x2_t lr = vld2q_f32(stereoSource + 2 * i);   // deinterleave L / R
+        const float32x4_t gain = vld1q_f32(envelopeGains + i);
+        // Oddělené násobení a sčítání (ne vmla/vfma) - shodné zaokrouhlení se skalární cestou
+        vst1q_f32(outLeft + i, vaddq_f32(vld1q_f32(outLeft + i),
+                                         vmulq_f32(vmulq_f32(lr.val[0], gain), leftGain4)));
+        vst1q_f32(outRight + i, vaddq_f32(vld1q_f32(outRight + i),
+                                          vmulq_f32(vmulq_f32(lr.val[1], gain), rightGain4)));
+    }
+    mixStereoTail(outLeft, outRight, stereoSource, envelopeGains, leftGain, rightGain, i, numSamples);
+}
+
+void mixStereoRampNEON(float* outLeft, float* outRight, const float* stereoSource,
+                       const float* envelopeGains, float leftGain, float rightGain,
+                       float leftStep, float rightStep, int numSamples) noexcept {
+    const float32x4_t leftGain4 = vdupq_n_f32(leftGain);
+    const float32x4_t rightGain4 = vdupq_n_f32(rightGain);
+    const float32x4_t leftStep4 = vdupq_n_f32(leftStep);
+    const float32x4_t rightStep4 = vdupq_n_f32(rightStep);
+    const int32_t laneValues[4] = {1, 2, 3, 4};
+    const int32x4_t lane = vld1q_s32(laneValues);
+    int i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        const float32x4x2_t lr = vld2q_f32(stereoSource + 2 * i);
+        const float32x4_t gain = vld1q_f32(envelopeGains + i);
+        const float32x4_t t = vcvtq_f32_s32(vaddq_s32(vdupq_n_s32(i), lane));
+        const float32x4_t left = vaddq_f32(leftGain4, vmulq_f32(leftStep4, t));
+        const float32x4_t right = vaddq_f32(rightGain4, vmulq_f32(rightStep4, t));
+        vst1q_f32(outLeft + i, vaddq_f32(vld1q_f32(outLeft + i),
+                                         vmulq_f32(vmulq_f32(lr.val[0], gain), left)));
+        vst1q_f32(outRight + i, vaddq_f32(vld1q_f32(outRight + i),
+                                          vmulq_f32(vmulq_f32(lr.val[1], gain), right)));
+    }
+    mixStereoRampTail(outLeft, outRight, stereoSource, envelopeGains, leftGain, rightGain,
+                      leftStep, rightStep, i, numSamples);
+}
+
+void interleaveStereoNEON(const float* left, const float* right, float* interleaved,
+                          int numSamples) noexcept {
+    int i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        float32x4x2_t lr;
+        lr.val[0] = vld1q_f32(left + i);
+        lr.val[1] = vld1q_f32(right + i);
+        vst2q_f32(interleaved + 2 * i, lr);
+    }
+    interleaveStereoTail(left, right, interleaved, i, numSamples);
+}
+
+void applyGainNEON(float* buffer, int numSamples, float gain) noexcept {
+    const float32x4_t gain4 = vdupq_n_f32(gain);
+    int i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        vst1q_f32(buffer + i, vmulq_f32(vld1q_f32(buffer + i), gain4));
+    }
+    applyGainTail(buffer, gain, i, numSamples);
+}
+
+void applyGainRampNEON(float* buffer, int numSamples, float start, float slope) noexcept {
+    const float32x4_t start4 = vdupq_n_f32(start);
+    const float32x4_t slope4 = vdupq_n_f32(slope);
+    const int32_t laneValues[4] = {1, 2, 3, 4};
+    const int32x4_t lane = vld1q_s32(laneValues);
+    int i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        const float32x4_t t = vcvtq_f32_s32(vaddq_s32(vdupq_n_s32(i), lane));
+        const float32x4_t gain = vaddq_f32(start4, vmulq_f32(slope4, t));
+        vst1q_f32(buffer + i, vmulq_f32(vld1q_f32(buffer + i), gain));
+    }
+    applyGainRampTail(buffer, start, slope, i, numSamples);
+}
+
+float peakAbsNEON(const float* left, const float* right, int numSamples) noexcept {
+    float32x4_t peak4 = vdupq_n_f32(0.0f);
+    int i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        peak4 = vmaxq_f32(peak4, vabsq_f32(vld1q_f32(left + i)));
+        peak4 = vmaxq_f32(peak4, vabsq_f32(vld1q_f32(right + i)));
+    }
+    float lanes[4];
+    vst1q_f32(lanes, peak4);
+    const float peak = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+    return peakAbsTail(left, right, peak, i, numSamples);
+}
+
+constexpr SimdDispatch::Kernels NEON_KERNELS = {
+    SimdDispatch::Level::NEON, "NEON",
+    mixStereoNEON, mixStereoRampNEON, interleaveStereoNEON, applyGainNEON, applyGainRampNEON, peakAbsNEON
+};
+#endif
+
+/**
+ * @brief Tabulka pro úroveň, nullptr pokud ji build nepřeložil
+ */
+const SimdDispatch::Kernels* kernelsFor(SimdDispatch::Level level) noexcept {
+    switch (level) {
+        case SimdDispatch::Level::Scalar:
+            return &SCALAR_KERNELS;
+#if defined(SIMD_DISPATCH_SSE2)
+        case SimdDispatch::Level::SSE2:
+            return &SSE2_KERNELS;
+#endif
+#if defined(SIMD_DISPATCH_WIDE)
+        case SimdDispatch::Level::AVX2:
+            return &AVX2_KERNELS;
+        case SimdDispatch::Level::AVX512:
+            return &AVX512_KERNELS;
+#endif
+#if defined(SIMD_DISPATCH_NEON)
+        case SimdDispatch::Level::NEON:
+            return &NEON_KERNELS;
+#endif
+        default:
+            return nullptr;
+    }
+}
+
+/**
+ * @brief Aktivní tabulka - inicializace při prvním použití (magic static)
+ */
+std::atomic<const SimdDispatch::Kernels*>& activeKernels() noexcept {
+    static std::atomic<const SimdDispatch::Kernels*> active{
+        kernelsFor(SimdDispatch::getSupportedLevel())
+    };
+    return active;
+}
+
+/**
+ * @brief Pořadí úrovní pro porovnání s podporovanou (NEON stojí mimo x86 řadu)
+ */
+int levelRank(SimdDispatch::Level level) noexcept {
+    switch (level) {
+        case SimdDispatch::Level::Scalar: return 0;
+        case SimdDispatch::Level::SSE2:   return 1;
+        case SimdDispatch::Level::NEON:   return 1;
+        case SimdDispatch::Level::AVX2:   return 2;
+        case SimdDispatch::Level::AVX512: return 3;
+    }
+    return 0;
+}
+
+} // namespace
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+const SimdDispatch::Kernels& SimdDispatch::kernels() noexcept
+{
+    return *activeKernels().load(std::memory_order_acquire);
+}
+
+SimdDispatch::Level SimdDispatch::getSupportedLevel() noexcept
+{
+    // CPU se za běhu nemění - detekce jednou
+    static const Level supported = [] {
+#if defined(SIMD_DISPATCH_WIDE)
+        return detectWideLevel();
+#elif defined(SIMD_DISPATCH_SSE2)
+        return Level::SSE2;
+#elif defined(SIMD_DISPATCH_NEON)
+        return Level::NEON;
+#else
+        return Level::Scalar;
+#endif
+    }();
+    return supported;
+}
+
+bool SimdDispatch::selectLevel(Level level) noexcept
+{
+    const Kernels* table = kernelsFor(level);
+    if (!table || levelRank(level) > levelRank(getSupportedLevel())) {
+        return false;
+    }
+    activeKernels().store(table, std::memory_order_release);
+    return true;
+}
+
+const char* SimdDispatch::getLevelName(Level level) noexcept
+{
+    switch (level) {
+        case Level::Scalar: return "Scalar";
+        case Level::SSE2:   return "SSE2";
+        case Level::AVX2:   return "AVX2";
+        case Level::AVX512: return "AVX-512";
+        case Level::NEON:   return "NEON";
+    }
+    return "Unknown";
+}
@@ -0,0 +1,115 @@
+#ifndef SIMD_DISPATCH_H
+#define SIMD_DISPATCH_H
+
+#include "IthacaConfig.h"
+
+// ===== SIMD DISPATCH CONFIGURATION =====
+// Fallback pro nadřazený IthacaConfig.h bez této volby.
+// 0 = jen baseline kernely (SSE2 / NEON / skalár), AVX2 a AVX-512 se nepřekládají.
+#ifndef ITHACA_ENABLE_WIDE_SIMD
+#define ITHACA_ENABLE_WIDE_SIMD 1
+#endif
+
+/**
+ * @class SimdDispatch
+ * @brief Výběr SIMD implementací hot kernelů podle CPU za běhu
+ *
+ * Build používá jen baseline ISA (x86-64 = SSE2, bez -march), takže širší
+ * instrukce nelze zapnout globálně. Kernely AVX2 a AVX-512 jsou přeložené
+ * s function-level target atributem a tabulka ukazatelů se vybere jednou
+ * při prvním použití podle CPUID/XGETBV - jedna binárka běží optimálně
+ * na každém stroji.
+ *
+ * Úrovně:
+ * - x86/x64: SSE2 (baseline) → AVX2 → AVX-512F (pokud je podporuje CPU i OS)
+ * - ARM: NEON (v době překladu)
+ * - jinde: skalární kernely
+ *
+ * Všechny úrovně počítají každý sample stejnou sekvencí operací (bez FMA),
+ * výstup je proto bitově shodný bez ohledu na vybranou úroveň.
+ *
+ * THREAD SAFETY:
+ * - kernels() - RT-safe, lock-free, libovolný thread
+ * - selectLevel() - NE RT-safe, volat před startem audia (testy, benchmarky)
+ */
+class SimdDispatch {
+public:
+    enum class Level {
+        Scalar,
+        SSE2,
+        AVX2,
+        AVX512,
+        NEON
+    };
+
+    /**
+     * @brief Tabulka kernelů jedné úrovně
+     */
+    struct Kernels {
+        Level level;
+        const char* name;
+
+        /**
+         * @brief outL[i] += src[2i] · env[i] · gainL, outR[i] += src[2i+1] · env[i] · gainR
+         * @note Voice mix: interleaved stereo sample × obálka × blokové gainy
+         */
+        void (*mixStereo)(float* outLeft, float* outRight, const float* stereoSource,
+                          const float* envelopeGains, float leftGain, float rightGain,
+                          int numSamples) noexcept;
+
+        /**
+         * @brief Jako mixStereo, kanálový gain je lineární rampa gain + step · (i + 1)
+         * @note Vyhlazení parametrů hlasu po vzorcích (master gain, pan, stereo field)
+         */
+        void (*mixStereoRamp)(float* outLeft, float* outRight, const float* stereoSource,
+                              const float* envelopeGains, float leftGain, float rightGain,
+                              float leftStep, float rightStep, int numSamples) noexcept;
+
+        /**
+         * @brief out = [L0, R0, L1, R1, ...] (výstup bloku, konverze loaderu)
+         */
+        void (*interleaveStereo)(const float* left, const float* right, float* interleaved,
+                                 int numSamples) noexcept;
+
+        /**
+         * @brief buffer[i] *= gain
+         */
+        void (*applyGain)(float* buffer, int numSamples, float gain) noexcept;
+
+        /**
+         * @brief buffer[i] *= start + slope · (i + 1) (lineární rampa gainu)
+         */
+        void (*applyGainRamp)(float* buffer, int numSamples, float start, float slope) noexcept;
+
+        /**
+         * @brief Stereo peak: max(|L|, |R|) přes všechny samply (0 pro prázdný blok)
+         */
+        float (*peakAbs)(const float* left, const float* right, int numSamples) noexcept;
+    };
+
+    /**
+     * @brief Aktivní tabulka kernelů
+     * @note RT-safe (po prvním volání jen atomické čtení ukazatele)
+     */
+    static const Kernels& kernels() noexcept;
+
+    /**
+     * @brief Nejvyšší úroveň podporovaná tímto CPU a buildem
+     */
+    static Level getSupportedLevel() noexcept;
+
+    /**
+     * @brief Vynutí úroveň kernelů (např. porovnání výstupu / výkonu v testech)
+     * @param level Požadovaná úroveň
+     * @return false pokud ji CPU nebo build nepodporuje (aktivní tabulka beze změny)
+     * @note NENÍ určeno pro běh audia - volat před startem nebo po zastavení
+     */
+    static bool selectLevel(Level level) noexcept;
+
+    /**
+     * @brief Název úrovně pro log ("Scalar", "SSE2", "AVX2", "AVX-512", "NEON")
+     */
+    static const char* getLevelName(Level level) noexcept;
+};
+
+#endif // SIMD_DISPATCH_H
@@ -0,0 +1,55 @@
+#ifndef THREAD_WAIT_H
+#define THREAD_WAIT_H
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <climits>
+#elif defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+// ===== FUTEX HELPERS =====
+// Čekání worker vláken na 32-bit atomické slovo bez zámků (VoiceRenderPool,
+// ConvolutionEffect). Na Windows vyžaduje knihovnu synchronization.
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "futex wait requires lock-free 32-bit atomic layout");
+
+/**
+ * @brief Uspí vlákno, dokud word == expected (kernel futex / WaitOnAddress)
+ */
+inline void waitWhileEqual(std::atomic<uint32_t>& word, uint32_t expected) noexcept {
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE,
+            expected, nullptr, nullptr, 0);
+#elif defined(_WIN32)
+    WaitOnAddress(&word, &expected, sizeof(expected), INFINITE);
+#else
+    if (word.load(std::memory_order_acquire) == expected) std::this_thread::yield();
+#endif
+}
+
+/**
+ * @brief Probudí všechna vlákna čekající ve waitWhileEqual() na word
+ */
+inline void wakeAll(std::atomic<uint32_t>& word) noexcept {
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE,
+            INT32_MAX, nullptr, nullptr, 0);
+#elif defined(_WIN32)
+    WakeByAddressAll(&word);
+#else
+    (void)word;
+#endif
+}
+
+#endif // THREAD_WAIT_H
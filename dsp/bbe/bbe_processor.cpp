@@ -4,7 +4,7 @@
  * 
  * This file implements the core BBE audio enhancement algorithm including:
  * - Filter initialization and coefficient updates
- * - 3-band crossover processing
+ * - 3-band crossover processing (L/R as SIMD lanes)
  * - Phase compensation
  * - Dynamic harmonic enhancement
  * - Bass boost
@@ -16,141 +16,122 @@
  */
 
 #include "bbe_processor.h"
-#include <cstring>  // for memcpy if needed
-#include <vector>   // for thread_local buffers
+#include <algorithm>
 
 // ═════════════════════════════════════════════════════════════════════
 // DspEffect Interface Implementation
 // ═════════════════════════════════════════════════════════════════════
 
+namespace {
+
+// Same design in the left and right lane of a stage (stage checked at compile time)
+template <int STAGE, int STAGES>
+void setStereoLanes(BiquadLaneCascade<STAGES>& cascade, int firstLane,
+                    const BiquadFilter& design) noexcept {
+    cascade.template setLane<STAGE>(firstLane, design);
+    cascade.template setLane<STAGE>(firstLane + 1, design);
+}
+
+} // namespace
+
 void BBEProcessor::prepare(int sampleRate, int maxBlockSize) {
-    (void)maxBlockSize;  // Unused - BBE uses thread_local buffers
+    (void)maxBlockSize;  // Unused - BBE works in CHUNK_SIZE chunks
     sampleRate_ = sampleRate;
     
-    // Initialize all filters for both channels (stereo)
-    for (int ch = 0; ch < 2; ++ch) {
-        // ─────────────────────────────────────────────────────────────
-        // BASS BAND: Linkwitz-Riley 4th Order Lowpass
-        // ─────────────────────────────────────────────────────────────
-        // Two cascaded 2nd order Butterworth filters @ 150 Hz
-        // Q = 0.707 (1/sqrt(2)) for Butterworth alignment
-        // Result: -24 dB/octave rolloff, phase-coherent reconstruction
-        
-        crossover_[ch].lpBass1.setCoefficients(
-            BiquadFilter::Type::LOWPASS,   // Filter type
-            sampleRate,                     // Sample rate
-            BASS_CUTOFF,                    // 150 Hz
-            0.707                           // Q factor (Butterworth)
-        );
-        
-        crossover_[ch].lpBass2.setCoefficients(
-            BiquadFilter::Type::LOWPASS,
-            sampleRate,
-            BASS_CUTOFF,
-            0.707
-        );
-        
-        // ─────────────────────────────────────────────────────────────
-        // MID BAND: Linkwitz-Riley 4th Order Bandpass
-        // ─────────────────────────────────────────────────────────────
-        // Implemented as: Highpass(150 Hz) × Lowpass(2400 Hz)
-        // Each is LR4 (two cascaded Butterworth sections)
-        // Result: Band-limited signal 150-2400 Hz
-        
-        // Highpass section (removes bass below 150 Hz)
-        crossover_[ch].hpMid1.setCoefficients(
-            BiquadFilter::Type::HIGHPASS,
-            sampleRate,
-            BASS_CUTOFF,                    // 150 Hz
-            0.707
-        );
-        
-        crossover_[ch].hpMid2.setCoefficients(
-            BiquadFilter::Type::HIGHPASS,
-            sampleRate,
-            BASS_CUTOFF,
-            0.707
-        );
-        
-        // Lowpass section (removes treble above 2400 Hz)
-        crossover_[ch].lpMid1.setCoefficients(
-            BiquadFilter::Type::LOWPASS,
-            sampleRate,
-            TREBLE_CUTOFF,                  // 2400 Hz
-            0.707
-        );
-        
-        crossover_[ch].lpMid2.setCoefficients(
-            BiquadFilter::Type::LOWPASS,
-            sampleRate,
-            TREBLE_CUTOFF,
-            0.707
-        );
-        
-        // ─────────────────────────────────────────────────────────────
-        // TREBLE BAND: Linkwitz-Riley 4th Order Highpass
-        // ─────────────────────────────────────────────────────────────
-        // Two cascaded 2nd order Butterworth filters @ 2400 Hz
-        // Result: Passes frequencies above 2400 Hz with -24 dB/octave
-        
-        crossover_[ch].hpTreble1.setCoefficients(
-            BiquadFilter::Type::HIGHPASS,
-            sampleRate,
-            TREBLE_CUTOFF,                  // 2400 Hz
-            0.707
-        );
-        
-        crossover_[ch].hpTreble2.setCoefficients(
-            BiquadFilter::Type::HIGHPASS,
-            sampleRate,
-            TREBLE_CUTOFF,
-            0.707
-        );
-        
-        // ─────────────────────────────────────────────────────────────
-        // PHASE SHIFTERS: All-pass Filters
-        // ─────────────────────────────────────────────────────────────
-        // These filters pass all frequencies unchanged in amplitude
-        // but rotate the phase to compensate for speaker distortion
-        
-        // Mid band: -180° phase shift at 1200 Hz (geometric mean of 150-2400)
-        // This inverts the mid band relative to bass
-        phaseShifters_[ch].midPhase.setCoefficients(
-            BiquadFilter::Type::ALLPASS_180,
-            sampleRate,
-            MID_CENTER                       // 1200 Hz
-        );
-        
-        // Treble band: -360° phase shift at 7200 Hz (geometric mean of 2400-20k)
-        // This creates full cycle rotation relative to bass
-        phaseShifters_[ch].treblePhase.setCoefficients(
-            BiquadFilter::Type::ALLPASS_360,
-            sampleRate,
-            TREBLE_CENTER                    // 7200 Hz
-        );
-        
-        // ─────────────────────────────────────────────────────────────
-        // BASS BOOST: Low Shelf Filter
-        // ─────────────────────────────────────────────────────────────
-        // Initially set to 0 dB (no boost)
-        // Will be updated when bassBoostLevel_ changes
+    // Filters are designed once by BiquadFilter and copied into lanes
+    // (L and R share coefficients, only their state differs)
+    
+    // ─────────────────────────────────────────────────────────────────
+    // CROSSOVER: Linkwitz-Riley 4th Order (two cascaded Butterworth)
+    // ─────────────────────────────────────────────────────────────────
+    // Q = 0.707 (1/sqrt(2)) for Butterworth alignment
+    // Result: -24 dB/octave rolloff, phase-coherent reconstruction
+    //
+    // Bass:   LP(150 Hz) × 2
+    // Mid:    HP(150 Hz) × 2 → LP(2400 Hz) × 2
+    // Treble: HP(2400 Hz) × 2
+    
+    BiquadFilter lowpassBass;
+    lowpassBass.setCoefficients(BiquadFilter::Type::LOWPASS, sampleRate, BASS_CUTOFF, 0.707);
+    
+    BiquadFilter highpassBass;
+    highpassBass.setCoefficients(BiquadFilter::Type::HIGHPASS, sampleRate, BASS_CUTOFF, 0.707);
+    
+    BiquadFilter lowpassTreble;
+    lowpassTreble.setCoefficients(BiquadFilter::Type::LOWPASS, sampleRate, TREBLE_CUTOFF, 0.707);
+    
+    BiquadFilter highpassTreble;
+    highpassTreble.setCoefficients(BiquadFilter::Type::HIGHPASS, sampleRate, TREBLE_CUTOFF, 0.707);
+    
+    // ─────────────────────────────────────────────────────────────────
+    // PHASE SHIFTERS: All-pass Filters
+    // ─────────────────────────────────────────────────────────────────
+    // Mid band: -180° at 1200 Hz (geometric mean of 150-2400)
+    // Treble band: -360° at 7200 Hz (geometric mean of 2400-20k)
+    
+    BiquadFilter midPhase;
+    midPhase.setCoefficients(BiquadFilter::Type::ALLPASS_180, sampleRate, MID_CENTER);
+    
+    BiquadFilter treblePhase;
+    treblePhase.setCoefficients(BiquadFilter::Type::ALLPASS_360, sampleRate, TREBLE_CENTER);
+    
+    // ─────────────────────────────────────────────────────────────────
+    // LANE ASSIGNMENT
+    // ─────────────────────────────────────────────────────────────────
+    // bassTreble_: stage 0-1 = LR4 (bass LP | treble HP)
+    //              stage 2   = bass boost (0 dB shelf at boost 0) | treble all-pass
+    // mid_:        stage 0-1 = HP 150, stage 2-3 = LP 2400, stage 4 = all-pass
+    //              (lanes 2-3 unused, stay identity)
+    
+    setStereoLanes<0>(bassTreble_, 0, lowpassBass);
+    setStereoLanes<1>(bassTreble_, 0, lowpassBass);
+    setStereoLanes<0>(bassTreble_, 2, highpassTreble);
+    setStereoLanes<1>(bassTreble_, 2, highpassTreble);
+    setStereoLanes<2>(bassTreble_, 2, treblePhase);
+    
+    setStereoLanes<0>(mid_, 0, highpassBass);
+    setStereoLanes<1>(mid_, 0, highpassBass);
+    setStereoLanes<2>(mid_, 0, lowpassTreble);
+    setStereoLanes<3>(mid_, 0, lowpassTreble);
+    setStereoLanes<4>(mid_, 0, midPhase);
+    
+    // ─────────────────────────────────────────────────────────────────
+    // BASS BOOST: Low Shelf Coefficient Table
+    // ─────────────────────────────────────────────────────────────────
+    // 0-12 dB designed once here (pow/sin/cos), the audio thread only
+    // interpolates between entries. Initially 0 dB (no boost).
+    // The shelf stays in the bass lanes at every boost level: swapping it
+    // for identity would leave its s1/s2 state behind (click on the swap)
+    
+    for (int step = 0; step <= BASS_BOOST_TABLE_STEPS; ++step) {
+        const double gainDB = BASS_BOOST_MAX_DB * step / BASS_BOOST_TABLE_STEPS;
         
-        bassBoost_[ch].setCoefficients(
+        BiquadFilter shelf;
+        shelf.setCoefficients(
             BiquadFilter::Type::LOW_SHELF,
             sampleRate,
             BASS_CUTOFF,                     // 150 Hz transition
             0.707,                           // Q factor
-            0.0                              // 0 dB gain initially
+            gainDB                           // Gain in dB
         );
         
-        // ─────────────────────────────────────────────────────────────
-        // HARMONIC ENHANCER: Dynamic Treble VCA
-        // ─────────────────────────────────────────────────────────────
-        // Prepares envelope follower and gain smoother
-        
+        ShelfCoefficients& entry = bassBoostTable_[step];
+        shelf.getCoefficients(entry.b0, entry.b1, entry.b2, entry.a1, entry.a2);
+    }
+    bassBoost_ = bassBoostTable_[0];
+    loadBassBoostLanes();
+    
+    // ─────────────────────────────────────────────────────────────────
+    // HARMONIC ENHANCER: Dynamic Treble VCA
+    // ─────────────────────────────────────────────────────────────────
+    // Prepares envelope follower and gain smoother
+    
+    for (int ch = 0; ch < 2; ++ch) {
         enhancer_[ch].prepare(sampleRate);
     }
     
+    reset();
+    
     // Force coefficient update on first processBlock() call
     lastDefinition_ = -1.0f;
     lastBassBoost_ = -1.0f;
@@ -182,18 +163,6 @@ void BBEProcessor::process(float* leftBuffer, float* rightBuffer, int numSamples
         ? (1.0f / (SMOOTHING_TIME_SEC * static_cast<float>(sampleRate_)))
         : 0.0f;
 
-    // Allocate dry signal buffers (thread_local, pre-allocated)
-    static thread_local std::vector<float> dryLeft(16384);
-    static thread_local std::vector<float> dryRight(16384);
-
-    if (dryLeft.size() < static_cast<size_t>(numSamples)) {
-        return;  // Safety check
-    }
-
-    // Save dry (original) signal for wet/dry mixing
-    std::copy(leftBuffer, leftBuffer + numSamples, dryLeft.begin());
-    std::copy(rightBuffer, rightBuffer + numSamples, dryRight.begin());
-
     // ═════════════════════════════════════════════════════════════════
     // STEP 3: CHUNKED PROCESSING WITH PER-CHUNK SMOOTHING
     // ═════════════════════════════════════════════════════════════════
@@ -253,159 +222,131 @@ void BBEProcessor::process(float* leftBuffer, float* rightBuffer, int numSamples
         updateCoefficients();
 
         // ─────────────────────────────────────────────────────────────
-        // PROCESS THIS CHUNK (WET SIGNAL)
+        // PROCESS THIS CHUNK (WET SIGNAL + WET/DRY MIX)
         // ─────────────────────────────────────────────────────────────
-        processChannel(leftBuffer + processedSamples, chunkSize, 0);
-        processChannel(rightBuffer + processedSamples, chunkSize, 1);
-
-        // ─────────────────────────────────────────────────────────────
-        // WET/DRY MIX FOR THIS CHUNK
-        // ─────────────────────────────────────────────────────────────
-        const float dry = 1.0f - wetAmount_;
-        const float wet = wetAmount_;
-
-        for (int i = processedSamples; i < chunkEnd; ++i) {
-            leftBuffer[i] = dryLeft[i] * dry + leftBuffer[i] * wet;
-            rightBuffer[i] = dryRight[i] * dry + rightBuffer[i] * wet;
-        }
+        processChunk(leftBuffer + processedSamples, rightBuffer + processedSamples,
+                     chunkSize, 1.0f - wetAmount_, wetAmount_);
 
         processedSamples += chunkSize;
     }
 }
 
 // ═════════════════════════════════════════════════════════════════════
-// AUDIO PROCESSING - PER CHANNEL
+// TAIL / SILENCE TRACKING
 // ═════════════════════════════════════════════════════════════════════
 
-void BBEProcessor::processChannel(float* buffer, int samples, int channelIndex) noexcept {
-    // ─────────────────────────────────────────────────────────────────
-    // THREAD_LOCAL BAND BUFFERS
-    // ─────────────────────────────────────────────────────────────────
-    // Pre-allocated per-thread buffers for band splitting
-    // Allocated once per thread, reused across all processBlock() calls
-    // 
-    // Memory: 3 × 16384 samples × 4 bytes = 192 KB per audio thread
-    // Performance: No RT allocations, cache-friendly access
-    
-    static thread_local std::vector<float> bassBand(16384);
-    static thread_local std::vector<float> midBand(16384);
-    static thread_local std::vector<float> trebleBand(16384);
-    
-    // Safety check: Ensure buffers are large enough
-    // In production, samplesPerBlock should be ≤ 16384
-    if (bassBand.size() < static_cast<size_t>(samples)) {
-        return;  // Skip processing if buffer too small (shouldn't happen)
+bool BBEProcessor::isTailSilent() const noexcept {
+    // Parameter smoothing must be settled, otherwise process() still moves state
+    const float definitionTarget = definitionLevel_.load(std::memory_order_relaxed);
+    const float bassBoostTarget = bassBoostLevel_.load(std::memory_order_relaxed);
+    const float targetWet = std::min(1.0f, std::max(definitionTarget, bassBoostTarget) / WET_MIX_FADE_RANGE);
+
+    if (definitionSmoothed_ != definitionTarget || bassBoostSmoothed_ != bassBoostTarget ||
+        wetAmount_ != targetWet) {
+        return false;
+    }
+
+    // Settled below bypass threshold: signal stays dry, no filter runs
+    if (wetAmount_ < BYPASS_THRESHOLD) {
+        return true;
+    }
+
+    if (!bassTreble_.isSilent() || !mid_.isSilent() ||
+        !enhancer_[0].isSettled() || !enhancer_[1].isSettled()) {
+        return false;
     }
+
+    return true;
+}
+
+// ═════════════════════════════════════════════════════════════════════
+// AUDIO PROCESSING - STEREO CHUNK (SINGLE PASS)
+// ═════════════════════════════════════════════════════════════════════
+
+void BBEProcessor::processChunk(float* left, float* right, int samples,
+                                float dry, float wet) noexcept {
+    // Dry mix is needed only while the wet/dry fade is in progress
+    const bool mixDry = (wet != 1.0f);
     
-    // Get references to filter banks for this channel
-    CrossoverFilters& xover = crossover_[channelIndex];
-    PhaseShifters& phase = phaseShifters_[channelIndex];
+    constexpr int LANES = BiquadLaneCascade<BASS_TREBLE_STAGES>::LANES;
+    alignas(16) float bassTreble[CHUNK_SIZE * LANES];
+    alignas(16) float mid[CHUNK_SIZE * LANES];
     
     // ─────────────────────────────────────────────────────────────────
-    // PHASE 1: BAND SPLITTING (3-way Crossover)
+    // PHASE 1: BAND SPLITTING + PHASE SHIFT + BASS BOOST
     // ─────────────────────────────────────────────────────────────────
-    // Split input into three frequency bands using Linkwitz-Riley filters
-    // 
-    // Why Linkwitz-Riley?
-    // - Phase-coherent: When bands are summed, magnitude is flat
-    // - No peaks or dips at crossover points
-    // - Industry standard for speaker crossovers
+    // Linkwitz-Riley crossover (phase-coherent when summed), then
+    // all-pass phase compensation:
+    // Bass: 0° (reference) + optional low shelf
+    // Mid: -180° at 1200 Hz
+    // Treble: -360° at 7200 Hz
     
     for (int i = 0; i < samples; ++i) {
-        const float input = buffer[i];
-        
-        // BASS BAND: 20-150 Hz
-        // Two cascaded lowpass filters (LR4 = -24 dB/octave)
-        float bass = xover.lpBass1.processSample(input);
-        bass = xover.lpBass2.processSample(bass);
-        bassBand[i] = bass;
+        float* bt = bassTreble + i * LANES;
+        bt[0] = bt[2] = left[i];
+        bt[1] = bt[3] = right[i];
         
-        // MID BAND: 150-2400 Hz
-        // Highpass (150 Hz) then lowpass (2400 Hz) cascade
-        // Each is LR4, creating bandpass with steep skirts
-        float mid = xover.hpMid1.processSample(input);
-        mid = xover.hpMid2.processSample(mid);
-        mid = xover.lpMid1.processSample(mid);
-        mid = xover.lpMid2.processSample(mid);
-        midBand[i] = mid;
-        
-        // TREBLE BAND: 2400-20000 Hz
-        // Two cascaded highpass filters (LR4 = -24 dB/octave)
-        float treble = xover.hpTreble1.processSample(input);
-        treble = xover.hpTreble2.processSample(treble);
-        trebleBand[i] = treble;
+        float* m = mid + i * LANES;
+        m[0] = left[i];
+        m[1] = right[i];
+        m[2] = m[3] = 0.0f;
     }
     
-    // ─────────────────────────────────────────────────────────────────
-    // PHASE 2: PHASE COMPENSATION
-    // ─────────────────────────────────────────────────────────────────
-    // Apply all-pass filters to realign phase relationships
-    // 
-    // Why phase compensation?
-    // - Speakers and crossovers naturally introduce phase distortion
-    // - High frequencies arrive delayed relative to bass
-    // - Phase shift realigns the timing to restore original transients
-    // 
-    // Bass: No shift (0°) - used as phase reference
-    // Mid: -180° shift - inverts signal at center frequency
-    // Treble: -360° shift - full cycle rotation at center frequency
-    
-    // Mid band: Apply -180° phase shift at 1200 Hz
-    for (int i = 0; i < samples; ++i) {
-        midBand[i] = phase.midPhase.processSample(midBand[i]);
-    }
+    bassTreble_.processBlock(bassTreble, bassTreble, samples);
+    mid_.processBlock(mid, mid, samples);
     
-    // Treble band: Apply -360° phase shift at 7200 Hz
     for (int i = 0; i < samples; ++i) {
-        trebleBand[i] = phase.treblePhase.processSample(trebleBand[i]);
-    }
-    
-    // ─────────────────────────────────────────────────────────────────
-    // PHASE 3: HARMONIC ENHANCEMENT
-    // ─────────────────────────────────────────────────────────────────
-    // Dynamically enhance treble band using envelope-following VCA
-    // 
-    // Why dynamic enhancement?
-    // - Static boost makes everything too bright
-    // - Dynamic boost adds "air" to dull signals
-    // - Reduces on bright signals to prevent harshness
-    // - Maintains natural tonal balance
-    
-    enhancer_[channelIndex].processBlock(trebleBand.data(), samples);
-    
-    // ─────────────────────────────────────────────────────────────────
-    // PHASE 4: BASS BOOST (if enabled)
-    // ─────────────────────────────────────────────────────────────────
-    // Apply low-shelf EQ to maintain balance with enhanced treble
-    // 
-    // Why bass boost?
-    // - Enhanced treble can make bass sound thin
-    // - Shelf filter adds warmth without muddiness
-    // - Only applied if bassBoostLevel > 0
-    
-    const float bassBoost = bassBoostLevel_.load(std::memory_order_relaxed);
-    if (bassBoost > 0.01f) {  // Skip if negligible (saves CPU)
-        for (int i = 0; i < samples; ++i) {
-            bassBand[i] = bassBoost_[channelIndex].processSample(bassBand[i]);
+        const float* bt = bassTreble + i * LANES;
+        const float* m = mid + i * LANES;
+        
+        // ─────────────────────────────────────────────────────────────
+        // PHASE 2: HARMONIC ENHANCEMENT
+        // ─────────────────────────────────────────────────────────────
+        // Envelope-following VCA on treble (branchy, stays scalar)
+        
+        const float trebleL = enhancer_[0].processSample(bt[2]);
+        const float trebleR = enhancer_[1].processSample(bt[3]);
+        
+        // ─────────────────────────────────────────────────────────────
+        // PHASE 3: RECOMBINE BANDS + WET/DRY MIX
+        // ─────────────────────────────────────────────────────────────
+        
+        const float wetL = bt[0] + m[0] + trebleL;
+        const float wetR = bt[1] + m[1] + trebleR;
+        
+        if (mixDry) {
+            left[i] = left[i] * dry + wetL * wet;
+            right[i] = right[i] * dry + wetR * wet;
+        } else {
+            left[i] = wetL;
+            right[i] = wetR;
         }
     }
-    
-    // ─────────────────────────────────────────────────────────────────
-    // PHASE 5: RECOMBINE BANDS
-    // ─────────────────────────────────────────────────────────────────
-    // Sum all three bands back together
-    // 
-    // Due to Linkwitz-Riley crossover design:
-    // - Magnitude response is flat (no peaks/dips)
-    // - Phase is now corrected (better transients)
-    // - Treble is enhanced (more clarity)
-    // - Bass is optionally boosted (more warmth)
-    
-    for (int i = 0; i < samples; ++i) {
-        buffer[i] = bassBand[i] + midBand[i] + trebleBand[i];
+}
+
+void BBEProcessor::loadBassBoostLanes() noexcept {
+    for (int lane = 0; lane < 2; ++lane) {
+        bassTreble_.setLane(2, lane, bassBoost_.b0, bassBoost_.b1, bassBoost_.b2,
+                            bassBoost_.a1, bassBoost_.a2);
     }
+}
+
+BBEProcessor::ShelfCoefficients BBEProcessor::lookupBassBoost(float boost) const noexcept {
+    // Table position: 0.0 → entry 0 (0 dB), 1.0 → last entry (12 dB)
+    const float position = std::max(0.0f, std::min(1.0f, boost)) * BASS_BOOST_TABLE_STEPS;
+    const int index = std::min(static_cast<int>(position), BASS_BOOST_TABLE_STEPS - 1);
+    const float fraction = position - static_cast<float>(index);
+    
+    const ShelfCoefficients& lo = bassBoostTable_[index];
+    const ShelfCoefficients& hi = bassBoostTable_[index + 1];
     
-    // Processing complete - buffer now contains enhanced audio
+    ShelfCoefficients result;
+    result.b0 = lo.b0 + (hi.b0 - lo.b0) * fraction;
+    result.b1 = lo.b1 + (hi.b1 - lo.b1) * fraction;
+    result.b2 = lo.b2 + (hi.b2 - lo.b2) * fraction;
+    result.a1 = lo.a1 + (hi.a1 - lo.a1) * fraction;
+    result.a2 = lo.a2 + (hi.a2 - lo.a2) * fraction;
+    return result;
 }
 
 // ═════════════════════════════════════════════════════════════════════
@@ -433,25 +374,18 @@ void BBEProcessor::updateCoefficients() noexcept {
     // ─────────────────────────────────────────────────────────────────
     // UPDATE BASS BOOST LEVEL
     // ─────────────────────────────────────────────────────────────────
-    // Recalculate filter coefficients if gain changed
+    // Look up shelf coefficients if gain changed
 
     if (currentBassBoost != lastBassBoost_) {
-        // Convert 0.0-1.0 range to 0-12 dB gain
+        // 0.0-1.0 maps to 0-12 dB gain (table interpolation,
+        // no pow/sin/cos while the knob is being smoothed)
         // 0.0 → 0 dB (no boost)
         // 0.5 → 6 dB
         // 1.0 → 12 dB
-        const float gainDB = currentBassBoost * 12.0f;
-
-        // Update both channel bass boost filters
-        for (int ch = 0; ch < 2; ++ch) {
-            bassBoost_[ch].setCoefficients(
-                BiquadFilter::Type::LOW_SHELF,
-                sampleRate_,
-                BASS_CUTOFF,                 // 150 Hz
-                0.707,                       // Q factor
-                gainDB                       // Gain in dB
-            );
-        }
+        bassBoost_ = lookupBassBoost(currentBassBoost);
+        
+        // Both channel bass lanes (0 dB shelf at boost 0, state carries over)
+        loadBassBoostLanes();
         lastBassBoost_ = currentBassBoost;
     }
 }
@@ -461,26 +395,12 @@ void BBEProcessor::updateCoefficients() noexcept {
 // ═════════════════════════════════════════════════════════════════════
 
 void BBEProcessor::reset() noexcept {
-    // Reset both channel filter banks
+    // Filter network (all lanes of all stages)
+    bassTreble_.reset();
+    mid_.reset();
+    
+    // Harmonic enhancer (1 per channel)
     for (int ch = 0; ch < 2; ++ch) {
-        // Crossover filters (8 per channel)
-        crossover_[ch].lpBass1.reset();
-        crossover_[ch].lpBass2.reset();
-        crossover_[ch].hpMid1.reset();
-        crossover_[ch].hpMid2.reset();
-        crossover_[ch].lpMid1.reset();
-        crossover_[ch].lpMid2.reset();
-        crossover_[ch].hpTreble1.reset();
-        crossover_[ch].hpTreble2.reset();
-        
-        // Phase shifters (2 per channel)
-        phaseShifters_[ch].midPhase.reset();
-        phaseShifters_[ch].treblePhase.reset();
-        
-        // Bass boost (1 per channel)
-        bassBoost_[ch].reset();
-        
-        // Harmonic enhancer (1 per channel)
         enhancer_[ch].reset();
     }
-}
\ No newline at end of file
+}
@@ -60,6 +60,7 @@
 
 #include "../dsp_effect.h"
 #include "biquad_filter.h"
+#include "biquad_cascade.h"
 #include "harmonic_enhancer.h"
 #include <atomic>
 #include <cstdint>
@@ -86,7 +87,7 @@
  * - Memory: ~865 bytes per instance (stack)
  * - CPU: 5-10% per stereo stream @ 44.1 kHz
  * - Latency: < 1 sample (negligible)
- * - Thread_local buffers: 192 KB per audio thread
+ * - L/R processed as SIMD lanes of one filter network (SSE2/NEON)
  * 
  * Usage Example (Uninterleaved):
  * ══════════════════════════════
@@ -161,14 +162,14 @@ public:
      * This method:
      * 1. Configures crossover filters (Linkwitz-Riley 4th order)
      * 2. Sets up phase shifters (all-pass filters)
-     * 3. Initializes bass boost filter
+     * 3. Precomputes bass boost coefficient table (0-12 dB)
      * 4. Prepares harmonic enhancers
      *
      * Supported sample rates: 44100, 48000 Hz (others work but not tested)
      *
      * @param sampleRate Sample rate in Hz
-     * @param maxBlockSize Maximum block size (unused, BBE uses thread_local buffers)
-     * @note NOT RT-SAFE: Calculates filter coefficients (uses exp, sin, cos)
+     * @param maxBlockSize Maximum block size (unused, BBE works in CHUNK_SIZE chunks)
+     * @note NOT RT-SAFE: Calculates filter coefficients (uses exp, pow, sin, cos)
      * @note Call during initialization or sample rate change, not in audio callback
      */
     void prepare(int sampleRate, int maxBlockSize) override;
@@ -187,12 +188,12 @@ public:
      * ───────────────────
      * 1. Check bypass state (return immediately if bypassed)
      * 2. Update coefficients if parameters changed
-     * 3. For each channel:
+     * 3. Single pass per stereo frame (L/R as SIMD lanes):
      *    a. Split into 3 bands (bass, mid, treble)
      *    b. Apply phase shifts to mid (-180°) and treble (-360°)
-     *    c. Enhance treble dynamically
-     *    d. Boost bass if enabled
-     *    e. Recombine all bands
+     *    c. Boost bass if enabled
+     *    d. Enhance treble dynamically
+     *    e. Recombine all bands, wet/dry mix
      * 
      * Performance:
      * ───────────
@@ -202,20 +203,19 @@ public:
      * 
      * Memory Access Pattern:
      * ─────────────────────
-     * Uses thread_local buffers (allocated once per thread):
-     * - bassBand[16384]   - 64 KB
-     * - midBand[16384]    - 64 KB
-     * - trebleBand[16384] - 64 KB
-     * Total: 192 KB per audio thread (acceptable for modern systems)
+     * Per CHUNK_SIZE chunk: the input is spread into two small lane
+     * buffers on the stack, each filter cascade runs over the whole
+     * chunk with its state in registers, then one pass enhances,
+     * recombines and mixes. The dry signal is read back from the input
+     * only while the wet/dry fade is in progress. Any block length.
      * 
      * @param left Left channel buffer (modified in-place)
      * @param right Right channel buffer (modified in-place)
      * @param samples Number of samples to process
      * 
-     * @note RT-SAFE: No allocations, thread_local buffers pre-allocated
+     * @note RT-SAFE: No allocations
      * @note Buffers are modified IN-PLACE (input becomes output)
-     * @note Thread-safe: Can be called concurrently from multiple threads
-     * @note samples should be ≤ 16384 (buffer size limit)
+     * @note No block size limit
      * 
      * @warning If disabled, function returns immediately (zero overhead)
      */
@@ -260,6 +260,18 @@ public:
         return enabled_.load(std::memory_order_relaxed);
     }
 
+    /**
+     * @brief Check whether the BBE tail has decayed
+     *
+     * Silent when parameter smoothing has settled and either the wet
+     * path is bypassed, or all filters are at zero and both enhancers
+     * have settled.
+     *
+     * @return true if a silent block can be skipped
+     * @note RT-SAFE: Read-only, atomic parameter reads
+     */
+    bool isTailSilent() const noexcept override;
+
     /**
      * @brief Get effect name
      * @return "BBE Maximizer"
@@ -333,92 +345,98 @@ public:
 
 private:
     /**
-     * @brief Process single channel through BBE algorithm
+     * @brief Normalized biquad coefficients (a0 = 1) of one design
+     */
+    struct ShelfCoefficients {
+        float b0{1.0f}, b1{0.0f}, b2{0.0f}, a1{0.0f}, a2{0.0f};
+    };
+
+    /**
+     * @brief Process one stereo chunk through the BBE algorithm
      * 
-     * Internal method that implements the core BBE processing for one
-     * channel. Called twice by processBlock() (once for left, once for right).
+     * Band split, phase shift and bass boost for both channels as two
+     * SIMD lane cascades over the chunk, then treble enhancement,
+     * recombination and wet/dry mix. Called by process() per chunk.
      * 
-     * @param buffer Audio buffer (modified in-place)
-     * @param samples Number of samples
-     * @param channelIndex 0 = left, 1 = right (selects filter bank)
+     * @param left Left channel (modified in-place)
+     * @param right Right channel (modified in-place)
+     * @param samples Number of samples (≤ CHUNK_SIZE)
+     * @param dry Dry gain of this chunk
+     * @param wet Wet gain of this chunk (1.0 = no dry mix)
      */
-    void processChannel(float* buffer, int samples, int channelIndex) noexcept;
+    void processChunk(float* left, float* right, int samples, float dry, float wet) noexcept;
+
+    /**
+     * @brief Load bassBoost_ into the bass lanes (L/R) of stage 2
+     * @note RT-SAFE: lane coefficient copies only
+     */
+    void loadBassBoostLanes() noexcept;
+
+    /**
+     * @brief Interpolate shelf coefficients from bassBoostTable_
+     * @param boost Bass boost level 0.0 - 1.0 (0 - 12 dB)
+     * @note RT-SAFE: table lookup, no transcendental math
+     */
+    ShelfCoefficients lookupBassBoost(float boost) const noexcept;
 
     /**
      * @brief Update filter coefficients based on current parameters
      * 
      * Checks if parameters have changed since last update and recalculates
-     * filter coefficients if needed. Called at start of processBlock().
+     * filter coefficients if needed (bass boost via table lookup). Called per chunk.
      * 
      * @note RT-SAFE: Uses cached values to detect changes
      */
     void updateCoefficients() noexcept;
 
     // ═════════════════════════════════════════════════════════════════
-    // FILTER BANKS (Stereo = 2 channels)
+    // FILTER NETWORK (Stereo, SIMD lane cascades - see BiquadLaneCascade)
     // ═════════════════════════════════════════════════════════════════
 
     /**
-     * @struct CrossoverFilters
-     * @brief 3-way crossover filter bank (Linkwitz-Riley 4th order)
-     * 
-     * Linkwitz-Riley Topology:
-     * ───────────────────────
-     * - 4th order = cascade of two 2nd order Butterworth
-     * - Phase-coherent reconstruction (flat magnitude when summed)
-     * - -24 dB/octave slopes
-     * - -6 dB at crossover points
-     * 
-     * Band Allocation:
-     * ───────────────
-     * Bass:   LP(150Hz) × 2
-     * Mid:    HP(150Hz) × 2 → LP(2400Hz) × 2
-     * Treble: HP(2400Hz) × 2
+     * Lane Layout:
+     * ───────────
+     * Both channels run through one filter network, L/R (and bass/treble)
+     * as lanes of the same vector operation:
+     *
+     * bassTreble_  lanes: [0] bass L  [1] bass R  [2] treble L  [3] treble R
+     *   stage 0:   LP 150 Hz            | HP 2400 Hz
+     *   stage 1:   LP 150 Hz (LR4)      | HP 2400 Hz (LR4)
+     *   stage 2:   low shelf bass boost | all-pass -360° @ 7200 Hz
+     *              (always the shelf, 0 dB at boost 0 - never swapped for
+     *              identity, so its TDF-II state stays consistent)
+     *
+     * mid_         lanes: [0] mid L  [1] mid R  [2..3] unused (identity)
+     *   stage 0-1: HP 150 Hz × 2
+     *   stage 2-3: LP 2400 Hz × 2
+     *   stage 4:   all-pass -180° @ 1200 Hz
+     *
+     * Linkwitz-Riley 4th order = cascade of two 2nd order Butterworth
+     * sections (phase-coherent reconstruction, -24 dB/octave).
      */
-    struct CrossoverFilters {
-        // Bass band: 20-150 Hz
-        BiquadFilter lpBass1;    ///< 1st stage lowpass @ 150 Hz
-        BiquadFilter lpBass2;    ///< 2nd stage lowpass @ 150 Hz (cascade = LR4)
-        
-        // Mid band: 150-2400 Hz (bandpass = highpass × lowpass)
-        BiquadFilter hpMid1;     ///< 1st stage highpass @ 150 Hz
-        BiquadFilter hpMid2;     ///< 2nd stage highpass @ 150 Hz
-        BiquadFilter lpMid1;     ///< 1st stage lowpass @ 2400 Hz
-        BiquadFilter lpMid2;     ///< 2nd stage lowpass @ 2400 Hz
-        
-        // Treble band: 2400-20000 Hz
-        BiquadFilter hpTreble1;  ///< 1st stage highpass @ 2400 Hz
-        BiquadFilter hpTreble2;  ///< 2nd stage highpass @ 2400 Hz (cascade = LR4)
-    };
-    
-    CrossoverFilters crossover_[2];  ///< [0] = left channel, [1] = right channel
-    
+    static constexpr int BASS_TREBLE_STAGES = 3;
+    static constexpr int MID_STAGES = 5;
+
+    BiquadLaneCascade<BASS_TREBLE_STAGES> bassTreble_;  ///< Bass + treble bands, L/R
+    BiquadLaneCascade<MID_STAGES> mid_;                 ///< Mid band, L/R
+
     /**
-     * @struct PhaseShifters
-     * @brief All-pass filters for phase compensation
-     * 
-     * Phase Shift Strategy:
-     * ────────────────────
-     * - Bass: 0° (reference, no shift)
-     * - Mid: -180° (inverted at center frequency)
-     * - Treble: -360° (full cycle at center frequency)
-     * 
-     * This realigns the phase relationships that are naturally
-     * distorted by speaker crossovers and voice coil inductance.
+     * Bass Boost Coefficient Table:
+     * ────────────────────────────
+     * Low shelf @ 150 Hz designed at prepare() for 0-12 dB in
+     * BASS_BOOST_TABLE_STEPS equal steps. While bass boost is being
+     * smoothed, coefficients are linearly interpolated between the two
+     * nearest entries (no pow/sin/cos on the audio thread).
      */
-    struct PhaseShifters {
-        BiquadFilter midPhase;     ///< -180° shift @ 1200 Hz (mid band center)
-        BiquadFilter treblePhase;  ///< -360° shift @ 7200 Hz (treble band center)
-    };
-    
-    PhaseShifters phaseShifters_[2];  ///< [0] = left, [1] = right
-    
+    static constexpr int BASS_BOOST_TABLE_STEPS = 64;      ///< 0.1875 dB per step
+    static constexpr float BASS_BOOST_MAX_DB = 12.0f;      ///< Bass boost 1.0 → +12 dB
+
+    ShelfCoefficients bassBoostTable_[BASS_BOOST_TABLE_STEPS + 1];
+    ShelfCoefficients bassBoost_;     ///< Current (interpolated) shelf coefficients
+
     // Harmonic enhancement (dynamic treble VCA)
     HarmonicEnhancer enhancer_[2];    ///< [0] = left, [1] = right
     
-    // Bass boost (low-shelf filter)
-    BiquadFilter bassBoost_[2];       ///< [0] = left, [1] = right
-    
     // ═════════════════════════════════════════════════════════════════
     // PARAMETERS (Thread-safe atomic storage)
     // ═════════════════════════════════════════════════════════════════
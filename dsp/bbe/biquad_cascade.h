@@ -0,0 +1,409 @@
+/**
+ * @file biquad_cascade.h
+ * @brief Block-processing biquad cascades (mono and 4-lane SIMD)
+ *
+ * A cascade is a fixed chain of N biquad sections processed a whole
+ * block at a time. The state of all sections is loaded into locals at
+ * the start of processBlock() and written back at the end, so within a
+ * block it stays in registers - no per-sample call or state load/store
+ * per section as with BiquadFilter::processSample().
+ *
+ * Structure: Transposed Direct Form II (2 state variables per section)
+ *   y  = b0*x + s1
+ *   s1 = b1*x - a1*y + s2
+ *   s2 = b2*x - a2*y
+ *
+ * Variants:
+ * - BiquadCascade<N>:     one signal (mono)
+ * - BiquadLaneCascade<N>: four independent signals as SIMD lanes
+ *   (SSE2 / NEON, scalar fallback). Stereo uses lanes 0-1, a 2-band
+ *   stereo network all four - each lane has its own coefficients:
+ *
+ *     lanes:     [0]      [1]      [2]        [3]
+ *     stage 0:   LP L     LP R     HP L       HP R
+ *     stage 1:   LP L     LP R     HP L       HP R
+ *
+ * Coefficients are designed by BiquadFilter::setCoefficients() and
+ * copied into a stage (setStage / setLane), or set directly from
+ * precomputed tables.
+ *
+ * Denormal protection: state below 1e-20 is flushed to zero at the
+ * end of each block, so a silent input decays to an exactly zero state
+ * (see isSilent()).
+ *
+ * @author IthacaCore Audio Team
+ * @version 1.0.0
+ * @date 2025
+ */
+
+#ifndef BIQUAD_CASCADE_H
+#define BIQUAD_CASCADE_H
+
+#include "biquad_filter.h"
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BIQUAD_CASCADE_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define BIQUAD_CASCADE_NEON 1
+#endif
+
+// ═════════════════════════════════════════════════════════════════════
+// MONO CASCADE
+// ═════════════════════════════════════════════════════════════════════
+
+/**
+ * @class BiquadCascade
+ * @brief N biquad sections in series, processed per block
+ *
+ * Usage Example:
+ * @code
+ * BiquadCascade<2> lowpass;               // LR4 = 2 × Butterworth
+ * lowpass.setStage(0, butterworth);
+ * lowpass.setStage(1, butterworth);
+ * lowpass.processBlock(buffer, buffer, numSamples);  // in-place
+ * @endcode
+ *
+ * Thread Safety:
+ * - setStage() / setStageIdentity() are NOT thread-safe
+ * - processBlock() must be called from a single thread
+ */
+template <int STAGES>
+class BiquadCascade {
+    static_assert(STAGES > 0, "BiquadCascade needs at least one stage");
+
+public:
+    BiquadCascade() noexcept {
+        for (int stage = 0; stage < STAGES; ++stage) setStageIdentity(stage);
+        reset();
+    }
+
+    /**
+     * @brief Copy coefficients of a designed filter into one stage
+     * @note RT-SAFE: plain copies (the design itself is not RT-safe)
+     */
+    void setStage(int stage, const BiquadFilter& design) noexcept {
+        design.getCoefficients(b0_[stage], b1_[stage], b2_[stage], a1_[stage], a2_[stage]);
+    }
+
+    /**
+     * @brief Set normalized coefficients (a0 = 1) of one stage directly
+     * @note RT-SAFE
+     */
+    void setStage(int stage, float b0, float b1, float b2, float a1, float a2) noexcept {
+        b0_[stage] = b0;
+        b1_[stage] = b1;
+        b2_[stage] = b2;
+        a1_[stage] = a1;
+        a2_[stage] = a2;
+    }
+
+    /**
+     * @brief Make one stage pass its input through unchanged (y = x)
+     * @note RT-SAFE
+     */
+    void setStageIdentity(int stage) noexcept {
+        setStage(stage, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+    }
+
+    /**
+     * @brief Run a block through all stages
+     * @param input Input samples
+     * @param output Output samples (may equal input for in-place)
+     * @param samples Number of samples
+     * @note RT-SAFE, state kept in locals for the whole block
+     */
+    void processBlock(const float* input, float* output, int samples) noexcept {
+        float s1[STAGES];
+        float s2[STAGES];
+        for (int stage = 0; stage < STAGES; ++stage) {
+            s1[stage] = s1_[stage];
+            s2[stage] = s2_[stage];
+        }
+
+        for (int i = 0; i < samples; ++i) {
+            float x = input[i];
+            for (int stage = 0; stage < STAGES; ++stage) {
+                const float y = b0_[stage] * x + s1[stage];
+                s1[stage] = b1_[stage] * x - a1_[stage] * y + s2[stage];
+                s2[stage] = b2_[stage] * x - a2_[stage] * y;
+                x = y;
+            }
+            output[i] = x;
+        }
+
+        for (int stage = 0; stage < STAGES; ++stage) {
+            s1_[stage] = flush(s1[stage]);
+            s2_[stage] = flush(s2[stage]);
+        }
+    }
+
+    /**
+     * @brief Reset state of all stages to zero
+     * @note RT-SAFE
+     */
+    void reset() noexcept {
+        for (int stage = 0; stage < STAGES; ++stage) {
+            s1_[stage] = s2_[stage] = 0.0f;
+        }
+    }
+
+    /**
+     * @brief Check whether the state of all stages has fully decayed
+     * @return true if all state variables are zero (processing silence
+     *         then outputs exact zeros and leaves the state unchanged)
+     * @note RT-SAFE: Read-only
+     */
+    bool isSilent() const noexcept {
+        for (int stage = 0; stage < STAGES; ++stage) {
+            if (s1_[stage] != 0.0f || s2_[stage] != 0.0f) return false;
+        }
+        return true;
+    }
+
+private:
+    static float flush(float value) noexcept {
+        return (std::abs(value) < 1e-20f) ? 0.0f : value;
+    }
+
+    // ===== FILTER COEFFICIENTS (per stage) =====
+    float b0_[STAGES];
+    float b1_[STAGES];
+    float b2_[STAGES];
+    float a1_[STAGES];
+    float a2_[STAGES];
+
+    // ===== STATE VARIABLES (Transposed Direct Form II) =====
+    float s1_[STAGES];
+    float s2_[STAGES];
+};
+
+// ═════════════════════════════════════════════════════════════════════
+// 4-LANE SIMD CASCADE
+// ═════════════════════════════════════════════════════════════════════
+
+/**
+ * @class BiquadLaneCascade
+ * @brief N biquad sections in series for four signals (one per SIMD lane)
+ *
+ * Data layout of processBlock(): lane-interleaved frames,
+ * frame i = { lane0, lane1, lane2, lane3 } at data[i * LANES].
+ *
+ * Usage Example:
+ * @code
+ * BiquadLaneCascade<2> xover;             // bass L/R | treble L/R
+ * xover.setLane<0>(0, lowpass);  xover.setLane<0>(1, lowpass);
+ * xover.setLane<0>(2, highpass); xover.setLane<0>(3, highpass);
+ * ...
+ * alignas(16) float frames[8 * BiquadLaneCascade<2>::LANES];
+ * xover.processBlock(frames, frames, 8);
+ * @endcode
+ *
+ * Thread Safety:
+ * - setLane() / setLaneIdentity() are NOT thread-safe
+ * - processBlock() must be called from a single thread
+ */
+template <int STAGES>
+class BiquadLaneCascade {
+    static_assert(STAGES > 0, "BiquadLaneCascade needs at least one stage");
+
+public:
+    static constexpr int LANES = 4;
+
+    BiquadLaneCascade() noexcept {
+        for (int stage = 0; stage < STAGES; ++stage) {
+            for (int lane = 0; lane < LANES; ++lane) setLaneIdentity(stage, lane);
+        }
+        reset();
+    }
+
+    /**
+     * @brief Copy coefficients of a designed filter into one lane of a stage
+     * @note RT-SAFE: plain copies (the design itself is not RT-safe)
+     */
+    void setLane(int stage, int lane, const BiquadFilter& design) noexcept {
+        Section& s = sections_[stage];
+        design.getCoefficients(s.b0[lane], s.b1[lane], s.b2[lane], s.a1[lane], s.a2[lane]);
+    }
+
+    /**
+     * @brief setLane() with the stage checked against STAGES at compile time
+     * @note RT-SAFE; preferred wherever the stage is a constant
+     */
+    template <int STAGE>
+    void setLane(int lane, const BiquadFilter& design) noexcept {
+        static_assert(STAGE >= 0 && STAGE < STAGES, "BiquadLaneCascade stage index out of range");
+        setLane(STAGE, lane, design);
+    }
+
+    /**
+     * @brief Set normalized coefficients (a0 = 1) of one lane directly
+     * @note RT-SAFE: for precomputed or interpolated coefficient sets
+     */
+    void setLane(int stage, int lane, float b0, float b1, float b2, float a1, float a2) noexcept {
+        Section& s = sections_[stage];
+        s.b0[lane] = b0;
+        s.b1[lane] = b1;
+        s.b2[lane] = b2;
+        s.a1[lane] = a1;
+        s.a2[lane] = a2;
+    }
+
+    /**
+     * @brief Make one lane of a stage pass its input through (y = x)
+     * @note RT-SAFE
+     */
+    void setLaneIdentity(int stage, int lane) noexcept {
+        setLane(stage, lane, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+    }
+
+    /**
+     * @brief Run a block of lane-interleaved frames through all stages
+     * @param input Input frames (frames × LANES floats)
+     * @param output Output frames (may equal input for in-place)
+     * @param frames Number of frames
+     * @note RT-SAFE, state kept in registers for the whole block
+     */
+    void processBlock(const float* input, float* output, int frames) noexcept {
+#if defined(BIQUAD_CASCADE_SSE2)
+        __m128 s1[STAGES];
+        __m128 s2[STAGES];
+        for (int stage = 0; stage < STAGES; ++stage) {
+            s1[stage] = _mm_load_ps(sections_[stage].s1);
+            s2[stage] = _mm_load_ps(sections_[stage].s2);
+        }
+
+        for (int i = 0; i < frames; ++i) {
+            __m128 x = _mm_loadu_ps(input + i * LANES);
+            for (int stage = 0; stage < STAGES; ++stage) {
+                const Section& s = sections_[stage];
+                const __m128 y = _mm_add_ps(_mm_mul_ps(_mm_load_ps(s.b0), x), s1[stage]);
+                s1[stage] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(_mm_load_ps(s.b1), x),
+                                                  _mm_mul_ps(_mm_load_ps(s.a1), y)), s2[stage]);
+                s2[stage] = _mm_sub_ps(_mm_mul_ps(_mm_load_ps(s.b2), x),
+                                       _mm_mul_ps(_mm_load_ps(s.a2), y));
+                x = y;
+            }
+            _mm_storeu_ps(output + i * LANES, x);
+        }
+
+        for (int stage = 0; stage < STAGES; ++stage) {
+            _mm_store_ps(sections_[stage].s1, s1[stage]);
+            _mm_store_ps(sections_[stage].s2, s2[stage]);
+        }
+#elif defined(BIQUAD_CASCADE_NEON)
+        float32x4_t s1[STAGES];
+        float32x4_t s2[STAGES];
+        for (int stage = 0; stage < STAGES; ++stage) {
+            s1[stage] = vld1q_f32(sections_[stage].s1);
+            s2[stage] = vld1q_f32(sections_[stage].s2);
+        }
+
+        for (int i = 0; i < frames; ++i) {
+            float32x4_t x = vld1q_f32(input + i * LANES);
+            for (int stage = 0; stage < STAGES; ++stage) {
+                const Section& s = sections_[stage];
+                const float32x4_t y = vaddq_f32(vmulq_f32(vld1q_f32(s.b0), x), s1[stage]);
+                s1[stage] = vaddq_f32(vsubq_f32(vmulq_f32(vld1q_f32(s.b1), x),
+                                                vmulq_f32(vld1q_f32(s.a1), y)), s2[stage]);
+                s2[stage] = vsubq_f32(vmulq_f32(vld1q_f32(s.b2), x),
+                                      vmulq_f32(vld1q_f32(s.a2), y));
+                x = y;
+            }
+            vst1q_f32(output + i * LANES, x);
+        }
+
+        for (int stage = 0; stage < STAGES; ++stage) {
+            vst1q_f32(sections_[stage].s1, s1[stage]);
+            vst1q_f32(sections_[stage].s2, s2[stage]);
+        }
+#else
+        for (int lane = 0; lane < LANES; ++lane) {
+            float s1[STAGES];
+            float s2[STAGES];
+            for (int stage = 0; stage < STAGES; ++stage) {
+                s1[stage] = sections_[stage].s1[lane];
+                s2[stage] = sections_[stage].s2[lane];
+            }
+
+            for (int i = 0; i < frames; ++i) {
+                float x = input[i * LANES + lane];
+                for (int stage = 0; stage < STAGES; ++stage) {
+                    const Section& s = sections_[stage];
+                    const float y = s.b0[lane] * x + s1[stage];
+                    s1[stage] = s.b1[lane] * x - s.a1[lane] * y + s2[stage];
+                    s2[stage] = s.b2[lane] * x - s.a2[lane] * y;
+                    x = y;
+                }
+                output[i * LANES + lane] = x;
+            }
+
+            for (int stage = 0; stage < STAGES; ++stage) {
+                sections_[stage].s1[lane] = s1[stage];
+                sections_[stage].s2[lane] = s2[stage];
+            }
+        }
+#endif
+        flushState();
+    }
+
+    /**
+     * @brief Reset state of all lanes of all stages to zero
+     * @note RT-SAFE
+     */
+    void reset() noexcept {
+        for (int stage = 0; stage < STAGES; ++stage) {
+            for (int lane = 0; lane < LANES; ++lane) {
+                sections_[stage].s1[lane] = sections_[stage].s2[lane] = 0.0f;
+            }
+        }
+    }
+
+    /**
+     * @brief Check whether the state of all lanes has fully decayed
+     * @return true if all state variables are zero
+     * @note RT-SAFE: Read-only
+     */
+    bool isSilent() const noexcept {
+        for (int stage = 0; stage < STAGES; ++stage) {
+            for (int lane = 0; lane < LANES; ++lane) {
+                if (sections_[stage].s1[lane] != 0.0f || sections_[stage].s2[lane] != 0.0f) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    // Denormal protection once per block: |s| < 1e-20 → 0
+    void flushState() noexcept {
+        for (int stage = 0; stage < STAGES; ++stage) {
+            for (int lane = 0; lane < LANES; ++lane) {
+                float& s1 = sections_[stage].s1[lane];
+                float& s2 = sections_[stage].s2[lane];
+                if (std::abs(s1) < 1e-20f) s1 = 0.0f;
+                if (std::abs(s2) < 1e-20f) s2 = 0.0f;
+            }
+        }
+    }
+
+    /**
+     * @brief One stage: coefficients and TDF-II state of all lanes
+     */
+    struct Section {
+        alignas(16) float b0[LANES];
+        alignas(16) float b1[LANES];
+        alignas(16) float b2[LANES];
+        alignas(16) float a1[LANES];
+        alignas(16) float a2[LANES];
+        alignas(16) float s1[LANES];
+        alignas(16) float s2[LANES];
+    };
+
+    Section sections_[STAGES];
+};
+
+#endif // BIQUAD_CASCADE_H
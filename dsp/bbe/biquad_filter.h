@@ -174,6 +174,35 @@ public:
         x1_ = x2_ = y1_ = y2_ = 0.0f;
     }
 
+    /**
+     * @brief Check whether the filter history has fully decayed
+     *
+     * With zero history, a zero input produces zero output and leaves the
+     * state unchanged. Output history reaches exact zero through the
+     * denormal flush in processSample().
+     *
+     * @return true if all state variables are zero
+     * @note RT-SAFE: Read-only
+     */
+    bool isSilent() const noexcept {
+        return x1_ == 0.0f && x2_ == 0.0f && y1_ == 0.0f && y2_ == 0.0f;
+    }
+
+    /**
+     * @brief Read normalized coefficients (a0 = 1)
+     *
+     * Lets a designed filter be loaded into a cascade stage or SIMD lane (see BiquadLaneCascade).
+     *
+     * @note RT-SAFE: Read-only
+     */
+    void getCoefficients(float& b0, float& b1, float& b2, float& a1, float& a2) const noexcept {
+        b0 = b0_;
+        b1 = b1_;
+        b2 = b2_;
+        a1 = a1_;
+        a2 = a2_;
+    }
+
 private:
     // ===== FILTER COEFFICIENTS =====
     // Feedforward (numerator) coefficients
@@ -146,11 +146,14 @@ public:
      * - Natural: 0.5 - 0.7
      * - Strong: 0.8 - 1.0
      * 
+     * The level is mapped to the enhancement depth (level * 2.0) here,
+     * so the per-sample gain calculation only scales it by the dynamic factor.
+     * 
      * @param level Definition level 0.0 to 1.0
      * @note RT-SAFE: Simple clamped assignment
      */
     void setDefinitionLevel(float level) noexcept {
-        definitionLevel_ = std::max(0.0f, std::min(1.0f, level));
+        enhancementDepth_ = std::max(0.0f, std::min(1.0f, level)) * 2.0f;
     }
 
     /**
@@ -174,56 +177,73 @@ public:
      */
     void processBlock(float* buffer, int samples) noexcept {
         for (int i = 0; i < samples; ++i) {
-            const float input = buffer[i];
-            
-            // ===== STEP 1: ENVELOPE DETECTION =====
-            // Track signal amplitude using asymmetric peak follower
-            // Fast attack catches transients, slow release smooths output
-            const float inputAbs = std::abs(input);
-            
-            if (inputAbs > envelope_) {
-                // Attack phase: Input rising
-                // Use fast attack coefficient for quick response
-                envelope_ += (inputAbs - envelope_) * (1.0f - attackCoeff_);
-            } else {
-                // Release phase: Input falling
-                // Use slow release coefficient for smooth decay
-                envelope_ += (inputAbs - envelope_) * (1.0f - releaseCoeff_);
-            }
-            
-            // ===== STEP 2: CALCULATE DYNAMIC GAIN =====
-            // Gain is inversely related to envelope level
-            // Quiet signals get more enhancement, loud signals get less
-            // This prevents over-brightening and maintains natural balance
-            
-            // Dynamic factor: 0.0 (loud) to 1.0 (quiet)
-            // Multiplied by 2.0 to make envelope detection more sensitive
-            // min() clamps to prevent negative values
-            const float dynamicFactor = 1.0f - std::min(1.0f, envelope_ * 2.0f);
-            
-            // Target gain calculation:
-            // Base gain: 1.0 (unity)
-            // Enhancement: definitionLevel * 2.0 * dynamicFactor
-            // Maximum gain: 1.0 + (1.0 * 2.0 * 1.0) = 3.0 (on very quiet signals)
-            // Minimum gain: 1.0 + (1.0 * 2.0 * 0.0) = 1.0 (on loud signals)
-            const float targetGain = 1.0f + (definitionLevel_ * 2.0f * dynamicFactor);
-            
-            // ===== STEP 3: SMOOTH GAIN CHANGES =====
-            // Interpolate between current and target gain to prevent clicks
-            // Uses exponential smoothing with 1ms time constant
-            currentGain_ += (targetGain - currentGain_) * (1.0f - gainSmoothCoeff_);
-            
-            // ===== STEP 4: APPLY ENHANCEMENT =====
-            // Multiply input by smoothed gain
-            buffer[i] = input * currentGain_;
-            
-            // ===== STEP 5: SOFT CLIPPING =====
-            // Prevent harsh digital clipping on enhanced signals
-            // Engages smoothly near ±1.5, outputs max ±0.98
-            buffer[i] = softClip(buffer[i]);
+            buffer[i] = processSample(buffer[i]);
         }
     }
 
+    /**
+     * @brief Process one sample (see processBlock() for the steps)
+     *
+     * Lets a fused per-sample pipeline (BBEProcessor) run the enhancer
+     * without an intermediate treble buffer.
+     *
+     * @param input Treble band sample
+     * @return Enhanced, soft-clipped sample
+     * @note RT-SAFE, inline
+     */
+    inline float processSample(float input) noexcept {
+        // ===== STEP 1: ENVELOPE DETECTION =====
+        // Track signal amplitude using asymmetric peak follower
+        // Fast attack catches transients, slow release smooths output
+        const float inputAbs = std::abs(input);
+        
+        if (inputAbs > envelope_) {
+            // Attack phase: Input rising
+            // Use fast attack coefficient for quick response
+            envelope_ += (inputAbs - envelope_) * (1.0f - attackCoeff_);
+        } else {
+            // Release phase: Input falling
+            // Use slow release coefficient for smooth decay
+            envelope_ += (inputAbs - envelope_) * (1.0f - releaseCoeff_);
+        }
+
+        // Flush decayed envelope to exact zero (also denormal protection).
+        // Below 1e-8, 1.0f - envelope_ * 2.0f rounds to 1.0f, so the
+        // dynamic gain is bit-identical and the release tail ends ~2 s sooner
+        if (envelope_ < 1e-8f) envelope_ = 0.0f;
+        
+        // ===== STEP 2: CALCULATE DYNAMIC GAIN =====
+        // Gain is inversely related to envelope level
+        // Quiet signals get more enhancement, loud signals get less
+        // This prevents over-brightening and maintains natural balance
+        
+        // Dynamic factor: 0.0 (loud) to 1.0 (quiet)
+        // Multiplied by 2.0 to make envelope detection more sensitive
+        // min() clamps to prevent negative values
+        const float dynamicFactor = 1.0f - std::min(1.0f, envelope_ * 2.0f);
+        
+        // Target gain calculation:
+        // Base gain: 1.0 (unity)
+        // Enhancement: enhancementDepth (definitionLevel * 2.0) * dynamicFactor
+        // Maximum gain: 1.0 + (1.0 * 2.0 * 1.0) = 3.0 (on very quiet signals)
+        // Minimum gain: 1.0 + (1.0 * 2.0 * 0.0) = 1.0 (on loud signals)
+        const float targetGain = 1.0f + (enhancementDepth_ * dynamicFactor);
+        
+        // ===== STEP 3: SMOOTH GAIN CHANGES =====
+        // Interpolate between current and target gain to prevent clicks
+        // Uses exponential smoothing with 1ms time constant
+        currentGain_ += (targetGain - currentGain_) * (1.0f - gainSmoothCoeff_);
+        
+        // ===== STEP 4: APPLY ENHANCEMENT =====
+        // Multiply input by smoothed gain
+        const float enhanced = input * currentGain_;
+        
+        // ===== STEP 5: SOFT CLIPPING =====
+        // Prevent harsh digital clipping on enhanced signals
+        // Engages smoothly near ±1.5, outputs max ±0.98
+        return softClip(enhanced);
+    }
+
     /**
      * @brief Reset all internal state to zero
      * 
@@ -244,6 +264,23 @@ public:
         currentGain_ = 1.0f;
     }
 
+    /**
+     * @brief Check whether envelope and gain have settled on silence
+     *
+     * True once the envelope has decayed to zero and one more smoothing
+     * step towards the resting gain (1 + 2 * definition) would not change
+     * currentGain_ (converged, or stalled by float rounding). Processing a
+     * silent block then leaves the state bit-identical.
+     *
+     * @return true if the enhancer state has settled
+     * @note RT-SAFE: Read-only
+     */
+    bool isSettled() const noexcept {
+        const float restingGain = 1.0f + (enhancementDepth_ * 1.0f);
+        return envelope_ == 0.0f &&
+               currentGain_ + (restingGain - currentGain_) * (1.0f - gainSmoothCoeff_) == currentGain_;
+    }
+
 private:
     /**
      * @brief Soft clipping function using tanh approximation
@@ -283,7 +320,7 @@ private:
 
     // ===== CONFIGURATION =====
     double sampleRate_{44100.0};      ///< Current sample rate (Hz)
-    float definitionLevel_{0.5f};     ///< Enhancement intensity (0.0-1.0)
+    float enhancementDepth_{1.0f};    ///< Definition level * 2.0 (0.0-2.0, default level 0.5)
     
     // ===== ENVELOPE DETECTOR STATE =====
     float envelope_{0.0f};            ///< Current envelope level (0.0-1.0)
@@ -0,0 +1,500 @@
+/**
+ * @file convolution_effect.cpp
+ * @brief Implementace konvolučního efektu
+ */
+
+#include "convolution_effect.h"
+#include "sampler/sample_rate_converter.h"
+#include "common/denormal_guard.h"
+#include "common/thread_wait.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <sndfile.h>
+#include <system_error>
+
+namespace {
+
+// Počet spin iterací audio threadu před yield při čekání na tail workera
+constexpr int TAIL_WAIT_SPIN_COUNT = 4096;
+
+// Výchozí mix (cca 50 % wet)
+constexpr uint8_t MIX_DEFAULT_MIDI = 64;
+
+// Doba rampy wet gainu při změně mixu (celý rozsah 0 → 1)
+constexpr float MIX_SMOOTHING_TIME_SEC = 0.05f;
+
+} // namespace
+
+ConvolutionEffect::ConvolutionEffect(Logger& logger)
+    : logger_(logger),
+      sourceSampleRate_(0),
+      irLength_(0),
+      hasTail0_(false),
+      hasTail_(false),
+      tailInputFill_(0),
+      silentSamples_(0),
+      tailLength_(0),
+      wetSmoothed_(static_cast<float>(MIX_DEFAULT_MIDI) / 127.0f),
+      sampleRate_(0),
+      maxBlockSize_(0),
+      isPrepared_(false),
+      wetGain_(static_cast<float>(MIX_DEFAULT_MIDI) / 127.0f),
+      mixMIDI_(MIX_DEFAULT_MIDI),
+      enabled_(true),
+      tailRequest_(0),
+      tailDone_(0),
+      tailThreadRunning_(false)
+{
+}
+
+ConvolutionEffect::~ConvolutionEffect()
+{
+    stopTailThread();
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+void ConvolutionEffect::prepare(int sampleRate, int maxBlockSize)
+{
+    stopTailThread();
+
+    sampleRate_ = sampleRate;
+    maxBlockSize_ = std::max(1, maxBlockSize);
+
+    buildChannels();
+    isPrepared_ = true;
+
+    if (hasTail_) {
+        startTailThread();
+    }
+}
+
+void ConvolutionEffect::reset() noexcept
+{
+    // Rozpracovaná úloha workera by přepsala vynulované buffery
+    waitForTailJob();
+
+    for (Channel& channel : channels_) {
+        channel.head.reset();
+        channel.tail0.reset();
+        channel.tail.reset();
+        std::fill(channel.tailInput.begin(), channel.tailInput.end(), 0.0f);
+        std::fill(channel.tail0Output.begin(), channel.tail0Output.end(), 0.0f);
+        std::fill(channel.tail0Ready.begin(), channel.tail0Ready.end(), 0.0f);
+        std::fill(channel.tailJobInput.begin(), channel.tailJobInput.end(), 0.0f);
+        std::fill(channel.tailOutput.begin(), channel.tailOutput.end(), 0.0f);
+        std::fill(channel.tailReady.begin(), channel.tailReady.end(), 0.0f);
+    }
+
+    tailInputFill_ = 0;
+    silentSamples_ = tailLength_;
+    wetSmoothed_ = wetGain_.load(std::memory_order_relaxed);
+}
+
+// ============================================================================
+// Processing
+// ============================================================================
+
+void ConvolutionEffect::process(float* leftBuffer, float* rightBuffer, int numSamples) noexcept
+{
+    if (!isPrepared_ || irLength_ == 0 || !enabled_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    const float wetTarget = wetGain_.load(std::memory_order_relaxed);
+    const float wetStep = 1.0f / (MIX_SMOOTHING_TIME_SEC * static_cast<float>(sampleRate_));
+
+    for (int offset = 0; offset < numSamples; offset += maxBlockSize_) {
+        const int chunk = std::min(maxBlockSize_, numSamples - offset);
+        float* left = leftBuffer + offset;
+        float* right = rightBuffer + offset;
+
+        bool inputSilent = true;
+        for (int i = 0; i < chunk; ++i) {
+            if (left[i] != 0.0f || right[i] != 0.0f) {
+                inputSilent = false;
+                break;
+            }
+        }
+
+        // Doznělý stav + tichý vstup = tichý výstup (stav zůstává nulový),
+        // mix lze srovnat rovnou - na tichém výstupu skok není slyšet
+        if (inputSilent && silentSamples_ >= tailLength_) {
+            wetSmoothed_ = wetTarget;
+            continue;
+        }
+        silentSamples_ = inputSilent ? std::min(silentSamples_ + chunk, tailLength_) : 0;
+
+        convolve(left, right, chunk);
+
+        const float* wetLeft = channels_[0].wet.data();
+        const float* wetRight = channels_[1].wet.data();
+        if (wetSmoothed_ == wetTarget) {
+            const float wet = wetTarget;
+            const float dry = 1.0f - wet;
+            for (int i = 0; i < chunk; ++i) {
+                left[i] = left[i] * dry + wetLeft[i] * wet;
+                right[i] = right[i] * dry + wetRight[i] * wet;
+            }
+        } else {
+            // Změna mixu: wet gain se po vzorcích blíží cíli (lineární crossfade)
+            for (int i = 0; i < chunk; ++i) {
+                if (wetSmoothed_ < wetTarget) {
+                    wetSmoothed_ = std::min(wetSmoothed_ + wetStep, wetTarget);
+                } else if (wetSmoothed_ > wetTarget) {
+                    wetSmoothed_ = std::max(wetSmoothed_ - wetStep, wetTarget);
+                }
+                const float wet = wetSmoothed_;
+                const float dry = 1.0f - wet;
+                left[i] = left[i] * dry + wetLeft[i] * wet;
+                right[i] = right[i] * dry + wetRight[i] * wet;
+            }
+        }
+    }
+}
+
+void ConvolutionEffect::convolve(const float* left, const float* right, int numSamples) noexcept
+{
+    const float* inputs[2] = { left, right };
+
+    // Head: IR [0, T) bez latence
+    for (size_t c = 0; c < channels_.size(); ++c) {
+        channels_[c].head.process(inputs[c], channels_[c].wet.data(), numSamples);
+    }
+
+    if (!hasTail0_) {
+        return;
+    }
+
+    int processed = 0;
+    while (processed < numSamples) {
+        // Po krocích zarovnaných na bloky H (hranice pro tail0)
+        const int count = std::min(numSamples - processed,
+                                   HEAD_BLOCK_SIZE - (tailInputFill_ % HEAD_BLOCK_SIZE));
+
+        for (size_t c = 0; c < channels_.size(); ++c) {
+            Channel& channel = channels_[c];
+            float* wet = channel.wet.data() + processed;
+            const float* tail0Ready = channel.tail0Ready.data() + tailInputFill_;
+
+            for (int i = 0; i < count; ++i) {
+                wet[i] += tail0Ready[i];
+            }
+            if (hasTail_) {
+                const float* tailReady = channel.tailReady.data() + tailInputFill_;
+                for (int i = 0; i < count; ++i) {
+                    wet[i] += tailReady[i];
+                }
+            }
+
+            std::copy(inputs[c] + processed, inputs[c] + processed + count,
+                      channel.tailInput.begin() + tailInputFill_);
+        }
+
+        tailInputFill_ += count;
+
+        // Tail0: IR [T, 2T) po blocích H, výstup se přičítá v dalším bloku T
+        if (tailInputFill_ % HEAD_BLOCK_SIZE == 0) {
+            const int blockOffset = tailInputFill_ - HEAD_BLOCK_SIZE;
+            for (Channel& channel : channels_) {
+                channel.tail0.process(channel.tailInput.data() + blockOffset,
+                                      channel.tail0Output.data() + blockOffset, HEAD_BLOCK_SIZE);
+            }
+        }
+
+        if (tailInputFill_ == TAIL_BLOCK_SIZE) {
+            for (Channel& channel : channels_) {
+                channel.tail0Ready.swap(channel.tail0Output);
+            }
+
+            // Tail: IR [2T, konec) - výsledek předchozího bloku převzít, nový blok předat workeru
+            if (hasTail_) {
+                waitForTailJob();
+                for (Channel& channel : channels_) {
+                    channel.tailReady.swap(channel.tailOutput);
+                    channel.tailJobInput.swap(channel.tailInput);
+                }
+
+                if (tailThreadRunning_.load(std::memory_order_relaxed)) {
+                    tailRequest_.fetch_add(1, std::memory_order_release);
+                    wakeAll(tailRequest_);
+                } else {
+                    runTailJob();
+                }
+            }
+
+            tailInputFill_ = 0;
+        }
+
+        processed += count;
+    }
+}
+
+// ============================================================================
+// Background tail
+// ============================================================================
+
+void ConvolutionEffect::runTailJob() noexcept
+{
+    for (Channel& channel : channels_) {
+        channel.tail.process(channel.tailJobInput.data(), channel.tailOutput.data(), TAIL_BLOCK_SIZE);
+    }
+}
+
+void ConvolutionEffect::waitForTailJob() noexcept
+{
+    // Worker má na úlohu celý blok T - v praxi je hotová dávno předem
+    int spins = 0;
+    while (tailDone_.load(std::memory_order_acquire) != tailRequest_.load(std::memory_order_relaxed)) {
+        if (++spins > TAIL_WAIT_SPIN_COUNT) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void ConvolutionEffect::tailWorkerLoop() noexcept
+{
+    // FFT tail doznívá stejně jako audio thread - FTZ/DAZ na celou dobu života
+    ScopedDenormalProtection denormalGuard;
+
+    // Start od poslední vyřízené úlohy - požadavek mohl přijít dřív, než vlákno naběhlo
+    uint32_t seenRequest = tailDone_.load(std::memory_order_acquire);
+
+    while (true) {
+        uint32_t current;
+        while ((current = tailRequest_.load(std::memory_order_acquire)) == seenRequest) {
+            waitWhileEqual(tailRequest_, seenRequest);
+        }
+        seenRequest = current;
+
+        if (!tailThreadRunning_.load(std::memory_order_acquire)) return;
+
+        runTailJob();
+        tailDone_.store(current, std::memory_order_release);
+    }
+}
+
+void ConvolutionEffect::startTailThread()
+{
+    tailThreadRunning_.store(true, std::memory_order_release);
+
+    try {
+        tailThread_ = std::thread(&ConvolutionEffect::tailWorkerLoop, this);
+    } catch (const std::system_error& e) {
+        tailThreadRunning_.store(false, std::memory_order_release);
+        logger_.log("ConvolutionEffect/startTailThread", LogSeverity::Warning,
+                    "Cannot start tail thread (" + std::string(e.what()) +
+                    "), tail partitions run on the audio thread");
+    }
+}
+
+void ConvolutionEffect::stopTailThread()
+{
+    if (!tailThread_.joinable()) {
+        return;
+    }
+
+    tailThreadRunning_.store(false, std::memory_order_release);
+    tailRequest_.fetch_add(1, std::memory_order_release);
+    wakeAll(tailRequest_);
+    tailThread_.join();
+
+    // Ukončovací požadavek se nepočítá jako nevyřízená úloha
+    tailDone_.store(tailRequest_.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+// ============================================================================
+// Impulse Response
+// ============================================================================
+
+bool ConvolutionEffect::loadImpulseResponse(const std::string& path)
+{
+    SF_INFO sfinfo{};
+    SNDFILE* sndfile = sf_open(path.c_str(), SFM_READ, &sfinfo);
+
+    if (!sndfile) {
+        logger_.log("ConvolutionEffect/loadImpulseResponse", LogSeverity::Error,
+                    "Cannot open impulse response " + path + ": " + std::string(sf_strerror(nullptr)));
+        return false;
+    }
+
+    if (sfinfo.frames <= 0 || sfinfo.channels < 1 || sfinfo.samplerate <= 0) {
+        logger_.log("ConvolutionEffect/loadImpulseResponse", LogSeverity::Error,
+                    "Invalid impulse response " + path + ": " + std::to_string(sfinfo.frames) +
+                    " frames, " + std::to_string(sfinfo.channels) + " channels");
+        sf_close(sndfile);
+        return false;
+    }
+
+    const int channelCount = sfinfo.channels;
+    const int frameCount = static_cast<int>(sfinfo.frames);
+
+    // Načtení dat pomocí sf_readf_float (automatická PCM->float konverze)
+    std::vector<float> interleaved(static_cast<size_t>(frameCount) * static_cast<size_t>(channelCount));
+    const sf_count_t framesRead = sf_readf_float(sndfile, interleaved.data(), sfinfo.frames);
+    sf_close(sndfile);
+
+    if (framesRead != sfinfo.frames) {
+        logger_.log("ConvolutionEffect/loadImpulseResponse", LogSeverity::Error,
+                    "Data reading error from impulse response " + path + ": expected " +
+                    std::to_string(frameCount) + " frames, read " + std::to_string(framesRead));
+        return false;
+    }
+
+    if (channelCount > 2) {
+        logger_.log("ConvolutionEffect/loadImpulseResponse", LogSeverity::Warning,
+                    "Impulse response " + path + " has " + std::to_string(channelCount) +
+                    " channels, using first two");
+    }
+
+    // Deinterleave (mono zůstane v levém kanálu)
+    std::vector<float> left(static_cast<size_t>(frameCount));
+    std::vector<float> right(channelCount > 1 ? static_cast<size_t>(frameCount) : 0);
+    for (int frame = 0; frame < frameCount; ++frame) {
+        const size_t base = static_cast<size_t>(frame) * static_cast<size_t>(channelCount);
+        left[static_cast<size_t>(frame)] = interleaved[base];
+        if (channelCount > 1) {
+            right[static_cast<size_t>(frame)] = interleaved[base + 1];
+        }
+    }
+
+    setImpulseResponse(left.data(), channelCount > 1 ? right.data() : nullptr, frameCount, sfinfo.samplerate);
+
+    logger_.log("ConvolutionEffect/loadImpulseResponse", LogSeverity::Info,
+                "Loaded impulse response " + path + ": " + std::to_string(frameCount) + " frames, " +
+                std::to_string(channelCount) + " channels @ " + std::to_string(sfinfo.samplerate) + " Hz");
+    return true;
+}
+
+void ConvolutionEffect::setImpulseResponse(const float* left, const float* right, int length, int sampleRate)
+{
+    const int frames = (left && length > 0) ? length : 0;
+
+    sourceLeft_.assign(left, left + frames);
+    if (right && frames > 0) {
+        sourceRight_.assign(right, right + frames);
+    } else {
+        sourceRight_.clear();
+    }
+    sourceSampleRate_ = sampleRate;
+
+    // Po prepare() se odezva připraví hned (mimo běh audia)
+    if (isPrepared_) {
+        stopTailThread();
+        buildChannels();
+        if (hasTail_) {
+            startTailThread();
+        }
+    }
+}
+
+void ConvolutionEffect::buildChannels()
+{
+    std::vector<float> left = sourceLeft_;
+    std::vector<float> right = sourceRight_.empty() ? sourceLeft_ : sourceRight_;
+
+    // Převzorkování na sample rate enginu
+    if (!left.empty() && sourceSampleRate_ > 0 && sourceSampleRate_ != sampleRate_) {
+        const int inputFrames = static_cast<int>(left.size());
+        std::vector<float> interleaved(static_cast<size_t>(inputFrames) * 2);
+        for (int i = 0; i < inputFrames; ++i) {
+            interleaved[static_cast<size_t>(i) * 2] = left[static_cast<size_t>(i)];
+            interleaved[static_cast<size_t>(i) * 2 + 1] = right[static_cast<size_t>(i)];
+        }
+
+        int outputFrames = 0;
+        float* resampled = SampleRateConverter::resampleStereo(interleaved.data(), inputFrames,
+                                                               sourceSampleRate_, sampleRate_,
+                                                               outputFrames, logger_);
+        if (!resampled) {
+            logger_.log("ConvolutionEffect/buildChannels", LogSeverity::Error,
+                        "Impulse response resampling failed, convolution bypassed");
+            outputFrames = 0;
+        }
+
+        left.assign(static_cast<size_t>(outputFrames), 0.0f);
+        right.assign(static_cast<size_t>(outputFrames), 0.0f);
+        for (int i = 0; i < outputFrames; ++i) {
+            left[static_cast<size_t>(i)] = resampled[static_cast<size_t>(i) * 2];
+            right[static_cast<size_t>(i)] = resampled[static_cast<size_t>(i) * 2 + 1];
+        }
+        free(resampled);
+    }
+
+    const int maxLength = CONVOLUTION_MAX_IR_SECONDS * sampleRate_;
+    irLength_ = static_cast<int>(left.size());
+    if (irLength_ > maxLength) {
+        logger_.log("ConvolutionEffect/buildChannels", LogSeverity::Warning,
+                    "Impulse response truncated to " + std::to_string(CONVOLUTION_MAX_IR_SECONDS) + " s");
+        irLength_ = maxLength;
+    }
+
+    hasTail0_ = irLength_ > TAIL_BLOCK_SIZE;
+    hasTail_ = irLength_ > 2 * TAIL_BLOCK_SIZE;
+
+    // Po posledním nenulovém vstupu projde stav celou IR a pipeline tail (2T) + rezerva
+    tailLength_ = irLength_ > 0 ? irLength_ + 3 * TAIL_BLOCK_SIZE : 0;
+
+    const float* sources[2] = { left.data(), right.data() };
+    for (size_t c = 0; c < channels_.size(); ++c) {
+        Channel& channel = channels_[c];
+        const float* ir = sources[c];
+
+        channel.head.init(HEAD_BLOCK_SIZE, ir, std::min(irLength_, TAIL_BLOCK_SIZE));
+        channel.tail0.init(HEAD_BLOCK_SIZE, hasTail0_ ? ir + TAIL_BLOCK_SIZE : nullptr,
+                           hasTail0_ ? std::min(irLength_, 2 * TAIL_BLOCK_SIZE) - TAIL_BLOCK_SIZE : 0);
+        channel.tail.init(TAIL_BLOCK_SIZE, hasTail_ ? ir + 2 * TAIL_BLOCK_SIZE : nullptr,
+                          hasTail_ ? irLength_ - 2 * TAIL_BLOCK_SIZE : 0);
+
+        const size_t tailSize = static_cast<size_t>(TAIL_BLOCK_SIZE);
+        channel.tailInput.assign(tailSize, 0.0f);
+        channel.tail0Output.assign(tailSize, 0.0f);
+        channel.tail0Ready.assign(tailSize, 0.0f);
+        channel.tailJobInput.assign(tailSize, 0.0f);
+        channel.tailOutput.assign(tailSize, 0.0f);
+        channel.tailReady.assign(tailSize, 0.0f);
+        channel.wet.assign(static_cast<size_t>(maxBlockSize_), 0.0f);
+    }
+
+    tailInputFill_ = 0;
+    silentSamples_ = tailLength_;
+    wetSmoothed_ = wetGain_.load(std::memory_order_relaxed);
+}
+
+// ============================================================================
+// State Management
+// ============================================================================
+
+void ConvolutionEffect::setEnabled(bool enabled) noexcept
+{
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+bool ConvolutionEffect::isEnabled() const noexcept
+{
+    return enabled_.load(std::memory_order_relaxed);
+}
+
+bool ConvolutionEffect::isTailSilent() const noexcept
+{
+    return silentSamples_ >= tailLength_;
+}
+
+// ============================================================================
+// MIDI API
+// ============================================================================
+
+void ConvolutionEffect::setMixMIDI(uint8_t midiValue) noexcept
+{
+    const uint8_t clamped = std::min<uint8_t>(midiValue, 127);
+    mixMIDI_.store(clamped, std::memory_order_relaxed);
+    wetGain_.store(static_cast<float>(clamped) / 127.0f, std::memory_order_relaxed);
+}
+
+uint8_t ConvolutionEffect::getMixMIDI() const noexcept
+{
+    return mixMIDI_.load(std::memory_order_relaxed);
+}
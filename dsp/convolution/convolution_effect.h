@@ -0,0 +1,227 @@
+/**
+ * @file convolution_effect.h
+ * @brief Konvoluční efekt pro rezonanci ozvučné desky / prostoru (impulsní odezva)
+ *
+ * Dvoustupňová nerovnoměrně dělená FFT konvoluce bez latence:
+ *
+ *   IR:  [0, T)          → head:  partitions H (64) - audio thread
+ *        [T, 2T)         → tail0: partitions H      - audio thread, výsledek o T později
+ *        [2T, konec)     → tail:  partitions T      - background thread, výsledek o 2T později
+ *
+ * Head drží nulovou latenci pro libovolnou velikost bloku. Dlouhá část
+ * odezvy (sekundy) se počítá po velkých blocích T na pozadí - vstup bloku
+ * T se předá workeru, výsledek je potřeba až po dalších T vzorcích. Na audio
+ * threadu tak zůstane jen konstantní práce 2T/H partitions bez ohledu na
+ * délku IR.
+ *
+ * Výstup je deterministický: pokud worker nestihne blok (nebo vlákno
+ * nelze spustit), audio thread na výsledek počká / spočítá ho sám.
+ *
+ * Impulsní odezva:
+ * - loadImpulseResponse() - WAV/AIFF/... přes libsndfile (mono i stereo)
+ * - setImpulseResponse() - přímo z paměti
+ * - mono IR se použije pro oba kanály, stereo IR kanál po kanálu (L→L, R→R)
+ * - odlišný sample rate se při prepare() převzorkuje (SampleRateConverter)
+ *
+ * THREAD SAFETY:
+ * - loadImpulseResponse(), setImpulseResponse(), prepare() - NE RT-safe;
+ *   nevolat souběžně s process() (za běhu audia připrav novou instanci
+ *   a vyměň ji v DspChain)
+ * - reset(), process(), isTailSilent() - RT-safe, audio thread
+ * - setMixMIDI(), setEnabled() - RT-safe (atomické parametry, mix se
+ *   v audio threadu plynule dorovná - bez skoku na výstupu)
+ */
+
+#pragma once
+
+#include "../dsp_effect.h"
+#include "partitioned_convolver.h"
+#include "sampler/core_logger.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Délka partition head/tail0 (audio thread) - mocnina 2
+#ifndef CONVOLUTION_HEAD_BLOCK_SIZE
+#define CONVOLUTION_HEAD_BLOCK_SIZE 64
+#endif
+
+// Délka partition tail (background thread) - mocnina 2, násobek head
+#ifndef CONVOLUTION_TAIL_BLOCK_SIZE
+#define CONVOLUTION_TAIL_BLOCK_SIZE 1024
+#endif
+
+// Maximální délka impulsní odezvy (delší se ořízne)
+#ifndef CONVOLUTION_MAX_IR_SECONDS
+#define CONVOLUTION_MAX_IR_SECONDS 10
+#endif
+
+/**
+ * @class ConvolutionEffect
+ * @brief Stereo konvoluce s impulsní odezvou, tail na background threadu
+ *
+ * MIDI Mapování:
+ * - Mix: 0 = dry, 127 = wet (lineární crossfade)
+ * - Enabled: 0 = off, 1-127 = on
+ *
+ * Použití:
+ * @code
+ * auto convolution = std::make_unique<ConvolutionEffect>(logger);
+ * if (convolution->loadImpulseResponse("soundboard.wav")) {
+ *     convolution->setMixMIDI(40);
+ *     voiceManager.getDspChain()->addEffect(std::move(convolution));
+ * }
+ * @endcode
+ */
+class ConvolutionEffect : public DspEffect {
+public:
+    static constexpr int HEAD_BLOCK_SIZE = CONVOLUTION_HEAD_BLOCK_SIZE;
+    static constexpr int TAIL_BLOCK_SIZE = CONVOLUTION_TAIL_BLOCK_SIZE;
+
+    static_assert((HEAD_BLOCK_SIZE & (HEAD_BLOCK_SIZE - 1)) == 0, "Head block size must be a power of 2");
+    static_assert((TAIL_BLOCK_SIZE & (TAIL_BLOCK_SIZE - 1)) == 0, "Tail block size must be a power of 2");
+    static_assert(TAIL_BLOCK_SIZE >= HEAD_BLOCK_SIZE, "Tail block must not be shorter than head block");
+
+    /**
+     * @brief Konstruktor - efekt bez impulsní odezvy (bypass)
+     * @param logger Logger pro načítání a převzorkování IR
+     *
+     * Default:
+     * - Mix: 64 MIDI (cca 50 % wet)
+     * - Enabled: true
+     */
+    explicit ConvolutionEffect(Logger& logger);
+
+    /**
+     * @brief Destruktor - zastaví background thread
+     */
+    ~ConvolutionEffect() override;
+
+    // ========================================================================
+    // DspEffect Interface Implementation
+    // ========================================================================
+
+    void prepare(int sampleRate, int maxBlockSize) override;
+    void reset() noexcept override;
+    void process(float* leftBuffer, float* rightBuffer, int numSamples) noexcept override;
+    void setEnabled(bool enabled) noexcept override;
+    bool isEnabled() const noexcept override;
+    bool isTailSilent() const noexcept override;
+    const char* getName() const noexcept override { return "Convolution"; }
+
+    // ========================================================================
+    // Impulse Response (ne RT-safe)
+    // ========================================================================
+
+    /**
+     * @brief Načte impulsní odezvu ze souboru (libsndfile)
+     * @param path Cesta k souboru (mono nebo stereo)
+     * @return true při úspěchu, false při chybě (zalogováno, IR beze změny)
+     *
+     * @note NENÍ RT-safe - volat před prepare() nebo mimo běh audia
+     */
+    bool loadImpulseResponse(const std::string& path);
+
+    /**
+     * @brief Nastaví impulsní odezvu z paměti
+     * @param left Levý kanál (nebo mono)
+     * @param right Pravý kanál (nullptr = mono, použije se left)
+     * @param length Délka ve vzorcích
+     * @param sampleRate Sample rate odezvy v Hz
+     *
+     * @note NENÍ RT-safe - volat před prepare() nebo mimo běh audia
+     */
+    void setImpulseResponse(const float* left, const float* right, int length, int sampleRate);
+
+    /**
+     * @brief Délka připravené impulsní odezvy ve vzorcích (po převzorkování)
+     */
+    int getImpulseResponseLength() const noexcept { return irLength_; }
+
+    // ========================================================================
+    // MIDI API (0-127) - RT-safe
+    // ========================================================================
+
+    /**
+     * @brief Nastaví poměr dry/wet pomocí MIDI hodnoty
+     * @param midiValue 0 = dry, 127 = wet
+     *
+     * @note RT-safe - lze volat z audio threadu
+     * @note Změna se projeví lineární rampou (celý rozsah za 50 ms)
+     */
+    void setMixMIDI(uint8_t midiValue) noexcept;
+
+    /**
+     * @brief Získá poměr dry/wet jako MIDI hodnotu
+     * @note RT-safe
+     */
+    uint8_t getMixMIDI() const noexcept;
+
+private:
+    /**
+     * @brief Konvoluční stav jednoho kanálu (head, tail0, tail + buffery pipeline)
+     */
+    struct Channel {
+        PartitionedConvolver head;          // IR [0, T)
+        PartitionedConvolver tail0;         // IR [T, 2T), partitions H
+        PartitionedConvolver tail;          // IR [2T, konec), partitions T
+
+        std::vector<float> tailInput;       // Vstup sbíraný po blocích T
+        std::vector<float> tail0Output;     // Rozpracovaný výstup tail0 (aktuální blok T)
+        std::vector<float> tail0Ready;      // Výstup tail0 k přičtení (předchozí blok T)
+        std::vector<float> tailJobInput;    // Vstup úlohy background threadu
+        std::vector<float> tailOutput;      // Výstup úlohy background threadu
+        std::vector<float> tailReady;       // Výstup tail k přičtení
+        std::vector<float> wet;             // Scratch wet signálu (maxBlockSize)
+    };
+
+    // ===== SETUP (ne RT-safe) =====
+    void buildChannels();
+    void startTailThread();
+    void stopTailThread();
+
+    // ===== PROCESSING (RT-safe) =====
+    void convolve(const float* left, const float* right, int numSamples) noexcept;
+    void runTailJob() noexcept;
+    void waitForTailJob() noexcept;
+    void tailWorkerLoop() noexcept;
+
+    Logger& logger_;
+
+    // Impulsní odezva v původním sample rate (stereo, deinterleaved)
+    std::vector<float> sourceLeft_;
+    std::vector<float> sourceRight_;
+    int sourceSampleRate_;
+
+    std::array<Channel, 2> channels_;
+    int irLength_;                          // Délka IR po převzorkování
+    bool hasTail0_;                         // IR delší než T
+    bool hasTail_;                          // IR delší než 2T
+    int tailInputFill_;                     // Pozice v aktuálním bloku T
+    int silentSamples_;                     // Počet vzorků nulového vstupu v řadě
+    int tailLength_;                        // Po tolika nulových vzorcích je stav nulový
+    float wetSmoothed_;                     // Wet gain audio threadu (rampa k wetGain_)
+
+    int sampleRate_;
+    int maxBlockSize_;
+    bool isPrepared_;
+
+    // Atomic parametry
+    std::atomic<float> wetGain_;
+    std::atomic<uint8_t> mixMIDI_;
+    std::atomic<bool> enabled_;
+
+    // Background thread (tail): úloha = nová hodnota tailRequest_, hotovo = tailDone_
+    std::thread tailThread_;
+    std::atomic<uint32_t> tailRequest_;
+    std::atomic<uint32_t> tailDone_;
+    std::atomic<bool> tailThreadRunning_;
+
+    // Non-copyable
+    ConvolutionEffect(const ConvolutionEffect&) = delete;
+    ConvolutionEffect& operator=(const ConvolutionEffect&) = delete;
+};
@@ -0,0 +1,188 @@
+/**
+ * @file partitioned_convolver.cpp
+ * @brief Implementace uniformně dělené FFT konvoluce
+ */
+
+#include "partitioned_convolver.h"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARTITIONED_CONVOLVER_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define PARTITIONED_CONVOLVER_NEON 1
+#endif
+
+namespace {
+
+/**
+ * @brief acc += a · b (komplexní, oddělené re/im pole)
+ */
+inline void complexMultiplyAccumulate(float* accRe, float* accIm,
+                                      const float* aRe, const float* aIm,
+                                      const float* bRe, const float* bIm,
+                                      int count) noexcept {
+    int i = 0;
+
+#if defined(PARTITIONED_CONVOLVER_SSE2)
+    for (; i + 4 <= count; i += 4) {
+        const __m128 ar = _mm_loadu_ps(aRe + i);
+        const __m128 ai = _mm_loadu_ps(aIm + i);
+        const __m128 br = _mm_loadu_ps(bRe + i);
+        const __m128 bi = _mm_loadu_ps(bIm + i);
+        const __m128 re = _mm_sub_ps(_mm_mul_ps(ar, br), _mm_mul_ps(ai, bi));
+        const __m128 im = _mm_add_ps(_mm_mul_ps(ar, bi), _mm_mul_ps(ai, br));
+        _mm_storeu_ps(accRe + i, _mm_add_ps(_mm_loadu_ps(accRe + i), re));
+        _mm_storeu_ps(accIm + i, _mm_add_ps(_mm_loadu_ps(accIm + i), im));
+    }
+#elif defined(PARTITIONED_CONVOLVER_NEON)
+    for (; i + 4 <= count; i += 4) {
+        const float32x4_t ar = vld1q_f32(aRe + i);
+        const float32x4_t ai = vld1q_f32(aIm + i);
+        const float32x4_t br = vld1q_f32(bRe + i);
+        const float32x4_t bi = vld1q_f32(bIm + i);
+        float32x4_t re = vld1q_f32(accRe + i);
+        float32x4_t im = vld1q_f32(accIm + i);
+        re = vmlsq_f32(vmlaq_f32(re, ar, br), ai, bi);
+        im = vmlaq_f32(vmlaq_f32(im, ar, bi), ai, br);
+        vst1q_f32(accRe + i, re);
+        vst1q_f32(accIm + i, im);
+    }
+#endif
+
+    // Skalární zbytek (a fallback bez SIMD)
+    for (; i < count; ++i) {
+        accRe[i] += aRe[i] * bRe[i] - aIm[i] * bIm[i];
+        accIm[i] += aRe[i] * bIm[i] + aIm[i] * bRe[i];
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+void PartitionedConvolver::init(int blockSize, const float* ir, int irLength)
+{
+    blockSize_ = blockSize;
+    binCount_ = blockSize + 1;
+    partitionCount_ = (ir && irLength > 0) ? (irLength + blockSize - 1) / blockSize : 0;
+
+    const int fftSize = 2 * blockSize;
+    fft_.init(fftSize);
+
+    const size_t spectrumSize = static_cast<size_t>(partitionCount_) * static_cast<size_t>(binCount_);
+    irRe_.assign(spectrumSize, 0.0f);
+    irIm_.assign(spectrumSize, 0.0f);
+    historyRe_.assign(spectrumSize, 0.0f);
+    historyIm_.assign(spectrumSize, 0.0f);
+
+    accumRe_.assign(static_cast<size_t>(binCount_), 0.0f);
+    accumIm_.assign(static_cast<size_t>(binCount_), 0.0f);
+    spectrumRe_.assign(static_cast<size_t>(binCount_), 0.0f);
+    spectrumIm_.assign(static_cast<size_t>(binCount_), 0.0f);
+
+    fftBuffer_.assign(static_cast<size_t>(fftSize), 0.0f);
+    inputBlock_.assign(static_cast<size_t>(blockSize), 0.0f);
+    overlap_.assign(static_cast<size_t>(blockSize), 0.0f);
+
+    // Spektra partitions (zero-padding na 2B); normalizace IFFT 1/2B je zapracovaná sem
+    const float scale = 1.0f / static_cast<float>(fftSize);
+    for (int p = 0; p < partitionCount_; ++p) {
+        const int offset = p * blockSize;
+        const int length = std::min(blockSize, irLength - offset);
+
+        std::fill(fftBuffer_.begin(), fftBuffer_.end(), 0.0f);
+        for (int i = 0; i < length; ++i) {
+            fftBuffer_[static_cast<size_t>(i)] = ir[offset + i] * scale;
+        }
+
+        const size_t bins = static_cast<size_t>(p) * static_cast<size_t>(binCount_);
+        fft_.forward(fftBuffer_.data(), irRe_.data() + bins, irIm_.data() + bins);
+    }
+
+    reset();
+}
+
+void PartitionedConvolver::reset() noexcept
+{
+    std::fill(historyRe_.begin(), historyRe_.end(), 0.0f);
+    std::fill(historyIm_.begin(), historyIm_.end(), 0.0f);
+    std::fill(accumRe_.begin(), accumRe_.end(), 0.0f);
+    std::fill(accumIm_.begin(), accumIm_.end(), 0.0f);
+    std::fill(inputBlock_.begin(), inputBlock_.end(), 0.0f);
+    std::fill(overlap_.begin(), overlap_.end(), 0.0f);
+    current_ = 0;
+    inputFill_ = 0;
+}
+
+// ============================================================================
+// Processing
+// ============================================================================
+
+void PartitionedConvolver::process(const float* input, float* output, int numSamples) noexcept
+{
+    if (partitionCount_ == 0) {
+        std::fill(output, output + numSamples, 0.0f);
+        return;
+    }
+
+    const size_t bins = static_cast<size_t>(binCount_);
+    int processed = 0;
+
+    while (processed < numSamples) {
+        const bool blockStart = (inputFill_ == 0);
+        const int position = inputFill_;
+        const int count = std::min(numSamples - processed, blockSize_ - inputFill_);
+
+        std::copy(input + processed, input + processed + count, inputBlock_.begin() + position);
+
+        // FFT rozpracovaného bloku (doplněného nulami) do nejnovějšího slotu historie
+        std::copy(inputBlock_.begin(), inputBlock_.end(), fftBuffer_.begin());
+        std::fill(fftBuffer_.begin() + blockSize_, fftBuffer_.end(), 0.0f);
+
+        float* currentRe = historyRe_.data() + static_cast<size_t>(current_) * bins;
+        float* currentIm = historyIm_.data() + static_cast<size_t>(current_) * bins;
+        fft_.forward(fftBuffer_.data(), currentRe, currentIm);
+
+        // Starší bloky × H[1..P-1] se během bloku nemění - jednou na jeho začátku
+        if (blockStart) {
+            std::fill(accumRe_.begin(), accumRe_.end(), 0.0f);
+            std::fill(accumIm_.begin(), accumIm_.end(), 0.0f);
+
+            for (int p = 1; p < partitionCount_; ++p) {
+                const size_t slot = static_cast<size_t>((current_ + p) % partitionCount_) * bins;
+                const size_t partition = static_cast<size_t>(p) * bins;
+                complexMultiplyAccumulate(accumRe_.data(), accumIm_.data(),
+                                          historyRe_.data() + slot, historyIm_.data() + slot,
+                                          irRe_.data() + partition, irIm_.data() + partition,
+                                          binCount_);
+            }
+        }
+
+        std::copy(accumRe_.begin(), accumRe_.end(), spectrumRe_.begin());
+        std::copy(accumIm_.begin(), accumIm_.end(), spectrumIm_.begin());
+        complexMultiplyAccumulate(spectrumRe_.data(), spectrumIm_.data(),
+                                  currentRe, currentIm, irRe_.data(), irIm_.data(), binCount_);
+
+        fft_.inverse(spectrumRe_.data(), spectrumIm_.data(), fftBuffer_.data());
+
+        for (int i = 0; i < count; ++i) {
+            output[processed + i] = fftBuffer_[static_cast<size_t>(position + i)] +
+                                    overlap_[static_cast<size_t>(position + i)];
+        }
+
+        // Plný blok: overlap pro další blok, posun historie (nejnovější slot o jeden zpět)
+        inputFill_ += count;
+        if (inputFill_ == blockSize_) {
+            std::copy(fftBuffer_.begin() + blockSize_, fftBuffer_.end(), overlap_.begin());
+            std::fill(inputBlock_.begin(), inputBlock_.end(), 0.0f);
+            inputFill_ = 0;
+            current_ = (current_ > 0) ? current_ - 1 : partitionCount_ - 1;
+        }
+
+        processed += count;
+    }
+}
@@ -0,0 +1,80 @@
+/**
+ * @file partitioned_convolver.h
+ * @brief Uniformně dělená FFT konvoluce (mono, bez latence)
+ *
+ * Impulsní odezva je rozdělena na P partitions délky B. Každá partition
+ * je předem transformovaná FFT velikosti 2B; vstup se transformuje po
+ * blocích B a ukládá do kruhové historie spekter (frequency-domain delay
+ * line). Výstup bloku = IFFT(Σ X[n-p]·H[p]) + overlap předchozího bloku.
+ *
+ * Bez latence: process() přijme libovolný počet vzorků - neúplný blok se
+ * transformuje i doplněný nulami a příspěvky starších bloků (p >= 1) se
+ * sčítají jen jednou na začátku bloku.
+ *
+ * THREAD SAFETY:
+ * - init() - NE RT-safe (alokace, FFT impulsní odezvy)
+ * - reset(), process() - RT-safe, jedno vlákno
+ */
+
+#pragma once
+
+#include "real_fft.h"
+#include <vector>
+
+/**
+ * @class PartitionedConvolver
+ * @brief Konvoluce jednoho kanálu s uniformními partitions
+ */
+class PartitionedConvolver {
+public:
+    PartitionedConvolver() = default;
+
+    /**
+     * @brief Rozdělí a transformuje impulsní odezvu
+     * @param blockSize Délka partition B (mocnina 2)
+     * @param ir Impulsní odezva (může být nullptr pro irLength 0)
+     * @param irLength Délka odezvy ve vzorcích (0 = výstup vždy nulový)
+     * @note NENÍ RT-safe
+     */
+    void init(int blockSize, const float* ir, int irLength);
+
+    /**
+     * @brief Vynuluje historii vstupu i overlap (impulsní odezva zůstává)
+     * @note RT-safe
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Zpracuje vzorky (výstup se přepíše, ne přičte)
+     * @param input Vstup (numSamples vzorků)
+     * @param output Výstup (numSamples vzorků, nesmí být alias vstupu)
+     * @param numSamples Libovolný počet vzorků
+     * @note RT-safe
+     */
+    void process(const float* input, float* output, int numSamples) noexcept;
+
+    int getPartitionCount() const noexcept { return partitionCount_; }
+
+private:
+    int blockSize_ = 0;                 // Délka partition B
+    int binCount_ = 0;                  // B+1 binů spektra (FFT 2B)
+    int partitionCount_ = 0;            // Počet partitions impulsní odezvy
+    int current_ = 0;                   // Slot historie s nejnovějším blokem vstupu
+    int inputFill_ = 0;                 // Počet vzorků v rozpracovaném bloku
+
+    RealFft fft_;
+
+    std::vector<float> irRe_;           // Spektra partitions [partition][bin] (škálovaná 1/2B)
+    std::vector<float> irIm_;
+    std::vector<float> historyRe_;      // Kruhová historie spekter vstupu [slot][bin]
+    std::vector<float> historyIm_;
+
+    std::vector<float> accumRe_;        // Σ starších bloků (p >= 1), počítané jednou za blok
+    std::vector<float> accumIm_;
+    std::vector<float> spectrumRe_;     // accum + aktuální blok × H[0]
+    std::vector<float> spectrumIm_;
+
+    std::vector<float> fftBuffer_;      // Časová doména 2B
+    std::vector<float> inputBlock_;     // Rozpracovaný blok vstupu (B)
+    std::vector<float> overlap_;        // Druhá polovina IFFT předchozího bloku (B)
+};
@@ -0,0 +1,146 @@
+/**
+ * @file real_fft.cpp
+ * @brief Implementace reálné FFT
+ */
+
+#include "real_fft.h"
+#include <cmath>
+
+void RealFft::init(int size)
+{
+    size_ = size;
+    half_ = size / 2;
+
+    const double pi = 3.14159265358979323846;
+
+    // Bit-reverse permutace pro komplexní FFT délky half_
+    int bits = 0;
+    while ((1 << bits) < half_) {
+        ++bits;
+    }
+    bitReverse_.assign(static_cast<size_t>(half_), 0);
+    for (int i = 0; i < half_; ++i) {
+        int reversed = 0;
+        for (int b = 0; b < bits; ++b) {
+            reversed |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        bitReverse_[static_cast<size_t>(i)] = reversed;
+    }
+
+    twiddleCos_.resize(static_cast<size_t>(half_ / 2));
+    twiddleSin_.resize(static_cast<size_t>(half_ / 2));
+    for (int k = 0; k < half_ / 2; ++k) {
+        const double phase = 2.0 * pi * k / half_;
+        twiddleCos_[static_cast<size_t>(k)] = static_cast<float>(std::cos(phase));
+        twiddleSin_[static_cast<size_t>(k)] = static_cast<float>(std::sin(phase));
+    }
+
+    splitCos_.resize(static_cast<size_t>(half_ + 1));
+    splitSin_.resize(static_cast<size_t>(half_ + 1));
+    for (int k = 0; k <= half_; ++k) {
+        const double phase = 2.0 * pi * k / size_;
+        splitCos_[static_cast<size_t>(k)] = static_cast<float>(std::cos(phase));
+        splitSin_[static_cast<size_t>(k)] = static_cast<float>(std::sin(phase));
+    }
+
+    workRe_.assign(static_cast<size_t>(half_), 0.0f);
+    workIm_.assign(static_cast<size_t>(half_), 0.0f);
+}
+
+void RealFft::forward(const float* input, float* re, float* im) noexcept
+{
+    // Sudé vzorky → reálná, liché → imaginární složka (rovnou v bit-reverse pořadí)
+    for (int n = 0; n < half_; ++n) {
+        const size_t target = static_cast<size_t>(bitReverse_[static_cast<size_t>(n)]);
+        workRe_[target] = input[2 * n];
+        workIm_[target] = input[2 * n + 1];
+    }
+
+    transform(false);
+
+    // Rozdělení: Z[k] = E[k] + i·O[k]  →  X[k] = E[k] + W^k·O[k],  W = e^(-2πi/N)
+    for (int k = 0; k <= half_; ++k) {
+        const int kz = (k == half_) ? 0 : k;
+        const int mz = (k == 0) ? 0 : half_ - k;
+
+        const float ar = workRe_[static_cast<size_t>(kz)];
+        const float ai = workIm_[static_cast<size_t>(kz)];
+        const float br = workRe_[static_cast<size_t>(mz)];
+        const float bi = -workIm_[static_cast<size_t>(mz)];
+
+        const float evenRe = 0.5f * (ar + br);
+        const float evenIm = 0.5f * (ai + bi);
+        const float oddRe = 0.5f * (ai - bi);
+        const float oddIm = -0.5f * (ar - br);
+
+        const float wr = splitCos_[static_cast<size_t>(k)];
+        const float wi = -splitSin_[static_cast<size_t>(k)];
+
+        re[k] = evenRe + wr * oddRe - wi * oddIm;
+        im[k] = evenIm + wr * oddIm + wi * oddRe;
+    }
+}
+
+void RealFft::inverse(const float* re, const float* im, float* output) noexcept
+{
+    // Složení: E[k] = X[k] + X*[M-k],  O[k] = (X[k] - X*[M-k])·W^-k,  Z[k] = E[k] + i·O[k]
+    // (faktor 1/2 vynechán - výstup je pak N-násobek inverzní DFT)
+    for (int k = 0; k < half_; ++k) {
+        const float ar = re[k];
+        const float ai = im[k];
+        const float br = re[half_ - k];
+        const float bi = -im[half_ - k];
+
+        const float evenRe = ar + br;
+        const float evenIm = ai + bi;
+        const float diffRe = ar - br;
+        const float diffIm = ai - bi;
+
+        const float wr = splitCos_[static_cast<size_t>(k)];
+        const float wi = splitSin_[static_cast<size_t>(k)];
+        const float oddRe = diffRe * wr - diffIm * wi;
+        const float oddIm = diffRe * wi + diffIm * wr;
+
+        const size_t target = static_cast<size_t>(bitReverse_[static_cast<size_t>(k)]);
+        workRe_[target] = evenRe - oddIm;
+        workIm_[target] = evenIm + oddRe;
+    }
+
+    transform(true);
+
+    for (int n = 0; n < half_; ++n) {
+        output[2 * n] = workRe_[static_cast<size_t>(n)];
+        output[2 * n + 1] = workIm_[static_cast<size_t>(n)];
+    }
+}
+
+void RealFft::transform(bool inverse) noexcept
+{
+    float* re = workRe_.data();
+    float* im = workIm_.data();
+    const float sign = inverse ? 1.0f : -1.0f;
+
+    // Iterativní radix-2 decimation-in-time (vstup je už permutovaný)
+    for (int length = 2; length <= half_; length <<= 1) {
+        const int halfLength = length >> 1;
+        const int step = half_ / length;
+
+        for (int start = 0; start < half_; start += length) {
+            for (int j = 0; j < halfLength; ++j) {
+                const float wr = twiddleCos_[static_cast<size_t>(j * step)];
+                const float wi = sign * twiddleSin_[static_cast<size_t>(j * step)];
+
+                const int a = start + j;
+                const int b = a + halfLength;
+
+                const float vr = re[b] * wr - im[b] * wi;
+                const float vi = re[b] * wi + im[b] * wr;
+
+                re[b] = re[a] - vr;
+                im[b] = im[a] - vi;
+                re[a] += vr;
+                im[a] += vi;
+            }
+        }
+    }
+}
@@ -0,0 +1,81 @@
+/**
+ * @file real_fft.h
+ * @brief Reálná FFT (radix-2) pro blokovou konvoluci
+ *
+ * Reálný signál délky N se transformuje přes komplexní FFT délky N/2
+ * (sudé vzorky = reálná, liché = imaginární složka) a následné rozdělení
+ * spektra. Spektrum má N/2+1 binů v odděleném formátu (re[], im[]), aby
+ * komplexní násobení v konvoluci běželo nad souvislými poli.
+ *
+ * Tabulky (bit-reverse, twiddles) se počítají v init(), forward()/inverse()
+ * jsou bez alokací.
+ *
+ * THREAD SAFETY:
+ * - init() - NE RT-safe (alokace)
+ * - forward(), inverse() - RT-safe; instance má vlastní scratch, proto ji
+ *   smí v jednu chvíli používat jen jedno vlákno
+ */
+
+#pragma once
+
+#include <vector>
+
+/**
+ * @class RealFft
+ * @brief Dopředná a zpětná FFT reálného signálu (velikost = mocnina 2)
+ *
+ * Škálování:
+ * - forward(): nenormalizovaná DFT  X[k] = Σ x[n]·e^(-2πikn/N)
+ * - inverse(): výstup je N-násobek inverzní DFT (normalizaci 1/N si volající
+ *   zapracuje do jednoho z násobených spekter)
+ */
+class RealFft {
+public:
+    RealFft() = default;
+
+    /**
+     * @brief Připraví tabulky pro danou velikost
+     * @param size Velikost transformace (mocnina 2, minimálně 4)
+     * @note NENÍ RT-safe
+     */
+    void init(int size);
+
+    /**
+     * @brief Dopředná transformace
+     * @param input Reálný vstup (size vzorků)
+     * @param re Reálné části spektra (size/2+1 binů)
+     * @param im Imaginární části spektra (size/2+1 binů)
+     * @note RT-safe
+     */
+    void forward(const float* input, float* re, float* im) noexcept;
+
+    /**
+     * @brief Zpětná transformace (výstup škálovaný size)
+     * @param re Reálné části spektra (size/2+1 binů)
+     * @param im Imaginární části spektra (size/2+1 binů)
+     * @param output Reálný výstup (size vzorků)
+     * @note RT-safe
+     */
+    void inverse(const float* re, const float* im, float* output) noexcept;
+
+    int getSize() const noexcept { return size_; }
+    int getBinCount() const noexcept { return half_ + 1; }
+
+private:
+    /**
+     * @brief Komplexní radix-2 FFT délky half_ nad workRe_/workIm_ (vstup v bit-reverse pořadí)
+     */
+    void transform(bool inverse) noexcept;
+
+    int size_ = 0;                      // Délka reálného signálu N
+    int half_ = 0;                      // Délka komplexní FFT N/2
+
+    std::vector<int> bitReverse_;       // Permutace vstupu komplexní FFT
+    std::vector<float> twiddleCos_;     // cos(2πk/half_), k < half_/2
+    std::vector<float> twiddleSin_;     // sin(2πk/half_)
+    std::vector<float> splitCos_;       // cos(2πk/N), k <= half_ (rozdělení spektra)
+    std::vector<float> splitSin_;       // sin(2πk/N)
+
+    std::vector<float> workRe_;         // Scratch komplexní FFT
+    std::vector<float> workIm_;
+};
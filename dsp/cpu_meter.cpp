@@ -0,0 +1,31 @@
+/**
+ * @file cpu_meter.cpp
+ * @brief Kalibrace cycle counteru pro CpuMeter
+ */
+
+#include "cpu_meter.h"
+#include <thread>
+
+double CpuMeter::getTicksPerSecond()
+{
+    // Thread-safe jednorázová inicializace (magic static)
+    static const double ticksPerSecond = [] {
+#if defined(CPU_METER_CNTVCT)
+        uint64_t frequency;
+        __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(frequency));
+        return static_cast<double>(frequency);
+#elif defined(CPU_METER_RDTSC)
+        // TSC proti steady_clock přes krátký interval
+        const auto clockStart = std::chrono::steady_clock::now();
+        const uint64_t tickStart = now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        const uint64_t tickEnd = now();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - clockStart;
+        return static_cast<double>(tickEnd - tickStart) / elapsed.count();
+#else
+        return 1.0e9;
+#endif
+    }();
+
+    return ticksPerSecond;
+}
@@ -0,0 +1,182 @@
+/**
+ * @file cpu_meter.h
+ * @brief Měření CPU času DSP efektů (cycle counter + lock-free snapshot)
+ *
+ * CpuMeter sbírá čas jednotlivých volání (v tiknutích cycle counteru) na
+ * audio threadu a po každém okně CPU_METER_WINDOW_CALLS volání publikuje
+ * min/avg/max okna. Monitor/GUI thread čte poslední publikované okno
+ * bez zámku (seqlock - při souběžném zápisu čtení zopakuje).
+ *
+ * Cycle counter:
+ * - x86/x64: RDTSC (invariant TSC, nezávislý na frekvenci jádra)
+ * - AArch64: CNTVCT_EL0 (generic timer)
+ * - jinde: std::chrono::steady_clock v ns
+ * Převod na čas: getTicksPerSecond() (jednorázová kalibrace, NE RT-safe).
+ *
+ * THREAD SAFETY:
+ * - addSample(), reset() - RT-safe, pouze audio thread (jeden zapisovatel)
+ * - getSnapshot() - RT-safe, lock-free, libovolný thread
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define CPU_METER_RDTSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CPU_METER_RDTSC 1
+#elif defined(__aarch64__)
+#define CPU_METER_CNTVCT 1
+#endif
+
+// Počet měřených volání v jednom publikovaném okně
+#ifndef CPU_METER_WINDOW_CALLS
+#define CPU_METER_WINDOW_CALLS 256
+#endif
+
+/**
+ * @struct CpuMeterSnapshot
+ * @brief Statistika posledního dokončeného okna (v tiknutích cycle counteru)
+ */
+struct CpuMeterSnapshot {
+    uint64_t minTicks = 0;      // Nejrychlejší volání okna
+    uint64_t avgTicks = 0;      // Průměr okna
+    uint64_t maxTicks = 0;      // Nejpomalejší volání okna
+    uint64_t windows = 0;       // Počet publikovaných oken (0 = zatím žádná data)
+};
+
+/**
+ * @class CpuMeter
+ * @brief Rolling min/avg/max CPU času jednoho zdroje zátěže (efekt, render hlasů)
+ *
+ * Použití (audio thread):
+ * @code
+ * const uint64_t start = CpuMeter::now();
+ * effect.process(left, right, numSamples);
+ * meter.addSample(CpuMeter::now() - start);
+ * @endcode
+ */
+class CpuMeter {
+public:
+    CpuMeter() = default;
+
+    /**
+     * @brief Aktuální hodnota cycle counteru
+     * @note RT-safe, jednotky viz getTicksPerSecond()
+     */
+    static uint64_t now() noexcept {
+#if defined(CPU_METER_RDTSC)
+        return __rdtsc();
+#elif defined(CPU_METER_CNTVCT)
+        uint64_t value;
+        __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(value));
+        return value;
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    /**
+     * @brief Frekvence cycle counteru (tiků za sekundu)
+     * @note NENÍ RT-safe - první volání kalibruje (~20 ms), poté vrací uloženou hodnotu
+     */
+    static double getTicksPerSecond();
+
+    /**
+     * @brief Převede tiky na mikrosekundy
+     * @note NENÍ RT-safe při prvním volání (viz getTicksPerSecond())
+     */
+    static double ticksToMicroseconds(uint64_t ticks) {
+        return static_cast<double>(ticks) * 1.0e6 / getTicksPerSecond();
+    }
+
+    /**
+     * @brief Zaznamená jedno měřené volání, po plném okně publikuje snapshot
+     * @param ticks Doba volání v tiknutích
+     * @note RT-safe, pouze audio thread
+     */
+    void addSample(uint64_t ticks) noexcept {
+        if (ticks < windowMin_) windowMin_ = ticks;
+        if (ticks > windowMax_) windowMax_ = ticks;
+        windowSum_ += ticks;
+
+        if (++windowCalls_ >= CPU_METER_WINDOW_CALLS) {
+            publish();
+        }
+    }
+
+    /**
+     * @brief Zahodí rozpracované okno (publikovaný snapshot zůstává)
+     * @note RT-safe, pouze audio thread
+     */
+    void reset() noexcept {
+        windowMin_ = UINT64_MAX;
+        windowMax_ = 0;
+        windowSum_ = 0;
+        windowCalls_ = 0;
+    }
+
+    /**
+     * @brief Poslední publikované okno
+     * @note RT-safe, lock-free, libovolný thread
+     */
+    CpuMeterSnapshot getSnapshot() const noexcept {
+        CpuMeterSnapshot snapshot;
+        uint32_t before;
+        uint32_t after;
+
+        do {
+            before = sequence_.load(std::memory_order_acquire);
+            snapshot.minTicks = publishedMin_.load(std::memory_order_relaxed);
+            snapshot.avgTicks = publishedAvg_.load(std::memory_order_relaxed);
+            snapshot.maxTicks = publishedMax_.load(std::memory_order_relaxed);
+            snapshot.windows = publishedWindows_.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = sequence_.load(std::memory_order_relaxed);
+        } while ((before & 1u) != 0 || before != after);
+
+        return snapshot;
+    }
+
+private:
+    /**
+     * @brief Seqlock zápis okna (lichá sekvence = zápis probíhá)
+     */
+    void publish() noexcept {
+        const uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        publishedMin_.store(windowMin_, std::memory_order_relaxed);
+        publishedAvg_.store(windowSum_ / windowCalls_, std::memory_order_relaxed);
+        publishedMax_.store(windowMax_, std::memory_order_relaxed);
+        publishedWindows_.store(publishedWindows_.load(std::memory_order_relaxed) + 1,
+                                std::memory_order_relaxed);
+
+        sequence_.store(sequence + 2, std::memory_order_release);
+        reset();
+    }
+
+    // Rozpracované okno (pouze audio thread)
+    uint64_t windowMin_ = UINT64_MAX;
+    uint64_t windowMax_ = 0;
+    uint64_t windowSum_ = 0;
+    uint32_t windowCalls_ = 0;
+
+    // Publikované okno (seqlock)
+    std::atomic<uint32_t> sequence_{0};
+    std::atomic<uint64_t> publishedMin_{0};
+    std::atomic<uint64_t> publishedAvg_{0};
+    std::atomic<uint64_t> publishedMax_{0};
+    std::atomic<uint64_t> publishedWindows_{0};
+
+    // Non-copyable
+    CpuMeter(const CpuMeter&) = delete;
+    CpuMeter& operator=(const CpuMeter&) = delete;
+};
@@ -4,15 +4,23 @@
  */
 
 #include "dsp_chain.h"
+#include <algorithm>
 
 DspChain::DspChain()
-    : isPrepared_(false)
+    : activeGraph_(nullptr),
+      graphInUse_(nullptr),
+      currentGraph_(std::make_unique<Graph>()),
+      isPrepared_(false),
+      profilingEnabled_(false),
+      sampleRate_(0),
+      maxBlockSize_(0)
 {
+    activeGraph_.store(currentGraph_.get(), std::memory_order_release);
 }
 
 DspChain::~DspChain()
 {
-    // Unique pointers jsou automaticky uvolněny
+    // Grafy (a přes shared_ptr i efekty) jsou automaticky uvolněny
 }
 
 // ============================================================================
@@ -21,24 +29,28 @@ DspChain::~DspChain()
 
 void DspChain::prepare(int sampleRate, int maxBlockSize)
 {
+    std::lock_guard<std::mutex> lock(controlMutex_);
+
+    sampleRate_ = sampleRate;
+    maxBlockSize_ = maxBlockSize;
+
     // Připrav všechny efekty
-    for (auto& effect : effects_) {
-        if (effect) {
-            effect->prepare(sampleRate, maxBlockSize);
-        }
+    for (auto& slot : currentGraph_->slots) {
+        slot.effect->prepare(sampleRate, maxBlockSize);
     }
 
-    isPrepared_ = true;
+    isPrepared_.store(true, std::memory_order_release);
 }
 
 void DspChain::reset() noexcept
 {
     // Resetuj všechny efekty
-    for (auto& effect : effects_) {
-        if (effect) {
-            effect->reset();
-        }
+    const Graph* graph = acquireGraph();
+    for (const auto& slot : graph->slots) {
+        slot.effect->reset();
+        slot.meter->reset();
     }
+    releaseGraph();
 }
 
 // ============================================================================
@@ -47,16 +59,68 @@ void DspChain::reset() noexcept
 
 void DspChain::process(float* leftBuffer, float* rightBuffer, int numSamples) noexcept
 {
-    if (!isPrepared_) {
+    if (!isPrepared_.load(std::memory_order_acquire)) {
         return;  // Safety: neprocesuj pokud není prepared
     }
 
     // Zpracuj všechny efekty sériově
-    for (auto& effect : effects_) {
-        if (effect && effect->isEnabled()) {
-            effect->process(leftBuffer, rightBuffer, numSamples);
+    const Graph* graph = acquireGraph();
+    if (profilingEnabled_.load(std::memory_order_relaxed)) {
+        for (const auto& slot : graph->slots) {
+            if (slot.effect->isEnabled()) {
+                const uint64_t start = CpuMeter::now();
+                slot.effect->process(leftBuffer, rightBuffer, numSamples);
+                slot.meter->addSample(CpuMeter::now() - start);
+            }
+        }
+    } else {
+        for (const auto& slot : graph->slots) {
+            if (slot.effect->isEnabled()) {
+                slot.effect->process(leftBuffer, rightBuffer, numSamples);
+            }
+        }
+    }
+    releaseGraph();
+}
+
+bool DspChain::isTailSilent() const noexcept
+{
+    bool silent = true;
+
+    const Graph* graph = acquireGraph();
+    for (const auto& slot : graph->slots) {
+        if (slot.effect->isEnabled() && !slot.effect->isTailSilent()) {
+            silent = false;
+            break;
         }
     }
+    releaseGraph();
+
+    return silent;
+}
+
+// ============================================================================
+// Audio thread access (hazard pointer)
+// ============================================================================
+
+const DspChain::Graph* DspChain::acquireGraph() const noexcept
+{
+    // Ohlásit graf jako používaný a ověřit, že je stále aktivní - jinak ho
+    // řídicí thread mohl mezitím vyřadit (a pak by ho nesměl uvolnit)
+    const Graph* graph = activeGraph_.load(std::memory_order_seq_cst);
+    for (;;) {
+        graphInUse_.store(graph, std::memory_order_seq_cst);
+        const Graph* current = activeGraph_.load(std::memory_order_seq_cst);
+        if (current == graph) {
+            return graph;
+        }
+        graph = current;
+    }
+}
+
+void DspChain::releaseGraph() const noexcept
+{
+    graphInUse_.store(nullptr, std::memory_order_release);
 }
 
 // ============================================================================
@@ -65,20 +129,138 @@ void DspChain::process(float* leftBuffer, float* rightBuffer, int numSamples) no
 
 void DspChain::addEffect(std::unique_ptr<DspEffect> effect)
 {
-    if (effect) {
-        effects_.push_back(std::move(effect));
+    insertEffect(static_cast<size_t>(-1), std::move(effect));
+}
+
+void DspChain::insertEffect(size_t index, std::unique_ptr<DspEffect> effect)
+{
+    if (!effect) {
+        return;
     }
+
+    std::lock_guard<std::mutex> lock(controlMutex_);
+
+    // Nový efekt se připraví ještě před tím, než ho uvidí audio thread
+    prepareEffect(*effect);
+
+    auto graph = std::make_unique<Graph>(*currentGraph_);
+    const size_t position = std::min(index, graph->slots.size());
+    graph->slots.insert(graph->slots.begin() + static_cast<std::ptrdiff_t>(position),
+                        Slot{ std::shared_ptr<DspEffect>(std::move(effect)), std::make_shared<CpuMeter>() });
+    publishGraph(std::move(graph));
+}
+
+bool DspChain::removeEffect(size_t index)
+{
+    std::lock_guard<std::mutex> lock(controlMutex_);
+
+    if (index >= currentGraph_->slots.size()) {
+        return false;
+    }
+
+    auto graph = std::make_unique<Graph>(*currentGraph_);
+    graph->slots.erase(graph->slots.begin() + static_cast<std::ptrdiff_t>(index));
+    publishGraph(std::move(graph));
+    return true;
+}
+
+bool DspChain::moveEffect(size_t fromIndex, size_t toIndex)
+{
+    std::lock_guard<std::mutex> lock(controlMutex_);
+
+    const size_t count = currentGraph_->slots.size();
+    if (fromIndex >= count || toIndex >= count) {
+        return false;
+    }
+    if (fromIndex == toIndex) {
+        return true;
+    }
+
+    auto graph = std::make_unique<Graph>(*currentGraph_);
+    auto moved = std::move(graph->slots[fromIndex]);
+    graph->slots.erase(graph->slots.begin() + static_cast<std::ptrdiff_t>(fromIndex));
+    graph->slots.insert(graph->slots.begin() + static_cast<std::ptrdiff_t>(toIndex), std::move(moved));
+    publishGraph(std::move(graph));
+    return true;
+}
+
+void DspChain::reclaimRetired()
+{
+    std::lock_guard<std::mutex> lock(controlMutex_);
+    reclaimRetiredLocked();
 }
 
 DspEffect* DspChain::getEffect(size_t index) const
 {
-    if (index < effects_.size()) {
-        return effects_[index].get();
+    std::lock_guard<std::mutex> lock(controlMutex_);
+
+    if (index < currentGraph_->slots.size()) {
+        return currentGraph_->slots[index].effect.get();
+    }
+    return nullptr;
+}
+
+size_t DspChain::getEffectCount() const
+{
+    std::lock_guard<std::mutex> lock(controlMutex_);
+    return currentGraph_->slots.size();
+}
+
+// ============================================================================
+// CPU Profiling
+// ============================================================================
+
+void DspChain::setProfilingEnabled(bool enabled) noexcept
+{
+    profilingEnabled_.store(enabled, std::memory_order_relaxed);
+}
+
+bool DspChain::isProfilingEnabled() const noexcept
+{
+    return profilingEnabled_.load(std::memory_order_relaxed);
+}
+
+std::shared_ptr<const CpuMeter> DspChain::getEffectCpuMeter(size_t index) const
+{
+    std::lock_guard<std::mutex> lock(controlMutex_);
+
+    if (index < currentGraph_->slots.size()) {
+        return currentGraph_->slots[index].meter;
     }
     return nullptr;
 }
 
-size_t DspChain::getEffectCount() const noexcept
+// ============================================================================
+// Control thread helpers (pod controlMutex_)
+// ============================================================================
+
+void DspChain::publishGraph(std::unique_ptr<Graph> graph)
 {
-    return effects_.size();
+    // Atomická výměna - audio thread vezme nový graf od dalšího bloku
+    activeGraph_.store(graph.get(), std::memory_order_seq_cst);
+
+    retired_.push_back(std::move(currentGraph_));
+    currentGraph_ = std::move(graph);
+
+    reclaimRetiredLocked();
+}
+
+void DspChain::prepareEffect(DspEffect& effect) const
+{
+    if (isPrepared_.load(std::memory_order_acquire)) {
+        effect.prepare(sampleRate_, maxBlockSize_);
+    }
+}
+
+void DspChain::reclaimRetiredLocked()
+{
+    // Vyřazený graf už nelze nově získat (acquireGraph ověřuje activeGraph_),
+    // stačí počkat, až ho audio thread přestane používat
+    const Graph* inUse = graphInUse_.load(std::memory_order_seq_cst);
+
+    retired_.erase(std::remove_if(retired_.begin(), retired_.end(),
+                                  [inUse](const std::unique_ptr<Graph>& graph) {
+                                      return graph.get() != inUse;
+                                  }),
+                   retired_.end());
 }
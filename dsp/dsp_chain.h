@@ -5,17 +5,38 @@
  * DspChain drží kolekci DSP efektů a zpracovává je sériově
  * (jeden po druhém) v pořadí, ve kterém byly přidány.
  *
+ * Konfigurace za běhu (bez restartu audia, bez zámku v audio threadu):
+ * - audio thread čte neměnný graf efektů (pole ukazatelů) přes atomický ukazatel
+ * - změna (add/insert/remove/move) postaví nový graf mimo audio thread,
+ *   nový efekt připraví (prepare()) a graf publikuje atomickou výměnou
+ * - starý graf se uvolní až mimo audio thread, jakmile ho audio thread
+ *   prokazatelně nepoužívá (hazard pointer graphInUse_)
+ * - efekty sdílené starým i novým grafem si drží stav (shared_ptr,
+ *   refcount se mění jen v řídicím threadu)
+ *
+ * Měření CPU (volitelné, setProfilingEnabled()):
+ * - process() změří každý zapnutý efekt cycle counterem (CpuMeter)
+ * - měřič patří efektu (putuje s ním při move/insert), GUI/monitor thread
+ *   ho získá přes getEffectCpuMeter() a čte min/avg/max bez zámku
+ * - vypnuté měření stojí jedno atomické čtení na blok
+ *
  * THREAD SAFETY:
- * - addEffect() - NE RT-safe (volat pouze při inicializaci)
- * - prepare(), reset(), process() - RT-safe
- * - getEffect(), getEffectCount() - RT-safe (read-only)
+ * - addEffect(), insertEffect(), removeEffect(), moveEffect(), reclaimRetired()
+ *   - NE RT-safe, libovolný řídicí thread i za běhu audia (serializováno mutexem)
+ * - prepare() - NE RT-safe (volat před začátkem audio processingu)
+ * - reset(), process(), isTailSilent() - RT-safe, pouze audio thread
+ * - getEffect(), getEffectCount(), getEffectCpuMeter() - NE RT-safe (řídicí thread)
+ * - setProfilingEnabled() - RT-safe, libovolný thread
  */
 
 #pragma once
 
 #include "dsp_effect.h"
+#include "cpu_meter.h"
+#include <atomic>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <cstddef>
 
 /**
@@ -24,7 +45,7 @@
  *
  * Použití:
  * 1. Vytvoř chain
- * 2. Přidej efekty pomocí addEffect() (při inicializaci)
+ * 2. Přidej efekty pomocí addEffect() (při inicializaci i za běhu)
  * 3. Zavolej prepare() s audio parametry
  * 4. Volej process() z audio threadu
  *
@@ -39,7 +60,7 @@ public:
     DspChain();
 
     /**
-     * @brief Destruktor
+     * @brief Destruktor (audio thread už chain nesmí používat)
      */
     ~DspChain();
 
@@ -53,6 +74,8 @@ public:
      * @param maxBlockSize Maximální velikost audio bloku
      *
      * @note NENÍ RT-safe - volat před začátkem audio processingu
+     * @note Parametry si chain pamatuje - efekty přidané později se
+     *       připraví stejně ještě před publikací
      */
     void prepare(int sampleRate, int maxBlockSize);
 
@@ -76,28 +99,78 @@ public:
      * @note RT-safe - volat z audio threadu
      * @note Efekty jsou aplikovány sériově v pořadí přidání
      * @note Pokud efekt je disabled, přeskočí se
+     * @note Změna grafu během bloku se projeví od dalšího bloku
      */
     void process(float* leftBuffer, float* rightBuffer, int numSamples) noexcept;
 
+    /**
+     * @brief Zjistí, zda všechny zapnuté efekty dozněly
+     * @return true pokud lze tichý blok přeskočit bez změny výstupu i stavu
+     *
+     * @note RT-safe - volat z audio threadu
+     * @note Vypnuté efekty se nezpracovávají, proto se nepočítají
+     */
+    bool isTailSilent() const noexcept;
+
     // ========================================================================
-    // Effect Management
+    // Effect Management (řídicí thread, i za běhu audia)
     // ========================================================================
 
     /**
-     * @brief Přidá efekt do chainu
+     * @brief Přidá efekt na konec chainu
      * @param effect Unique pointer na efekt (převezme ownership)
      *
-     * @note NENÍ RT-safe - volat pouze při inicializaci
-     * @note Efekt je přidán na konec chainu
+     * @note NENÍ RT-safe - řídicí thread; audio thread nový graf převezme
+     *       od dalšího bloku (efekt je už připravený, pokud proběhl prepare())
      */
     void addEffect(std::unique_ptr<DspEffect> effect);
 
+    /**
+     * @brief Vloží efekt na danou pozici
+     * @param index Pozice (0 = první, >= počet = na konec)
+     * @param effect Unique pointer na efekt (převezme ownership)
+     *
+     * @note NENÍ RT-safe - řídicí thread
+     */
+    void insertEffect(size_t index, std::unique_ptr<DspEffect> effect);
+
+    /**
+     * @brief Odebere efekt z chainu
+     * @param index Index efektu
+     * @return true pokud efekt existoval
+     *
+     * @note NENÍ RT-safe - řídicí thread; efekt se zničí až mimo audio
+     *       thread, jakmile ho audio thread přestane používat
+     */
+    bool removeEffect(size_t index);
+
+    /**
+     * @brief Přesune efekt na jinou pozici (změna pořadí zpracování)
+     * @param fromIndex Současná pozice
+     * @param toIndex Nová pozice
+     * @return true pokud jsou oba indexy platné
+     *
+     * @note NENÍ RT-safe - řídicí thread; stav efektu zůstává zachován
+     */
+    bool moveEffect(size_t fromIndex, size_t toIndex);
+
+    /**
+     * @brief Uvolní vyřazené grafy, které už audio thread nepoužívá
+     *
+     * Volá se automaticky při každé změně; graf, se kterým audio thread
+     * právě pracuje, počká na další volání (např. z timeru GUI).
+     *
+     * @note NENÍ RT-safe - řídicí thread
+     */
+    void reclaimRetired();
+
     /**
      * @brief Získá pointer na efekt podle indexu
      * @param index Index efektu (0 = první)
      * @return Pointer na efekt nebo nullptr pokud index je mimo rozsah
      *
-     * @note RT-safe (read-only)
+     * @note NENÍ RT-safe - řídicí thread
+     * @note Pointer platí, dokud efekt zůstává v chainu
      * @note Použij pro přístup k setterům/getterům specifického efektu
      */
     DspEffect* getEffect(size_t index) const;
@@ -106,13 +179,75 @@ public:
      * @brief Vrací počet efektů v chainu
      * @return Počet efektů
      *
-     * @note RT-safe (read-only)
+     * @note NENÍ RT-safe - řídicí thread
      */
-    size_t getEffectCount() const noexcept;
+    size_t getEffectCount() const;
+
+    // ========================================================================
+    // CPU Profiling
+    // ========================================================================
+
+    /**
+     * @brief Zapne/vypne měření CPU času jednotlivých efektů
+     * @param enabled true = process() měří každý zapnutý efekt
+     *
+     * @note RT-safe - libovolný thread, projeví se od dalšího bloku
+     */
+    void setProfilingEnabled(bool enabled) noexcept;
+
+    /**
+     * @brief Zjistí, zda je měření CPU zapnuté
+     * @note RT-safe
+     */
+    bool isProfilingEnabled() const noexcept;
+
+    /**
+     * @brief Měřič CPU času efektu podle indexu
+     * @param index Index efektu (0 = první)
+     * @return Měřič nebo nullptr pokud index je mimo rozsah
+     *
+     * @note NENÍ RT-safe - řídicí thread; vrácený měřič lze pak číst
+     *       (getSnapshot()) z libovolného threadu bez zámku, i po odebrání efektu
+     * @note Hodnoty jsou na jedno volání process() - VoiceManager volá chain
+     *       po sub-blocích ITHACA_INTERNAL_BLOCK_SIZE
+     */
+    std::shared_ptr<const CpuMeter> getEffectCpuMeter(size_t index) const;
 
 private:
-    std::vector<std::unique_ptr<DspEffect>> effects_;  // Kolekce efektů
-    bool isPrepared_;                                   // Příznak prepare() volání
+    /**
+     * @brief Efekt v grafu s vlastním měřičem CPU
+     */
+    struct Slot {
+        std::shared_ptr<DspEffect> effect;
+        std::shared_ptr<CpuMeter> meter;
+    };
+
+    /**
+     * @brief Neměnný snímek chainu - audio thread ho jen čte
+     */
+    struct Graph {
+        std::vector<Slot> slots;
+    };
+
+    // ===== AUDIO THREAD ACCESS (hazard pointer) =====
+    const Graph* acquireGraph() const noexcept;
+    void releaseGraph() const noexcept;
+
+    // ===== CONTROL THREAD (pod controlMutex_) =====
+    void publishGraph(std::unique_ptr<Graph> graph);
+    void prepareEffect(DspEffect& effect) const;
+    void reclaimRetiredLocked();
+
+    std::atomic<const Graph*> activeGraph_;             // Graf pro audio thread (vlastní ho currentGraph_)
+    mutable std::atomic<const Graph*> graphInUse_;      // Graf, se kterým audio thread právě pracuje
+    std::unique_ptr<Graph> currentGraph_;               // Vlastník publikovaného grafu
+    std::vector<std::unique_ptr<Graph>> retired_;       // Vyřazené grafy čekající na uvolnění
+
+    mutable std::mutex controlMutex_;                   // Serializuje řídicí thready (nikdy audio thread)
+    std::atomic<bool> isPrepared_;                      // Příznak prepare() volání
+    std::atomic<bool> profilingEnabled_;                // Měření CPU v process()
+    int sampleRate_;                                    // Parametry z prepare() pro nové efekty
+    int maxBlockSize_;
 
     // Non-copyable
     DspChain(const DspChain&) = delete;
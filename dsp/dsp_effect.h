@@ -86,6 +86,16 @@ public:
      */
     virtual bool isEnabled() const noexcept = 0;
 
+    /**
+     * @brief Zjistí, zda dozněl vnitřní stav efektu (tail)
+     * @return true pokud by process() nad nulovým vstupem vrátil nuly a stav
+     *         efektu by se už nezměnil - tichý blok lze přeskočit
+     *
+     * @note RT-safe - volá se z audio threadu mezi bloky
+     * @note Výchozí implementace je konzervativní (efekt se zpracuje vždy)
+     */
+    virtual bool isTailSilent() const noexcept { return false; }
+
     // ========================================================================
     // Info
     // ========================================================================
@@ -4,9 +4,75 @@
  */
 
 #include "limiter.h"
+#include "common/simd_dispatch.h"
 #include <cmath>
 #include <algorithm>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LIMITER_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define LIMITER_NEON 1
+#endif
+
+namespace {
+
+// Počet samplů, pro které se cílové gainy počítají najednou (scratch na stacku)
+constexpr int GAIN_CHUNK = 64;
+
+/**
+ * @brief Cílové gainy: peak > threshold ? threshold / peak : 1.0
+ *
+ * SIMD varianta místo dělení používá rychlou převrácenou hodnotu
+ * zpřesněnou Newton-Raphsonem r' = r * (2 - peak * r): SSE2 rcp (~12 bitů)
+ * + 1 krok, NEON vrecpe (~8 bitů) + 2 kroky → relativní chyba < 1e-6.
+ *
+ * Chyba může gain i nadhodnotit: výstupní peak pak přesáhne threshold
+ * relativně o ~1e-7 (jednotky ulp, měřeno 1.2e-7 → < -130 dB pod
+ * thresholdem, neslyšitelné). Skalární dělení má stejný řád (0.5 ulp
+ * gainu + zaokrouhlení násobení). Mez hlídá runLimiterFastPathTest.
+ */
+void computeTargetGains(const float* left, const float* right, int numSamples,
+                        float threshold, float* targetGains) noexcept
+{
+    int i = 0;
+
+#if defined(LIMITER_SSE2)
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 threshold4 = _mm_set1_ps(threshold);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    for (; i + 4 <= numSamples; i += 4) {
+        const __m128 peak = _mm_max_ps(_mm_and_ps(_mm_loadu_ps(left + i), absMask),
+                                       _mm_and_ps(_mm_loadu_ps(right + i), absMask));
+        __m128 reciprocal = _mm_rcp_ps(peak);
+        reciprocal = _mm_mul_ps(reciprocal, _mm_sub_ps(two, _mm_mul_ps(peak, reciprocal)));
+        const __m128 limited = _mm_mul_ps(threshold4, reciprocal);
+        const __m128 over = _mm_cmpgt_ps(peak, threshold4);
+        _mm_storeu_ps(targetGains + i, _mm_or_ps(_mm_and_ps(over, limited), _mm_andnot_ps(over, one)));
+    }
+#elif defined(LIMITER_NEON)
+    const float32x4_t threshold4 = vdupq_n_f32(threshold);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    for (; i + 4 <= numSamples; i += 4) {
+        const float32x4_t peak = vmaxq_f32(vabsq_f32(vld1q_f32(left + i)), vabsq_f32(vld1q_f32(right + i)));
+        float32x4_t reciprocal = vrecpeq_f32(peak);
+        reciprocal = vmulq_f32(reciprocal, vrecpsq_f32(peak, reciprocal));
+        reciprocal = vmulq_f32(reciprocal, vrecpsq_f32(peak, reciprocal));
+        const float32x4_t limited = vmulq_f32(threshold4, reciprocal);
+        vst1q_f32(targetGains + i, vbslq_f32(vcgtq_f32(peak, threshold4), limited, one));
+    }
+#endif
+
+    for (; i < numSamples; ++i) {
+        const float peak = std::max(std::abs(left[i]), std::abs(right[i]));
+        targetGains[i] = (peak > threshold) ? threshold / peak : 1.0f;
+    }
+}
+
+} // namespace
+
 // ============================================================================
 // Constructor
 // ============================================================================
@@ -54,31 +120,52 @@ void Limiter::process(float* leftBuffer, float* rightBuffer, int numSamples) noe
     const float threshold = thresholdLinear_.load(std::memory_order_relaxed);
     const float releaseCoeff = releaseCoeff_.load(std::memory_order_relaxed);
 
-    // Process each sample (attack is instant, no coefficient needed)
-    for (int i = 0; i < numSamples; ++i) {
-        // Find peak of stereo signal
-        const float leftAbs = std::abs(leftBuffer[i]);
-        const float rightAbs = std::abs(rightBuffer[i]);
-        const float peak = std::max(leftAbs, rightAbs);
-
-        // Calculate target gain
-        float targetGain = 1.0f;
-        if (peak > threshold) {
-            targetGain = threshold / peak;  // Reduce gain to keep at threshold
+    // ------------------------------------------------------------------------
+    // FAST PATH: celý blok pod thresholdem a envelope dojel (release se nehne)
+    // ------------------------------------------------------------------------
+    // targetGain je pro každý sample 1.0 a envelope_ zůstává beze změny -
+    // výstup = vstup × envelope_ (1.0 → bez zápisu), stejně jako per-sample smyčka
+
+    const bool envelopeSettled = (1.0f + releaseCoeff * (envelope_ - 1.0f) == envelope_);
+    if (envelopeSettled && SimdDispatch::kernels().peakAbs(leftBuffer, rightBuffer, numSamples) <= threshold) {
+        if (envelope_ != 1.0f) {
+            const SimdDispatch::Kernels& simd = SimdDispatch::kernels();
+            simd.applyGain(leftBuffer, numSamples, envelope_);
+            simd.applyGain(rightBuffer, numSamples, envelope_);
         }
+        return;
+    }
 
-        // Smooth envelope follower
-        if (targetGain < envelope_) {
-            // Attack (instant)
-            envelope_ = targetGain;
-        } else {
-            // Release (smooth)
-            envelope_ = targetGain + releaseCoeff * (envelope_ - targetGain);
-        }
+    // ------------------------------------------------------------------------
+    // LIMITING: cílové gainy vektorově, envelope follower sériově
+    // ------------------------------------------------------------------------
+
+    float targetGains[GAIN_CHUNK];
+
+    for (int offset = 0; offset < numSamples; offset += GAIN_CHUNK) {
+        const int chunk = std::min(GAIN_CHUNK, numSamples - offset);
+        float* left = leftBuffer + offset;
+        float* right = rightBuffer + offset;
+
+        // Target gain (threshold / peak nad thresholdem, jinak 1.0)
+        computeTargetGains(left, right, chunk, threshold, targetGains);
+
+        // Smooth envelope follower (attack is instant, no coefficient needed)
+        for (int i = 0; i < chunk; ++i) {
+            const float targetGain = targetGains[i];
 
-        // Apply gain reduction
-        leftBuffer[i] *= envelope_;
-        rightBuffer[i] *= envelope_;
+            if (targetGain < envelope_) {
+                // Attack (instant)
+                envelope_ = targetGain;
+            } else {
+                // Release (smooth)
+                envelope_ = targetGain + releaseCoeff * (envelope_ - targetGain);
+            }
+
+            // Apply gain reduction
+            left[i] *= envelope_;
+            right[i] *= envelope_;
+        }
     }
 }
 
@@ -92,6 +179,15 @@ bool Limiter::isEnabled() const noexcept
     return enabled_.load(std::memory_order_relaxed);
 }
 
+bool Limiter::isTailSilent() const noexcept
+{
+    // Nulový vstup dá nulový výstup vždy; stav se nemění, jakmile další krok
+    // release (targetGain = 1.0) envelope_ nezmění - dojel do 1.0 nebo uvízl
+    // na zaokrouhlení těsně pod ní
+    const float releaseCoeff = releaseCoeff_.load(std::memory_order_relaxed);
+    return 1.0f + releaseCoeff * (envelope_ - 1.0f) == envelope_;
+}
+
 // ============================================================================
 // MIDI API Implementation
 // ============================================================================
@@ -16,6 +16,10 @@
  * - Peak detection s envelope follower
  * - Smooth attack (instant) a release (adjustable)
  * - Zero latency (no look-ahead)
+ *
+ * PŘESNOST:
+ * - Threshold platí do zaokrouhlení: SIMD gain (rcp + Newton-Raphson) může
+ *   výstup vyvést nad threshold relativně o ~1e-7 (viz computeTargetGains)
  */
 
 #pragma once
@@ -65,6 +69,7 @@ public:
     void process(float* leftBuffer, float* rightBuffer, int numSamples) noexcept override;
     void setEnabled(bool enabled) noexcept override;
     bool isEnabled() const noexcept override;
+    bool isTailSilent() const noexcept override;
     const char* getName() const noexcept override { return "Limiter"; }
 
     // ========================================================================
@@ -0,0 +1,264 @@
+/**
+ * @file static_dsp_chain.h
+ * @brief Compile-time řetězec DSP efektů bez virtuálního volání
+ *
+ * StaticDspChain<Effects...> drží efekty přímo (std::tuple, žádná alokace)
+ * a zpracovává je sériově v pořadí template argumentů. Typy efektů jsou
+ * známé při kompilaci, volání process()/isEnabled()/isTailSilent() jsou
+ * kvalifikovaná (Effect::process) - bez virtual dispatch, kompilátor je
+ * může inlinovat do jedné smyčky přes řetězec.
+ *
+ * Pro pevnou produkční konfiguraci (BBE → Limiter ve VoiceManageru).
+ * Dynamické konfigurace (efekty přidávané za běhu aplikace) dál používají
+ * DspChain - obě třídy mají stejné rozhraní prepare/reset/process/isTailSilent.
+ *
+ * Měření CPU (volitelné, setProfilingEnabled()) - každý efekt má vlastní
+ * CpuMeter se stejnou sémantikou jako v DspChain.
+ *
+ * THREAD SAFETY:
+ * - prepare() - NE RT-safe (volat před začátkem audio processingu)
+ * - reset(), process(), isTailSilent() - RT-safe
+ * - get<T>() - RT-safe (přístup k setterům efektu)
+ * - setProfilingEnabled(), getCpuMeter() - RT-safe, libovolný thread
+ */
+
+#pragma once
+
+#include "dsp_effect.h"
+#include "cpu_meter.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @class StaticDspChain
+ * @brief Sériové zpracování pevné sady DSP efektů (typy známé při kompilaci)
+ *
+ * Použití:
+ * @code
+ * StaticDspChain<BBEProcessor, Limiter> chain;
+ * chain.prepare(44100, 512);
+ * chain.get<Limiter>().setThresholdMIDI(100);
+ * chain.process(left, right, numSamples);   // BBE → Limiter
+ * chain.getCpuMeter<Limiter>().getSnapshot();
+ * @endcode
+ *
+ * Efekty jsou zpracovány v pořadí template argumentů:
+ * Input → Effects[0] → Effects[1] → ... → Output
+ */
+template <typename... Effects>
+class StaticDspChain {
+    static_assert(sizeof...(Effects) > 0, "StaticDspChain needs at least one effect");
+    static_assert((std::is_base_of<DspEffect, Effects>::value && ...),
+                  "StaticDspChain effects must derive from DspEffect");
+
+public:
+    StaticDspChain() = default;
+
+    // ========================================================================
+    // Lifecycle
+    // ========================================================================
+
+    /**
+     * @brief Připraví všechny efekty pro audio processing
+     * @param sampleRate Sample rate v Hz
+     * @param maxBlockSize Maximální velikost audio bloku
+     *
+     * @note NENÍ RT-safe - volat před začátkem audio processingu
+     */
+    void prepare(int sampleRate, int maxBlockSize) {
+        std::apply([&](auto&... effect) {
+            (prepareEffect(effect, sampleRate, maxBlockSize), ...);
+        }, effects_);
+        isPrepared_ = true;
+    }
+
+    /**
+     * @brief Resetuje všechny efekty
+     *
+     * @note RT-safe - lze volat z audio threadu
+     */
+    void reset() noexcept {
+        std::apply([](auto&... effect) { (resetEffect(effect), ...); }, effects_);
+        for (CpuMeter& meter : meters_) {
+            meter.reset();
+        }
+    }
+
+    // ========================================================================
+    // Processing (RT-safe)
+    // ========================================================================
+
+    /**
+     * @brief Zpracuje audio blok přes všechny efekty (in-place)
+     * @param leftBuffer Levý kanál (bude modifikován)
+     * @param rightBuffer Pravý kanál (bude modifikován)
+     * @param numSamples Počet samplů
+     *
+     * @note RT-safe - volat z audio threadu
+     * @note Vypnutý efekt se přeskočí (stejně jako v DspChain)
+     */
+    void process(float* leftBuffer, float* rightBuffer, int numSamples) noexcept {
+        if (!isPrepared_) {
+            return;  // Safety: neprocesuj pokud není prepared
+        }
+
+        if (profilingEnabled_.load(std::memory_order_relaxed)) {
+            processProfiled(leftBuffer, rightBuffer, numSamples, std::index_sequence_for<Effects...>{});
+            return;
+        }
+
+        std::apply([&](auto&... effect) {
+            (processEffect(effect, leftBuffer, rightBuffer, numSamples), ...);
+        }, effects_);
+    }
+
+    /**
+     * @brief Zjistí, zda všechny zapnuté efekty dozněly
+     * @return true pokud lze tichý blok přeskočit bez změny výstupu i stavu
+     *
+     * @note RT-safe - volat z audio threadu
+     */
+    bool isTailSilent() const noexcept {
+        return std::apply([](const auto&... effect) {
+            return (effectTailSilent(effect) && ...);
+        }, effects_);
+    }
+
+    // ========================================================================
+    // Effect Access
+    // ========================================================================
+
+    /**
+     * @brief Přístup k efektu podle typu (typ musí být v řetězci právě jednou)
+     * @note RT-safe
+     */
+    template <typename Effect>
+    Effect& get() noexcept { return std::get<Effect>(effects_); }
+
+    template <typename Effect>
+    const Effect& get() const noexcept { return std::get<Effect>(effects_); }
+
+    /**
+     * @brief Přístup k efektu podle pozice v řetězci (0 = první)
+     * @note RT-safe
+     */
+    template <size_t Index>
+    auto& get() noexcept { return std::get<Index>(effects_); }
+
+    /**
+     * @brief Vrací počet efektů v řetězci
+     */
+    static constexpr size_t getEffectCount() noexcept { return sizeof...(Effects); }
+
+    // ========================================================================
+    // CPU Profiling
+    // ========================================================================
+
+    /**
+     * @brief Zapne/vypne měření CPU času jednotlivých efektů
+     * @note RT-safe - libovolný thread, projeví se od dalšího bloku
+     */
+    void setProfilingEnabled(bool enabled) noexcept {
+        profilingEnabled_.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool isProfilingEnabled() const noexcept {
+        return profilingEnabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Měřič CPU času efektu podle typu (typ musí být v řetězci právě jednou)
+     * @note RT-safe; getSnapshot() lze volat z libovolného threadu
+     */
+    template <typename Effect>
+    const CpuMeter& getCpuMeter() const noexcept {
+        static_assert(countOf<Effect>() == 1, "Effect type must appear in StaticDspChain exactly once");
+        return meters_[indexOf<Effect>()];
+    }
+
+    /**
+     * @brief Měřič CPU času efektu podle pozice v řetězci (0 = první)
+     * @note RT-safe; pozice ověřená při kompilaci
+     */
+    template <size_t Index>
+    const CpuMeter& getCpuMeter() const noexcept {
+        static_assert(Index < sizeof...(Effects), "StaticDspChain effect index out of range");
+        return meters_[Index];
+    }
+
+    /**
+     * @brief Měřič CPU času efektu podle pozice známé až za běhu (GUI výpis)
+     * @return nullptr pokud index leží mimo řetězec (jako DspChain::getEffectCpuMeter)
+     * @note RT-safe
+     */
+    const CpuMeter* getCpuMeter(size_t index) const noexcept {
+        return index < meters_.size() ? &meters_[index] : nullptr;
+    }
+
+private:
+    template <typename Effect>
+    static constexpr size_t countOf() noexcept {
+        return (static_cast<size_t>(std::is_same<Effect, Effects>::value) + ...);
+    }
+
+    template <typename Effect>
+    static constexpr size_t indexOf() noexcept {
+        constexpr bool matches[] = { std::is_same<Effect, Effects>::value... };
+        size_t index = 0;
+        while (!matches[index]) ++index;
+        return index;
+    }
+
+    template <size_t... Indices>
+    void processProfiled(float* left, float* right, int numSamples, std::index_sequence<Indices...>) noexcept {
+        (processEffectProfiled(std::get<Indices>(effects_), meters_[Indices], left, right, numSamples), ...);
+    }
+
+    // Kvalifikovaná volání (Effect::...) obcházejí vtable - typ je známý
+
+    template <typename Effect>
+    static void prepareEffect(Effect& effect, int sampleRate, int maxBlockSize) {
+        effect.Effect::prepare(sampleRate, maxBlockSize);
+    }
+
+    template <typename Effect>
+    static void resetEffect(Effect& effect) noexcept {
+        effect.Effect::reset();
+    }
+
+    template <typename Effect>
+    static void processEffect(Effect& effect, float* left, float* right, int numSamples) noexcept {
+        if (effect.Effect::isEnabled()) {
+            effect.Effect::process(left, right, numSamples);
+        }
+    }
+
+    template <typename Effect>
+    static void processEffectProfiled(Effect& effect, CpuMeter& meter,
+                                      float* left, float* right, int numSamples) noexcept {
+        if (effect.Effect::isEnabled()) {
+            const uint64_t start = CpuMeter::now();
+            effect.Effect::process(left, right, numSamples);
+            meter.addSample(CpuMeter::now() - start);
+        }
+    }
+
+    template <typename Effect>
+    static bool effectTailSilent(const Effect& effect) noexcept {
+        return !effect.Effect::isEnabled() || effect.Effect::isTailSilent();
+    }
+
+    std::tuple<Effects...> effects_;   // Efekty uložené přímo (bez heap alokace)
+    bool isPrepared_{false};           // Příznak prepare() volání
+
+    std::array<CpuMeter, sizeof...(Effects)> meters_;   // CPU čas efektů (pořadí = template argumenty)
+    std::atomic<bool> profilingEnabled_{false};         // Měření CPU v process()
+
+    // Non-copyable
+    StaticDspChain(const StaticDspChain&) = delete;
+    StaticDspChain& operator=(const StaticDspChain&) = delete;
+};
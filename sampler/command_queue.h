@@ -0,0 +1,119 @@
+#ifndef COMMAND_QUEUE_H
+#define COMMAND_QUEUE_H
+
+#include <atomic>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file command_queue.h
+ * @brief Lock-free MPSC fronta příkazů mezi řídicími vlákny a audio threadem
+ *
+ * Libovolné vlákno (MIDI, GUI, automatizace) volá push(), audio thread
+ * na začátku každého bloku vyprázdní frontu pomocí pop(). Díky tomu
+ * řídicí vlákna nikdy nesahají přímo na voice pool během renderingu.
+ *
+ * Implementace: ohraničený kruhový buffer se sekvenčním číslem v každém
+ * slotu (Vyukov bounded MPMC, zde použit jako MPSC):
+ * - push(): jedno CAS na zápisový index, O(1), žádné zámky ani alokace
+ * - pop():  pouze audio thread, bez CAS (jediný konzument)
+ * - plná fronta: push() vrací false, příkaz se zahodí (nikdy neblokuje)
+ *
+ * @tparam T Typ příkazu (musí být trivially copyable, např. MidiEvent)
+ * @tparam Capacity Kapacita - mocnina dvou
+ */
+template <typename T, size_t Capacity>
+class CommandQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "CommandQueue capacity must be a power of two");
+
+public:
+    CommandQueue() : writeIndex_(0), readIndex_(0) {
+        for (size_t i = 0; i < Capacity; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    CommandQueue(const CommandQueue&) = delete;
+    CommandQueue& operator=(const CommandQueue&) = delete;
+
+    /**
+     * @brief Vloží příkaz do fronty (libovolné vlákno)
+     * @param command Příkaz ke zkopírování
+     * @return false pokud je fronta plná
+     * @note Lock-free, bounded execution time
+     */
+    bool push(const T& command) noexcept {
+        size_t pos = writeIndex_.load(std::memory_order_relaxed);
+
+        for (;;) {
+            Slot& slot = slots_[pos & MASK];
+            const size_t seq = slot.sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+            if (diff == 0) {
+                // Slot je volný - pokus o rezervaci
+                if (writeIndex_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.data = command;
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+                // CAS selhal - pos obsahuje aktuální index, zkusit znovu
+            } else if (diff < 0) {
+                // Konzument ještě slot neuvolnil → fronta je plná
+                return false;
+            } else {
+                // Jiný producent nás předběhl
+                pos = writeIndex_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Vyjme nejstarší příkaz (POUZE audio thread)
+     * @param command Výstupní příkaz
+     * @return false pokud je fronta prázdná
+     * @note Wait-free pro jediného konzumenta
+     */
+    bool pop(T& command) noexcept {
+        const size_t pos = readIndex_.load(std::memory_order_relaxed);
+        Slot& slot = slots_[pos & MASK];
+        const size_t seq = slot.sequence.load(std::memory_order_acquire);
+
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) < 0) {
+            return false;  // Prázdná fronta nebo producent ještě nedopsal
+        }
+
+        command = slot.data;
+        slot.sequence.store(pos + Capacity, std::memory_order_release);
+        readIndex_.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Přibližný test prázdnosti (pro rychlý early-out v audio threadu)
+     */
+    bool empty() const noexcept {
+        return readIndex_.load(std::memory_order_relaxed) ==
+               writeIndex_.load(std::memory_order_acquire);
+    }
+
+    static constexpr size_t capacity() noexcept { return Capacity; }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    std::array<Slot, Capacity> slots_;
+
+    // Oddělené cache lines pro producenty a konzumenta (žádný false sharing)
+    alignas(64) std::atomic<size_t> writeIndex_;
+    alignas(64) std::atomic<size_t> readIndex_;
+};
+
+#endif // COMMAND_QUEUE_H
@@ -1,31 +1,67 @@
 #include "envelope.h"
 #include <algorithm>
+#include <cstring>
 
 // Konstruktor - inicializace per-voice state s výchozími hodnotami
 Envelope::Envelope()
     : attack_midi_index_(8)
     , release_midi_index_(16)
-    , sustain_level_(1.0f) {
+    , sustain_level_(1.0f)
+    , sample_rate_(0) {
+}
+
+// RT-SAFE: Nastavení frekvence pro blokové čtení tabulek
+void Envelope::setSampleRate(int sample_rate) noexcept {
+    sample_rate_.store(sample_rate, std::memory_order_relaxed);
 }
 
 // RT-SAFE: Nastavení MIDI indexu pro attack
 void Envelope::setAttackMIDI(uint8_t midi_value) noexcept {
-    attack_midi_index_ = std::min(midi_value, static_cast<uint8_t>(127));
+    attack_midi_index_.store(std::min(midi_value, static_cast<uint8_t>(127)), std::memory_order_relaxed);
 }
 
 // RT-SAFE: Nastavení MIDI indexu pro release
 void Envelope::setReleaseMIDI(uint8_t midi_value) noexcept {
-    release_midi_index_ = std::min(midi_value, static_cast<uint8_t>(127));
+    release_midi_index_.store(std::min(midi_value, static_cast<uint8_t>(127)), std::memory_order_relaxed);
 }
 
 // RT-SAFE: Nastavení sustain úrovně dle MIDI
 void Envelope::setSustainLevelMIDI(uint8_t midi_value) noexcept {
-    sustain_level_ = std::clamp(static_cast<float>(midi_value) / 127.0f, 0.0f, 1.0f);
+    sustain_level_.store(std::clamp(static_cast<float>(midi_value) / 127.0f, 0.0f, 1.0f),
+                         std::memory_order_relaxed);
 }
 
 // RT-SAFE: Získání sustain úrovně
 float Envelope::getSustainLevel() const noexcept { 
-    return sustain_level_; 
+    return sustain_level_.load(std::memory_order_relaxed);
+}
+
+// RT-SAFE: Attack z tabulky vyhledané pro tento blok (po konci tabulky 1.0)
+bool Envelope::getAttackGains(float* gain_buffer, int num_samples,
+                              int envelope_attack_position) const noexcept {
+    const uint8_t midi = attack_midi_index_.load(std::memory_order_relaxed);
+    const int sample_rate = sample_rate_.load(std::memory_order_relaxed);
+    const EnvelopeStaticData::EnvelopeIndex table = EnvelopeStaticData::getAttackTable(midi, sample_rate);
+    if (!table.data || table.length == 0) {
+        // Validující cesta nahlásí konkrétní chybu
+        return EnvelopeStaticData::getAttackGains(gain_buffer, num_samples,
+                                                  envelope_attack_position, midi, sample_rate);
+    }
+    return readTable(table, gain_buffer, num_samples, envelope_attack_position, 1.0f);
+}
+
+// RT-SAFE: Release z tabulky vyhledané pro tento blok (po konci tabulky 0.0)
+bool Envelope::getReleaseGains(float* gain_buffer, int num_samples,
+                               int envelope_release_position) const noexcept {
+    const uint8_t midi = release_midi_index_.load(std::memory_order_relaxed);
+    const int sample_rate = sample_rate_.load(std::memory_order_relaxed);
+    const EnvelopeStaticData::EnvelopeIndex table = EnvelopeStaticData::getReleaseTable(midi, sample_rate);
+    if (!table.data || table.length == 0) {
+        // Validující cesta nahlásí konkrétní chybu
+        return EnvelopeStaticData::getReleaseGains(gain_buffer, num_samples,
+                                                   envelope_release_position, midi, sample_rate);
+    }
+    return readTable(table, gain_buffer, num_samples, envelope_release_position, 0.0f);
 }
 
 // RT-SAFE: Kopírování attack dat do bufferu (deleguje na static data)
@@ -33,7 +69,8 @@ bool Envelope::getAttackGains(float* gain_buffer, int num_samples,
                              int envelope_attack_position, int sample_rate) const noexcept {
     return EnvelopeStaticData::getAttackGains(gain_buffer, num_samples, 
                                              envelope_attack_position, 
-                                             attack_midi_index_, sample_rate);
+                                             attack_midi_index_.load(std::memory_order_relaxed),
+                                             sample_rate);
 }
 
 // RT-SAFE: Kopírování release dat do bufferu (deleguje na static data)
@@ -41,15 +78,29 @@ bool Envelope::getReleaseGains(float* gain_buffer, int num_samples,
                               int envelope_release_position, int sample_rate) const noexcept {
     return EnvelopeStaticData::getReleaseGains(gain_buffer, num_samples, 
                                               envelope_release_position, 
-                                              release_midi_index_, sample_rate);
+                                              release_midi_index_.load(std::memory_order_relaxed),
+                                              sample_rate);
 }
 
 // RT-SAFE: Získání délky attack fáze v ms (deleguje na static data)
 float Envelope::getAttackLength(int sample_rate) const noexcept {
-    return EnvelopeStaticData::getAttackLength(attack_midi_index_, sample_rate);
+    return EnvelopeStaticData::getAttackLength(attack_midi_index_.load(std::memory_order_relaxed),
+                                             sample_rate);
 }
 
 // RT-SAFE: Získání délky release fáze v ms (deleguje na static data)
 float Envelope::getReleaseLength(int sample_rate) const noexcept {
-    return EnvelopeStaticData::getReleaseLength(release_midi_index_, sample_rate);
-}
\ No newline at end of file
+    return EnvelopeStaticData::getReleaseLength(release_midi_index_.load(std::memory_order_relaxed),
+                                              sample_rate);
+}
+
+// RT-SAFE: Ořezaná kopie z tabulky + doplnění koncovou hodnotou
+bool Envelope::readTable(const EnvelopeStaticData::EnvelopeIndex& table, float* gain_buffer,
+                         int num_samples, int position, float end_value) noexcept {
+    const int available = std::max(0, std::min(num_samples, table.length - position));
+    if (available > 0) {
+        std::memcpy(gain_buffer, table.data + position, static_cast<size_t>(available) * sizeof(float));
+    }
+    std::fill(gain_buffer + available, gain_buffer + num_samples, end_value);
+    return position + num_samples <= table.length;
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include <cstdint>
 #include "envelope_static_data.h"
 
@@ -11,6 +12,14 @@
  * 
  * Zachovává původní API pro kompatibilitu s Voice třídou, ale interně
  * deleguje všechny operace na EnvelopeStaticData.
+ *
+ * PUBLIKACE PARAMETRŮ:
+ * Settery zapisují jen atomické MIDI indexy / sustain úroveň (relaxed), takže je
+ * lze volat z libovolného threadu. Blokové getAttackGains()/getReleaseGains()
+ * bez sample_rate si na začátku bloku index jednou načtou a vyhledají lokální
+ * kopii {data, length} z neměnné statické tabulky - dvojice se nemůže roztrhnout.
+ * Prázdná tabulka (neinicializovaná data, neplatná frekvence) jde na validující
+ * cestu EnvelopeStaticData, která chybu nahlásí.
  */
 class Envelope {
 public:
@@ -20,6 +29,13 @@ public:
      */
     Envelope();
 
+    /**
+     * @brief RT-SAFE: Nastaví vzorkovací frekvenci pro blokové getAttackGains()/getReleaseGains()
+     *
+     * @param sample_rate Vzorkovací frekvence (44100 nebo 48000)
+     */
+    void setSampleRate(int sample_rate) noexcept;
+
     /**
      * @brief RT-SAFE: Nastaví MIDI hodnotu pro attack obálku
      * 
@@ -48,6 +64,30 @@ public:
      */
     float getSustainLevel() const noexcept;
 
+    /**
+     * @brief RT-SAFE: Získá hodnoty attack obálky z tabulky vyhledané na začátku bloku
+     *
+     * @param gain_buffer Ukazatel na buffer pro výstupní hodnoty
+     * @param num_samples Počet požadovaných vzorků (> 0)
+     * @param envelope_attack_position Pozice v obálce (offset, >= 0)
+     * @return true pokud obálka pokračuje, false při dosažení konce
+     * @note Frekvence dle posledního setSampleRate(); prázdná tabulka = exitOnError
+     */
+    bool getAttackGains(float* gain_buffer, int num_samples,
+                        int envelope_attack_position) const noexcept;
+
+    /**
+     * @brief RT-SAFE: Získá hodnoty release obálky z tabulky vyhledané na začátku bloku
+     *
+     * @param gain_buffer Ukazatel na buffer pro výstupní hodnoty
+     * @param num_samples Počet požadovaných vzorků (> 0)
+     * @param envelope_release_position Pozice v obálce (offset, >= 0)
+     * @return true pokud obálka pokračuje, false při dosažení konce
+     * @note Frekvence dle posledního setSampleRate(); prázdná tabulka = exitOnError
+     */
+    bool getReleaseGains(float* gain_buffer, int num_samples,
+                         int envelope_release_position) const noexcept;
+
     /**
      * @brief RT-SAFE: Získá hodnoty attack obálky (deleguje na static data)
      * 
@@ -89,8 +129,17 @@ public:
     float getReleaseLength(int sample_rate) const noexcept;
 
 private:
-    // Per-voice state (minimální paměťová spotřeba)
-    uint8_t attack_midi_index_;      // Aktuální MIDI index pro attack (0-127)
-    uint8_t release_midi_index_;     // Aktuální MIDI index pro release (0-127)
-    float sustain_level_;            // Sustain úroveň (0.0f-1.0f)
+    // Per-voice state (minimální paměťová spotřeba, zapisovatelné z libovolného threadu)
+    std::atomic<uint8_t> attack_midi_index_;  // Aktuální MIDI index pro attack (0-127)
+    std::atomic<uint8_t> release_midi_index_; // Aktuální MIDI index pro release (0-127)
+    std::atomic<float> sustain_level_;        // Sustain úroveň (0.0f-1.0f)
+    std::atomic<int> sample_rate_;            // Frekvence dle setSampleRate() (0 = nenastaveno)
+
+    /**
+     * @brief Ořezaná kopie tabulky od pozice, zbytek doplní end_value
+     * @param table Lokální kopie vyhledaná na začátku bloku (musí být neprázdná)
+     * @return true pokud tabulka pokrývá celý požadovaný rozsah
+     */
+    static bool readTable(const EnvelopeStaticData::EnvelopeIndex& table, float* gain_buffer,
+                          int num_samples, int position, float end_value) noexcept;
 };
\ No newline at end of file
@@ -4,8 +4,123 @@
 #include <sstream>
 #include <iomanip>
 #include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <thread>
 #include <vector>
 
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ===== BINARY CACHE HELPERS =====
+
+namespace {
+
+// Hlavička cache souboru (nativní endianita, za ní délky [rate][type][midi] a data)
+struct EnvelopeCacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t floatSize;
+    uint32_t numSampleRates;
+    uint32_t numMidiValues;
+    int32_t sampleRates[2];
+    float totalDuration;
+    float tauDivisor;
+    float convergenceThreshold;
+    uint32_t reserved;
+};
+
+constexpr char ENVELOPE_CACHE_MAGIC[8] = {'I', 'T', 'H', 'E', 'N', 'V', 'C', '\0'};
+
+// Read-only mapování cache souboru (platí od loadCache() do cleanup())
+struct CacheMapping {
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+#if defined(_WIN32)
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+};
+
+CacheMapping cacheMapping;
+
+bool mapFile(const std::string& path, CacheMapping& out) noexcept {
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    out.data = static_cast<const unsigned char*>(view);
+    out.size = static_cast<size_t>(size.QuadPart);
+    out.file = file;
+    out.mapping = mapping;
+    return true;
+#else
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // Mapování zůstává platné i po zavření deskriptoru
+    if (view == MAP_FAILED) return false;
+
+    out.data = static_cast<const unsigned char*>(view);
+    out.size = static_cast<size_t>(st.st_size);
+    return true;
+#endif
+}
+
+void unmapFile(CacheMapping& mapping) noexcept {
+    if (!mapping.data) return;
+#if defined(_WIN32)
+    UnmapViewOfFile(mapping.data);
+    CloseHandle(mapping.mapping);
+    CloseHandle(mapping.file);
+    mapping.file = INVALID_HANDLE_VALUE;
+    mapping.mapping = nullptr;
+#else
+    munmap(const_cast<unsigned char*>(mapping.data), mapping.size);
+#endif
+    mapping.data = nullptr;
+    mapping.size = 0;
+}
+
+} // namespace
+
 // Statická inicializace členů
 std::vector<float> EnvelopeStaticData::attack_buffer_[NUM_SAMPLE_RATES];
 std::vector<float> EnvelopeStaticData::release_buffer_[NUM_SAMPLE_RATES];
@@ -16,7 +131,7 @@ EnvelopeStaticData::ErrorCallback EnvelopeStaticData::errorCallback_;
 
 // ===== PUBLIC API =====
 
-bool EnvelopeStaticData::initialize(Logger& logger) {
+bool EnvelopeStaticData::initialize(Logger& logger, const std::string& cacheFilePath) {
     if (initialized_.load()) {
         logger.log("EnvelopeStaticData/initialize", LogSeverity::Warning, 
                   "Already initialized, skipping");
@@ -27,9 +142,15 @@ bool EnvelopeStaticData::initialize(Logger& logger) {
               "Starting global envelope generation for all sample rates");
 
     try {
-        // Generuj obálky pro obě podporované vzorkovací frekvence
-        generateEnvelopeForSampleRate(SAMPLE_RATES[SAMPLE_RATE_INDEX_44100], logger);
-        generateEnvelopeForSampleRate(SAMPLE_RATES[SAMPLE_RATE_INDEX_48000], logger);
+        // Nejprve zkusit namapovat cache z předchozího spuštění
+        const bool fromCache = !cacheFilePath.empty() && loadCache(cacheFilePath, logger);
+
+        if (!fromCache) {
+            // Rozložení bufferů pro obě podporované frekvence, pak paralelní plnění
+            layoutEnvelopeForSampleRate(SAMPLE_RATES[SAMPLE_RATE_INDEX_44100], logger);
+            layoutEnvelopeForSampleRate(SAMPLE_RATES[SAMPLE_RATE_INDEX_48000], logger);
+            fillEnvelopesParallel(logger);
+        }
 
         // Validace inicializace
         bool success = true;
@@ -54,16 +175,23 @@ bool EnvelopeStaticData::initialize(Logger& logger) {
         }
 
         initialized_.store(true);
+
+        if (!fromCache && !cacheFilePath.empty()) {
+            saveCache(cacheFilePath, logger);
+        }
         
-        // Log memory usage statistics
+        // Log memory usage statistics (z indexů - data mohou být i v mapované cache)
         size_t totalMemory = 0;
         for (int sr_idx = 0; sr_idx < NUM_SAMPLE_RATES; ++sr_idx) {
-            totalMemory += attack_buffer_[sr_idx].size() * sizeof(float);
-            totalMemory += release_buffer_[sr_idx].size() * sizeof(float);
+            for (int midi = 0; midi <= MAX_MIDI; ++midi) {
+                totalMemory += static_cast<size_t>(attack_index_[sr_idx][midi].length) * sizeof(float);
+                totalMemory += static_cast<size_t>(release_index_[sr_idx][midi].length) * sizeof(float);
+            }
         }
         
         logger.log("EnvelopeStaticData/initialize", LogSeverity::Info,
-                  "Global envelope initialization completed successfully. "
+                  "Global envelope initialization completed successfully (" +
+                  std::string(fromCache ? "mapped from cache" : "generated") + "). "
                   "Memory usage: " + std::to_string(totalMemory / 1024 / 1024) + " MB");
         return true;
 
@@ -98,6 +226,9 @@ void EnvelopeStaticData::cleanup() noexcept {
             release_index_[sr_idx][midi].length = 0;
         }
     }
+
+    // Odmapovat cache (indexy na ni už neukazují)
+    releaseCacheMapping();
     
     initialized_.store(false);
 }
@@ -198,6 +329,24 @@ bool EnvelopeStaticData::getReleaseGains(float* gainBuffer, int numSamples, int
     return continues;
 }
 
+EnvelopeStaticData::EnvelopeIndex EnvelopeStaticData::getAttackTable(uint8_t midiValue,
+                                                                    int sampleRate) noexcept {
+    const int sr_index = getSampleRateIndex(sampleRate);
+    if (!initialized_.load() || !isValidMidiValue(midiValue) || !isValidSampleRateIndex(sr_index)) {
+        return EnvelopeIndex();
+    }
+    return attack_index_[sr_index][midiValue];
+}
+
+EnvelopeStaticData::EnvelopeIndex EnvelopeStaticData::getReleaseTable(uint8_t midiValue,
+                                                                     int sampleRate) noexcept {
+    const int sr_index = getSampleRateIndex(sampleRate);
+    if (!initialized_.load() || !isValidMidiValue(midiValue) || !isValidSampleRateIndex(sr_index)) {
+        return EnvelopeIndex();
+    }
+    return release_index_[sr_index][midiValue];
+}
+
 float EnvelopeStaticData::getAttackLength(uint8_t midiValue, int sampleRate) noexcept {
     if (!initialized_.load() || !isValidMidiValue(midiValue)) {
         return 0.0f;
@@ -245,15 +394,15 @@ float EnvelopeStaticData::calculateTau(uint8_t midi) noexcept {
     return (static_cast<float>(midi) / 127.0f) * (TOTAL_DURATION / TAU_DIVISOR);
 }
 
-void EnvelopeStaticData::generateEnvelopeForSampleRate(int sampleRate, Logger& logger) {
+void EnvelopeStaticData::layoutEnvelopeForSampleRate(int sampleRate, Logger& logger) {
     const int sr_index = getSampleRateIndex(sampleRate);
     if (!isValidSampleRateIndex(sr_index)) {
-        logger.log("EnvelopeStaticData/generateEnvelopeForSampleRate", LogSeverity::Error,
+        logger.log("EnvelopeStaticData/layoutEnvelopeForSampleRate", LogSeverity::Error,
                   "Unsupported sample rate: " + std::to_string(sampleRate) + ". Terminating.");
         std::exit(1);
     }
 
-    logger.log("EnvelopeStaticData/generateEnvelopeForSampleRate", LogSeverity::Info,
+    logger.log("EnvelopeStaticData/layoutEnvelopeForSampleRate", LogSeverity::Info,
               "Generating envelopes for " + std::to_string(sampleRate) + " Hz");
 
     std::vector<float>& attack_buffer = attack_buffer_[sr_index];
@@ -262,130 +411,303 @@ void EnvelopeStaticData::generateEnvelopeForSampleRate(int sampleRate, Logger& l
     EnvelopeIndex* release_index = release_index_[sr_index];
 
     try {
-        // První průchod - vytvoření dočasných vektorů dat
+        // První průchod - jen délky (bez generování celých křivek)
         size_t total_attack_size = 0;
         size_t total_release_size = 0;
-        std::vector<std::pair<std::vector<float>, int>> temp_attack_data;
-        std::vector<std::pair<std::vector<float>, int>> temp_release_data;
-        temp_attack_data.reserve(128);
-        temp_release_data.reserve(128);
-
-        for (uint8_t midi = 0; midi <= MAX_MIDI; ++midi) {
-            auto attack_result = generateSingleEnvelope(midi, sampleRate, "attack");
-            total_attack_size += attack_result.second;
-            temp_attack_data.push_back(std::move(attack_result));
-
-            auto release_result = generateSingleEnvelope(midi, sampleRate, "release");
-            total_release_size += release_result.second;
-            temp_release_data.push_back(std::move(release_result));
+        int attack_lengths[MAX_MIDI + 1];
+        int release_lengths[MAX_MIDI + 1];
+
+        for (int midi = 0; midi <= MAX_MIDI; ++midi) {
+            attack_lengths[midi] = calculateEnvelopeLength(static_cast<uint8_t>(midi), sampleRate, true);
+            release_lengths[midi] = calculateEnvelopeLength(static_cast<uint8_t>(midi), sampleRate, false);
+            total_attack_size += attack_lengths[midi];
+            total_release_size += release_lengths[midi];
         }
 
-        // Alokace souvislých bufferů
-        attack_buffer.resize(total_attack_size);
-        release_buffer.resize(total_release_size);
+        // Alokace souvislých bufferů - křivky se generují přímo do nich
+        attack_buffer.assign(total_attack_size, 0.0f);
+        release_buffer.assign(total_release_size, 0.0f);
 
-        // Druhý průchod - zkopírovat a nastavit indexy
+        // Druhý průchod - nastavit indexy
         size_t attack_offset = 0;
         size_t release_offset = 0;
 
-        for (uint8_t midi = 0; midi <= MAX_MIDI; ++midi) {
-            const auto& attack_data = temp_attack_data[midi];
-            std::copy(attack_data.first.begin(), attack_data.first.end(),
-                     attack_buffer.data() + attack_offset);
+        for (int midi = 0; midi <= MAX_MIDI; ++midi) {
             attack_index[midi].data = attack_buffer.data() + attack_offset;
-            attack_index[midi].length = attack_data.second;
-            attack_offset += attack_data.second;
+            attack_index[midi].length = attack_lengths[midi];
+            attack_offset += attack_lengths[midi];
 
-            const auto& release_data = temp_release_data[midi];
-            std::copy(release_data.first.begin(), release_data.first.end(),
-                     release_buffer.data() + release_offset);
             release_index[midi].data = release_buffer.data() + release_offset;
-            release_index[midi].length = release_data.second;
-            release_offset += release_data.second;
-
-            // Logování pro debug (non-RT)
-            std::vector<float> attack_log_data(attack_index[midi].data,
-                                              attack_index[midi].data + attack_index[midi].length);
-            std::vector<float> release_log_data(release_index[midi].data,
-                                               release_index[midi].data + release_index[midi].length);
-            logEnvelopeData(attack_log_data, "attack", sampleRate, midi, logger);
-            logEnvelopeData(release_log_data, "release", sampleRate, midi, logger);
+            release_index[midi].length = release_lengths[midi];
+            release_offset += release_lengths[midi];
         }
 
     } catch (const std::exception& e) {
-        logger.log("EnvelopeStaticData/generateEnvelopeForSampleRate", LogSeverity::Error,
+        logger.log("EnvelopeStaticData/layoutEnvelopeForSampleRate", LogSeverity::Error,
                   "Exception during envelope generation: " + std::string(e.what()) + ". Terminating.");
         std::exit(1);
     } catch (...) {
-        logger.log("EnvelopeStaticData/generateEnvelopeForSampleRate", LogSeverity::Error,
+        logger.log("EnvelopeStaticData/layoutEnvelopeForSampleRate", LogSeverity::Error,
                   "Unknown error during envelope generation. Terminating.");
         std::exit(1);
     }
 
-    logger.log("EnvelopeStaticData/generateEnvelopeForSampleRate", LogSeverity::Info,
-              "Completed envelope generation for " + std::to_string(sampleRate) +
+    logger.log("EnvelopeStaticData/layoutEnvelopeForSampleRate", LogSeverity::Info,
+              "Completed envelope layout for " + std::to_string(sampleRate) +
               " Hz (128 MIDI values, 2 types). Total attack samples: " + std::to_string(attack_buffer.size()) +
               ", total release samples: " + std::to_string(release_buffer.size()));
 }
 
-std::pair<std::vector<float>, int> EnvelopeStaticData::generateSingleEnvelope(
-    uint8_t midi, int sampleRate, const std::string& envelope_type) {
-    const float tau = calculateTau(midi);
-    const float target_val = (envelope_type == "attack") ? 1.0f : 0.0f;
+void EnvelopeStaticData::fillEnvelopesParallel(Logger& logger) {
+    // Úlohy: [rate][midi][type], nejdelší křivky (vysoké MIDI) první kvůli vyvážení
+    constexpr int JOBS_PER_RATE = (MAX_MIDI + 1) * NUM_ENVELOPE_TYPES;
+    constexpr int JOB_COUNT = NUM_SAMPLE_RATES * JOBS_PER_RATE;
+    std::atomic<int> nextJob{0};
+
+    auto worker = [&nextJob]() noexcept {
+        int job;
+        while ((job = nextJob.fetch_add(1, std::memory_order_relaxed)) < JOB_COUNT) {
+            const int sr_idx = job / JOBS_PER_RATE;
+            const int rest = job % JOBS_PER_RATE;
+            const uint8_t midi = static_cast<uint8_t>(MAX_MIDI - rest / NUM_ENVELOPE_TYPES);
+            const bool attack = (rest % NUM_ENVELOPE_TYPES) == 0;
+
+            // Index ukazuje do vlastních (nekonstantních) bufferů attack_buffer_/release_buffer_
+            const EnvelopeIndex& idx = attack ? attack_index_[sr_idx][midi] : release_index_[sr_idx][midi];
+            fillSingleEnvelope(const_cast<float*>(idx.data), idx.length, midi,
+                               SAMPLE_RATES[sr_idx], attack);
+        }
+    };
 
-    // Speciální případ pro MIDI 0 (okamžitá změna)
-    if (midi == 0) {
-        std::vector<float> data(1, target_val);
-        return std::make_pair(std::move(data), 1);
+    const unsigned hardwareThreads = std::thread::hardware_concurrency();
+    const int threadCount = std::max(1, std::min(static_cast<int>(hardwareThreads),
+                                                 ENVELOPE_INIT_MAX_THREADS));
+
+    std::vector<std::thread> helpers;
+    helpers.reserve(threadCount - 1);
+    for (int i = 1; i < threadCount; ++i) {
+        helpers.emplace_back(worker);
+    }
+    worker();  // Volající vlákno pracuje také
+    for (std::thread& helper : helpers) {
+        helper.join();
+    }
+
+    logger.log("EnvelopeStaticData/fillEnvelopesParallel", LogSeverity::Info,
+              "Generated " + std::to_string(JOB_COUNT) + " envelopes on " +
+              std::to_string(threadCount) + " threads");
+
+    // Logování pro debug (non-RT)
+    for (int sr_idx = 0; sr_idx < NUM_SAMPLE_RATES; ++sr_idx) {
+        for (int midi = 0; midi <= MAX_MIDI; ++midi) {
+            logEnvelopeData(attack_index_[sr_idx][midi].data, attack_index_[sr_idx][midi].length,
+                            "attack", SAMPLE_RATES[sr_idx], static_cast<uint8_t>(midi), logger);
+            logEnvelopeData(release_index_[sr_idx][midi].data, release_index_[sr_idx][midi].length,
+                            "release", SAMPLE_RATES[sr_idx], static_cast<uint8_t>(midi), logger);
+        }
     }
+}
+
+int EnvelopeStaticData::calculateUntrimmedLength(uint8_t midi, int sampleRate, float& t_stable) noexcept {
+    const float tau = calculateTau(midi);
 
     // Výpočet času konvergence (t_stable) podle prahu
     const float log_threshold = -std::log(CONVERGENCE_THRESHOLD); // ~4.605 pro threshold=0.01
-    float t_stable = tau * log_threshold;
+    t_stable = tau * log_threshold;
     t_stable = std::min(t_stable, TOTAL_DURATION);
 
     const int max_samples = static_cast<int>(sampleRate * TOTAL_DURATION) + 1;
-    int num_samples = std::max(2, std::min(static_cast<int>(sampleRate * t_stable) + 1, max_samples));
-
-    std::vector<float> data(num_samples);
+    return std::max(2, std::min(static_cast<int>(sampleRate * t_stable) + 1, max_samples));
+}
 
+float EnvelopeStaticData::envelopeSampleValue(int i, float tau, float t_stable, int numSamples,
+                                              bool attack) noexcept {
     // Správný výpočet času t podle np.linspace(0, t_stable, num_samples)
-    for (int i = 0; i < num_samples; ++i) {
-        const float t = static_cast<float>(i) * t_stable / static_cast<float>(num_samples - 1);
+    const float t = static_cast<float>(i) * t_stable / static_cast<float>(numSamples - 1);
+    const float value = attack ? 1.0f - std::exp(-t / tau) : std::exp(-t / tau);
+    return std::max(0.0f, std::min(1.0f, value));
+}
+
+int EnvelopeStaticData::calculateEnvelopeLength(uint8_t midi, int sampleRate, bool attack) noexcept {
+    // Speciální případ pro MIDI 0 (okamžitá změna)
+    if (midi == 0) return 1;
+
+    float t_stable;
+    const int num_samples = calculateUntrimmedLength(midi, sampleRate, t_stable);
+    const float tau = calculateTau(midi);
 
-        if (envelope_type == "attack") {
-            data[i] = 1.0f - std::exp(-t / tau);
+    auto converged = [&](int i) noexcept {
+        const float value = envelopeSampleValue(i, tau, t_stable, num_samples, attack);
+        return attack ? value >= (1.0f - CONVERGENCE_THRESHOLD) : value <= CONVERGENCE_THRESHOLD;
+    };
+
+    if (!converged(num_samples - 1)) return num_samples;
+
+    // Oříznutí po dosažení konvergence: první vzorek za prahem (křivka je monotónní)
+    int lo = 0;
+    int hi = num_samples - 1;
+    while (lo < hi) {
+        const int mid = lo + (hi - lo) / 2;
+        if (converged(mid)) {
+            hi = mid;
         } else {
-            data[i] = std::exp(-t / tau);
+            lo = mid + 1;
         }
+    }
+    return lo + 1;
+}
 
-        data[i] = std::max(0.0f, std::min(1.0f, data[i]));
+void EnvelopeStaticData::fillSingleEnvelope(float* out, int length, uint8_t midi, int sampleRate,
+                                            bool attack) noexcept {
+    if (midi == 0) {
+        out[0] = attack ? 1.0f : 0.0f;
+        return;
     }
 
-    // Oříznutí po dosažení konvergence (threshold)
-    int converge_idx = num_samples;
-    if (envelope_type == "attack") {
-        for (int i = 0; i < num_samples; ++i) {
-            if (data[i] >= (1.0f - CONVERGENCE_THRESHOLD)) {
-                converge_idx = i + 1;
-                break;
-            }
+    float t_stable;
+    const int num_samples = calculateUntrimmedLength(midi, sampleRate, t_stable);
+    const float tau = calculateTau(midi);
+
+    for (int i = 0; i < length; ++i) {
+        out[i] = envelopeSampleValue(i, tau, t_stable, num_samples, attack);
+    }
+}
+
+// ===== BINARY CACHE =====
+
+bool EnvelopeStaticData::loadCache(const std::string& path, Logger& logger) {
+    static_assert(NUM_SAMPLE_RATES == 2, "EnvelopeCacheHeader stores exactly two sample rates");
+
+    CacheMapping mapping;
+    if (!mapFile(path, mapping)) {
+        logger.log("EnvelopeStaticData/loadCache", LogSeverity::Info,
+                  "Envelope cache not found, generating: " + path);
+        return false;
+    }
+
+    const size_t lengthsSize = sizeof(int32_t) * NUM_SAMPLE_RATES * NUM_ENVELOPE_TYPES * (MAX_MIDI + 1);
+    const size_t dataOffset = sizeof(EnvelopeCacheHeader) + lengthsSize;
+    const int max_samples = static_cast<int>(SAMPLE_RATES[NUM_SAMPLE_RATES - 1] * TOTAL_DURATION) + 1;
+
+    // Validace hlavičky - verze i parametry generátoru musí přesně sedět
+    EnvelopeCacheHeader header;
+    bool valid = mapping.size >= dataOffset;
+    if (valid) {
+        std::memcpy(&header, mapping.data, sizeof(header));
+        valid = std::memcmp(header.magic, ENVELOPE_CACHE_MAGIC, sizeof(header.magic)) == 0 &&
+                header.version == CACHE_VERSION &&
+                header.floatSize == sizeof(float) &&
+                header.numSampleRates == NUM_SAMPLE_RATES &&
+                header.numMidiValues == MAX_MIDI + 1 &&
+                header.sampleRates[0] == SAMPLE_RATES[0] &&
+                header.sampleRates[1] == SAMPLE_RATES[1] &&
+                header.totalDuration == TOTAL_DURATION &&
+                header.tauDivisor == TAU_DIVISOR &&
+                header.convergenceThreshold == CONVERGENCE_THRESHOLD;
+    }
+
+    // Validace délek a celkové velikosti souboru
+    const int32_t* lengths = reinterpret_cast<const int32_t*>(mapping.data + sizeof(EnvelopeCacheHeader));
+    size_t totalSamples = 0;
+    for (int i = 0; valid && i < NUM_SAMPLE_RATES * NUM_ENVELOPE_TYPES * (MAX_MIDI + 1); ++i) {
+        valid = lengths[i] > 0 && lengths[i] <= max_samples;
+        totalSamples += static_cast<size_t>(lengths[i]);
+    }
+    valid = valid && mapping.size == dataOffset + totalSamples * sizeof(float);
+
+    if (!valid) {
+        unmapFile(mapping);
+        logger.log("EnvelopeStaticData/loadCache", LogSeverity::Warning,
+                  "Envelope cache is stale or corrupted, regenerating: " + path);
+        return false;
+    }
+
+    // Indexy ukazují přímo do mapované paměti (pořadí: rate -> attack[128], release[128])
+    const float* data = reinterpret_cast<const float*>(mapping.data + dataOffset);
+    for (int sr_idx = 0; sr_idx < NUM_SAMPLE_RATES; ++sr_idx) {
+        const int32_t* attackLengths = lengths + (sr_idx * NUM_ENVELOPE_TYPES) * (MAX_MIDI + 1);
+        const int32_t* releaseLengths = attackLengths + (MAX_MIDI + 1);
+
+        for (int midi = 0; midi <= MAX_MIDI; ++midi) {
+            attack_index_[sr_idx][midi].data = data;
+            attack_index_[sr_idx][midi].length = attackLengths[midi];
+            data += attackLengths[midi];
         }
-    } else {
-        for (int i = 0; i < num_samples; ++i) {
-            if (data[i] <= CONVERGENCE_THRESHOLD) {
-                converge_idx = i + 1;
-                break;
+        for (int midi = 0; midi <= MAX_MIDI; ++midi) {
+            release_index_[sr_idx][midi].data = data;
+            release_index_[sr_idx][midi].length = releaseLengths[midi];
+            data += releaseLengths[midi];
+        }
+    }
+
+    cacheMapping = mapping;
+    logger.log("EnvelopeStaticData/loadCache", LogSeverity::Info,
+              "Envelope cache mapped: " + path + " (" + std::to_string(mapping.size / 1024) + " KB)");
+    return true;
+}
+
+void EnvelopeStaticData::saveCache(const std::string& path, Logger& logger) {
+    EnvelopeCacheHeader header{};
+    std::memcpy(header.magic, ENVELOPE_CACHE_MAGIC, sizeof(header.magic));
+    header.version = CACHE_VERSION;
+    header.floatSize = sizeof(float);
+    header.numSampleRates = NUM_SAMPLE_RATES;
+    header.numMidiValues = MAX_MIDI + 1;
+    header.sampleRates[0] = SAMPLE_RATES[0];
+    header.sampleRates[1] = SAMPLE_RATES[1];
+    header.totalDuration = TOTAL_DURATION;
+    header.tauDivisor = TAU_DIVISOR;
+    header.convergenceThreshold = CONVERGENCE_THRESHOLD;
+
+    // Zápis do dočasného souboru a přejmenování - čtenář nikdy neuvidí polovičatý soubor
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (out) {
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            for (int sr_idx = 0; sr_idx < NUM_SAMPLE_RATES; ++sr_idx) {
+                for (int midi = 0; midi <= MAX_MIDI; ++midi) {
+                    const int32_t length = attack_index_[sr_idx][midi].length;
+                    out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+                }
+                for (int midi = 0; midi <= MAX_MIDI; ++midi) {
+                    const int32_t length = release_index_[sr_idx][midi].length;
+                    out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+                }
+            }
+            for (int sr_idx = 0; sr_idx < NUM_SAMPLE_RATES; ++sr_idx) {
+                out.write(reinterpret_cast<const char*>(attack_buffer_[sr_idx].data()),
+                          attack_buffer_[sr_idx].size() * sizeof(float));
+                out.write(reinterpret_cast<const char*>(release_buffer_[sr_idx].data()),
+                          release_buffer_[sr_idx].size() * sizeof(float));
             }
         }
+        if (!out) {
+            logger.log("EnvelopeStaticData/saveCache", LogSeverity::Warning,
+                      "Cannot write envelope cache: " + tempPath + " - cache skipped");
+            std::remove(tempPath.c_str());
+            return;
+        }
     }
 
-    if (converge_idx < num_samples) {
-        data.resize(converge_idx);
-        num_samples = converge_idx;
+    std::remove(path.c_str());  // rename() na Windows nepřepisuje existující soubor
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        logger.log("EnvelopeStaticData/saveCache", LogSeverity::Warning,
+                  "Cannot rename envelope cache to: " + path + " - cache skipped");
+        std::remove(tempPath.c_str());
+        return;
     }
 
-    return std::make_pair(std::move(data), num_samples);
+    logger.log("EnvelopeStaticData/saveCache", LogSeverity::Info,
+              "Envelope cache saved: " + path);
+}
+
+bool EnvelopeStaticData::isMappedFromCache() noexcept {
+    return cacheMapping.data != nullptr;
+}
+
+void EnvelopeStaticData::releaseCacheMapping() noexcept {
+    unmapFile(cacheMapping);
 }
 
 int EnvelopeStaticData::getSampleRateIndex(int sampleRate) noexcept {
@@ -422,11 +744,10 @@ void EnvelopeStaticData::exitOnError(const std::string& component,
     std::exit(1);
 }
 
-void EnvelopeStaticData::logEnvelopeData(const std::vector<float>& data, const std::string& type,
+void EnvelopeStaticData::logEnvelopeData(const float* data, int size, const std::string& type,
                                        int sampleRate, uint8_t midi_value, Logger& logger) {
-    if (data.empty()) return;
+    if (!data || size <= 0) return;
 
-    const int size = static_cast<int>(data.size());
     const std::string component = "EnvelopeStaticData/generate";
 
     auto formatFloat = [](float val) -> std::string {
@@ -6,8 +6,22 @@
 #include <atomic>
 #include <functional>
 
+#include "IthacaConfig.h"
 #include "../core_logger.h"
 
+// Maximální počet vláken pro generování obálek při initialize()
+#ifndef ENVELOPE_INIT_MAX_THREADS
+#define ENVELOPE_INIT_MAX_THREADS 8
+#endif
+
+// Binární cache obálek - fallback pro nadřazený IthacaConfig.h bez těchto voleb
+#ifndef ITHACA_ENABLE_ENVELOPE_CACHE
+#define ITHACA_ENABLE_ENVELOPE_CACHE 0
+#endif
+
+#ifndef ITHACA_ENVELOPE_CACHE_FILE
+#define ITHACA_ENVELOPE_CACHE_FILE "envelope_cache.bin"
+#endif
 
 /**
  * @brief Statická třída pro sdílená envelope data mezi všemi VoiceManager instancemi
@@ -20,14 +34,45 @@
  */
 class EnvelopeStaticData {
 public:
+    // Struktura pro indexování obálky (ukazatel do sdíleného bufferu + délka)
+    struct EnvelopeIndex {
+        const float* data;   // Ukazatel na začátek dat obálky
+        int length;          // Počet vzorků v obálce
+        
+        EnvelopeIndex() : data(nullptr), length(0) {}
+    };
+
     /**
      * @brief GLOBÁLNÍ INICIALIZACE: Musí se volat před vytvořením jakýchkoli VoiceManagerů
      * NON-RT SAFE: Alokuje paměť a generuje všechna envelope data
-     * 
+     *
+     * Generování běží paralelně (ENVELOPE_INIT_MAX_THREADS vláken) přímo do
+     * finálních souvislých bufferů. Při zadané cestě ke cache se nejprve zkusí
+     * namapovat (mmap) binární cache soubor; pokud chybí nebo nesedí verze či
+     * parametry generátoru, křivky se vygenerují a cache se (best-effort) uloží.
+     *
      * @param logger Reference na Logger pro logování
+     * @param cacheFilePath Cesta k binární cache (prázdná = bez cache)
      * @return true při úspěchu, std::exit(1) při chybě
      */
-    static bool initialize(Logger& logger);
+    static bool initialize(Logger& logger, const std::string& cacheFilePath = std::string());
+
+    /**
+     * @brief Cesta ke cache podle konfigurace (pro initialize())
+     * @return ITHACA_ENVELOPE_CACHE_FILE při ITHACA_ENABLE_ENVELOPE_CACHE 1, jinak prázdná
+     */
+    static std::string getConfiguredCachePath() {
+#if ITHACA_ENABLE_ENVELOPE_CACHE
+        return ITHACA_ENVELOPE_CACHE_FILE;
+#else
+        return std::string();
+#endif
+    }
+
+    /**
+     * @brief Diagnostika: true pokud aktuální data pochází z namapované cache
+     */
+    static bool isMappedFromCache() noexcept;
 
     /**
      * @brief Cleanup: Uvolní všechna statická data
@@ -61,6 +106,26 @@ public:
     static bool getReleaseGains(float* gainBuffer, int numSamples, int position,
                                uint8_t midiValue, int sampleRate) noexcept;
 
+    /**
+     * @brief RT-SAFE: Vyhledá attack tabulku pro (MIDI, sample rate)
+     *
+     * Určeno pro Envelope - volá se jednou na začátku bloku, samotné čtení
+     * z vrácené kopie pak nepotřebuje žádnou validaci.
+     *
+     * @param midiValue MIDI hodnota (0-127)
+     * @param sampleRate Vzorkovací frekvence (44100 nebo 48000)
+     * @return EnvelopeIndex s daty, nebo prázdný (data == nullptr) při neplatném vstupu
+     *         či neinicializovaných datech
+     * @note Ukazatel platí do cleanup()
+     */
+    static EnvelopeIndex getAttackTable(uint8_t midiValue, int sampleRate) noexcept;
+
+    /**
+     * @brief RT-SAFE: Vyhledá release tabulku pro (MIDI, sample rate)
+     * @see getAttackTable()
+     */
+    static EnvelopeIndex getReleaseTable(uint8_t midiValue, int sampleRate) noexcept;
+
     /**
      * @brief RT-SAFE: Vrátí délku attack obálky v milisekundách
      * 
@@ -107,14 +172,8 @@ private:
     static constexpr int SAMPLE_RATE_INDEX_INVALID = -1;
     static constexpr int SAMPLE_RATE_INDEX_44100 = 0;
     static constexpr int SAMPLE_RATE_INDEX_48000 = 1;
-
-    // Struktura pro indexování obálky
-    struct EnvelopeIndex {
-        const float* data;   // Ukazatel na začátek dat obálky
-        int length;          // Počet vzorků v obálce
-        
-        EnvelopeIndex() : data(nullptr), length(0) {}
-    };
+    static constexpr int NUM_ENVELOPE_TYPES = 2;   // attack, release
+    static constexpr uint32_t CACHE_VERSION = 1;   // Zvýšit při změně generátoru nebo formátu
 
     // STATICKÁ DATA - sdílená mezi všemi instance
     static std::vector<float> attack_buffer_[NUM_SAMPLE_RATES];
@@ -133,15 +192,55 @@ private:
     static float calculateTau(uint8_t midi) noexcept;
 
     /**
-     * @brief Generuje obálky pro zadanou vzorkovací frekvenci
+     * @brief Spočítá délky všech obálek, alokuje souvislé buffery a nastaví indexy
+     */
+    static void layoutEnvelopeForSampleRate(int sampleRate, Logger& logger);
+
+    /**
+     * @brief Vyplní všechny obálky přímo do finálních bufferů (paralelně)
+     */
+    static void fillEnvelopesParallel(Logger& logger);
+
+    /**
+     * @brief Počet vzorků obálky po oříznutí na konvergenci (binární hledání)
+     *
+     * Křivka je monotónní, první vzorek za prahem se najde v O(log n)
+     * vyhodnoceních místo generování celé křivky.
+     */
+    static int calculateEnvelopeLength(uint8_t midi, int sampleRate, bool attack) noexcept;
+
+    /**
+     * @brief Vygeneruje jednu obálku do cílové paměti (attack nebo release)
+     */
+    static void fillSingleEnvelope(float* out, int length, uint8_t midi, int sampleRate,
+                                   bool attack) noexcept;
+
+    /**
+     * @brief Hodnota i-tého vzorku (před oříznutím) - sdílená délkou i plněním
+     */
+    static float envelopeSampleValue(int i, float tau, float t_stable, int numSamples,
+                                     bool attack) noexcept;
+
+    /**
+     * @brief Počet vzorků před oříznutím na konvergenci a čas t_stable
+     */
+    static int calculateUntrimmedLength(uint8_t midi, int sampleRate, float& t_stable) noexcept;
+
+    /**
+     * @brief Binární cache: namapuje soubor a nastaví indexy do mapované paměti
+     * @return true pokud cache existuje a odpovídá verzi i parametrům generátoru
+     */
+    static bool loadCache(const std::string& path, Logger& logger);
+
+    /**
+     * @brief Binární cache: uloží vygenerovaná data (tmp soubor + rename)
      */
-    static void generateEnvelopeForSampleRate(int sampleRate, Logger& logger);
+    static void saveCache(const std::string& path, Logger& logger);
 
     /**
-     * @brief Generuje jednu obálku (attack nebo release)
+     * @brief Uvolní mapovanou cache (pokud je namapovaná)
      */
-    static std::pair<std::vector<float>, int> generateSingleEnvelope(
-        uint8_t midi, int sampleRate, const std::string& envelope_type);
+    static void releaseCacheMapping() noexcept;
 
     /**
      * @brief Pomocné funkce pro indexování
@@ -161,6 +260,6 @@ private:
     /**
      * @brief Logging helpers
      */
-    static void logEnvelopeData(const std::vector<float>& data, const std::string& type,
+    static void logEnvelopeData(const float* data, int size, const std::string& type,
                                int sampleRate, uint8_t midi_value, Logger& logger);
 };
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include "instrument_loader.h"
 #include "sine_wave_generator.h"
 #include "sample_rate_converter.h"
+#include "common/simd_dispatch.h"
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
@@ -143,6 +146,7 @@ void InstrumentLoader::loadInstrumentData(SamplerIO& sampler, int targetSampleRa
                 instruments_[midi].frame_count_stereo[vel] = 0;
                 instruments_[midi].total_samples_stereo[vel] = 0;
                 instruments_[midi].was_originally_mono[vel] = false;
+                freeTailPeakProfile(instruments_[midi], vel);
 
                 std::string missingMsg = "Sample for MIDI " + std::to_string(midi) +
                     " velocity " + std::to_string(vel) +
@@ -265,6 +269,9 @@ void InstrumentLoader::loadSineWaveData(int targetSampleRate, Logger& logger) {
             instruments_[midi].total_samples_stereo[vel] = totalSamples;
             instruments_[midi].was_originally_mono[vel] = false;  // Sine is always stereo
 
+            // Tail loudness profile for audibility-based voice termination
+            buildTailPeakProfile(static_cast<uint8_t>(vel), static_cast<uint8_t>(midi), logger);
+
             // Note: sample_ptr_sampleInfo[vel] stays nullptr (no WAV file metadata)
 
             generatedSamples++;
@@ -322,6 +329,7 @@ void InstrumentLoader::clear(Logger& logger) {
                 instruments_[midi].frame_count_stereo[vel] = 0;
                 instruments_[midi].total_samples_stereo[vel] = 0;
                 instruments_[midi].was_originally_mono[vel] = false;
+                freeTailPeakProfile(instruments_[midi], vel);
                 
                 freedCount++;
             }
@@ -364,6 +372,7 @@ void InstrumentLoader::clearWithoutLogging() {
                 instruments_[midi].frame_count_stereo[vel] = 0;
                 instruments_[midi].total_samples_stereo[vel] = 0;
                 instruments_[midi].was_originally_mono[vel] = false;
+                freeTailPeakProfile(instruments_[midi], vel);
             }
         }
     }
@@ -375,6 +384,57 @@ void InstrumentLoader::clearWithoutLogging() {
     actual_samplerate_ = 0;
 }
 
+/**
+ * @brief Spočítá profil hlasitosti dozvuku (suffix maximum po blocích)
+ * Volá se po přiřazení finálního bufferu - sine i WAV cesta.
+ */
+void InstrumentLoader::buildTailPeakProfile(uint8_t velocity, uint8_t midi_note, Logger& logger) {
+    Instrument& inst = instruments_[midi_note];
+    freeTailPeakProfile(inst, velocity);
+
+    const float* data = inst.sample_ptr_velocity[velocity];
+    const int frames = inst.frame_count_stereo[velocity];
+    if (!data || frames <= 0) {
+        return;
+    }
+
+    const int blockCount = (frames + TAIL_PEAK_BLOCK_FRAMES - 1) / TAIL_PEAK_BLOCK_FRAMES;
+    float* profile = static_cast<float*>(malloc(blockCount * sizeof(float)));
+    if (!profile) {
+        logger.log("InstrumentLoader/buildTailPeakProfile", LogSeverity::Error,
+                   "Memory allocation error for tail profile MIDI " + std::to_string(midi_note) +
+                   " velocity " + std::to_string(velocity));
+        std::exit(1);
+    }
+
+    // Krok 1: špička každého bloku přes oba kanály
+    for (int b = 0; b < blockCount; ++b) {
+        const int start = b * TAIL_PEAK_BLOCK_FRAMES;
+        const int end = std::min(start + TAIL_PEAK_BLOCK_FRAMES, frames);
+        float peak = 0.0f;
+        for (int i = start * 2; i < end * 2; ++i) {
+            peak = std::max(peak, std::fabs(data[i]));
+        }
+        profile[b] = peak;
+    }
+
+    // Krok 2: suffix maximum - úroveň, kterou sample od bloku b ještě dosáhne
+    for (int b = blockCount - 2; b >= 0; --b) {
+        profile[b] = std::max(profile[b], profile[b + 1]);
+    }
+
+    inst.tail_peak_velocity[velocity] = profile;
+    inst.tail_peak_block_count[velocity] = blockCount;
+}
+
+void InstrumentLoader::freeTailPeakProfile(Instrument& instrument, int velocity) {
+    if (instrument.tail_peak_velocity[velocity]) {
+        free(instrument.tail_peak_velocity[velocity]);
+        instrument.tail_peak_velocity[velocity] = nullptr;
+    }
+    instrument.tail_peak_block_count[velocity] = 0;
+}
+
 /**
  * @brief Načte jeden sample do bufferu
  * Kompletní pipeline: otevření souboru, alokace, načtení, konverze, přiřazení.
@@ -456,10 +516,7 @@ bool InstrumentLoader::loadSampleToBuffer(int sampleIndex, uint8_t velocity, uin
     
     if (channelCount == 1) {
         // MONO → STEREO konverze: duplikace mono dat do obou kanálů (L=R)
-        for (int frame = 0; frame < frameCount; frame++) {
-            permanentBuffer[frame * 2] = tempBuffer[frame];     // L kanál
-            permanentBuffer[frame * 2 + 1] = tempBuffer[frame]; // R kanál (duplikace)
-        }
+        SimdDispatch::kernels().interleaveStereo(tempBuffer, tempBuffer, permanentBuffer, frameCount);
         logger.log("InstrumentLoader/loadSampleToBuffer", LogSeverity::Info, 
                    "Mono to stereo conversion performed (L=R duplication): " + std::string(filename));
         
@@ -472,10 +529,8 @@ bool InstrumentLoader::loadSampleToBuffer(int sampleIndex, uint8_t velocity, uin
                        std::string(filename));
         } else {
             // Non-interleaved → interleaved konverze
-            for (int frame = 0; frame < frameCount; frame++) {
-                permanentBuffer[frame * 2] = tempBuffer[frame];                    // L kanál
-                permanentBuffer[frame * 2 + 1] = tempBuffer[frameCount + frame];   // R kanál
-            }
+            SimdDispatch::kernels().interleaveStereo(tempBuffer, tempBuffer + frameCount,
+                                                     permanentBuffer, frameCount);
             logger.log("InstrumentLoader/loadSampleToBuffer", LogSeverity::Info, 
                        "Non-interleaved to interleaved stereo conversion performed: " + 
                        std::string(filename));
@@ -491,10 +546,8 @@ bool InstrumentLoader::loadSampleToBuffer(int sampleIndex, uint8_t velocity, uin
             }
         } else {
             // Non-interleaved multi-channel: [L...][R...][C...] → [L1,R1,L2,R2...]
-            for (int frame = 0; frame < frameCount; frame++) {
-                permanentBuffer[frame * 2] = tempBuffer[frame];                    // L kanál
-                permanentBuffer[frame * 2 + 1] = tempBuffer[frameCount + frame];   // R kanál
-            }
+            SimdDispatch::kernels().interleaveStereo(tempBuffer, tempBuffer + frameCount,
+                                                     permanentBuffer, frameCount);
         }
         logger.log("InstrumentLoader/loadSampleToBuffer", LogSeverity::Info, 
                    "Multi-channel to stereo conversion performed (using L+R channels): " + 
@@ -553,6 +606,9 @@ bool InstrumentLoader::loadSampleToBuffer(int sampleIndex, uint8_t velocity, uin
     instruments_[midi_note].frame_count_stereo[velocity]    = finalFrameCount;
     instruments_[midi_note].total_samples_stereo[velocity]  = finalFrameCount * 2;
     instruments_[midi_note].was_originally_mono[velocity]   = wasOriginallyMono;
+
+    // Profil hlasitosti dozvuku (pro předčasné ukončení neslyšitelných hlasů)
+    buildTailPeakProfile(velocity, midi_note, logger);
     
     // Počítání mono/stereo statistik (podle původního formátu)
     if (wasOriginallyMono) {
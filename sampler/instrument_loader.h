@@ -12,6 +12,11 @@
 #define MIDI_NOTE_MAX 127
 #define MAX_VELOCITY_LAYERS 8  // Maximální kapacita pole (pro alokaci)
 
+// Granularita profilu hlasitosti dozvuku (počet stereo framů na jeden blok profilu)
+#ifndef TAIL_PEAK_BLOCK_FRAMES
+#define TAIL_PEAK_BLOCK_FRAMES 1024
+#endif
+
 /**
  * @struct Instrument
  * @brief Reprezentuje jeden MIDI note (index 0-127) s vrstvami pro velocity 0-7.
@@ -49,6 +54,14 @@ struct Instrument {
 
     // Indikátor původního formátu před konverzí (true = byl mono, false = byl stereo)
     bool was_originally_mono[MAX_VELOCITY_LAYERS];
+
+    // Profil hlasitosti dozvuku pro velocity 0-7 (počítá se při načtení, malloc)
+    // tail_peak_velocity[vel][b] = max |vzorek| od bloku b (po TAIL_PEAK_BLOCK_FRAMES)
+    // do konce samplu, tj. nejvyšší úroveň, kterou sample od dané pozice ještě dosáhne
+    float* tail_peak_velocity[MAX_VELOCITY_LAYERS];
+
+    // Počet bloků v profilu dozvuku
+    int tail_peak_block_count[MAX_VELOCITY_LAYERS];
     
     /**
      * @brief Konstruktor - inicializuje všechny pointery na nullptr a flags na false
@@ -61,6 +74,8 @@ struct Instrument {
             frame_count_stereo[i] = 0;
             total_samples_stereo[i] = 0;
             was_originally_mono[i] = false;
+            tail_peak_velocity[i] = nullptr;
+            tail_peak_block_count[i] = 0;
         }
     }
     
@@ -115,6 +130,25 @@ struct Instrument {
         }
         return was_originally_mono[velocity];
     }
+
+    /**
+     * @brief Getter pro špičkovou úroveň zbytku samplu
+     * @param velocity Velocity vrstva (0-7)
+     * @param frame Pozice ve stereo framech
+     * @return Max |vzorek| od pozice frame do konce samplu (lineárně, 0.0-1.0+)
+     * Bez profilu vrací 1.0f (konzervativně - hlas se nikdy neukončí předčasně),
+     * za koncem samplu 0.0f.
+     */
+    float get_tail_peak(uint8_t velocity, int frame) const {
+        if (velocity >= MAX_VELOCITY_LAYERS || !tail_peak_velocity[velocity]) {
+            return 1.0f;
+        }
+        const int block = frame / TAIL_PEAK_BLOCK_FRAMES;
+        if (block >= tail_peak_block_count[velocity]) {
+            return 0.0f;
+        }
+        return tail_peak_velocity[velocity][block < 0 ? 0 : block];
+    }
 };
 
 /**
@@ -368,6 +402,24 @@ private:
     bool loadSampleToBuffer(int sampleIndex, uint8_t velocity, uint8_t midi_note,
                             int sourceRate, int targetRate, Logger& logger);
 
+    /**
+     * @brief Spočítá profil hlasitosti dozvuku pro načtený sample
+     * @param velocity Velocity vrstva (0-7)
+     * @param midi_note MIDI nota (0-127)
+     * @param logger Reference na Logger pro zaznamenávání
+     *
+     * Pro každý blok TAIL_PEAK_BLOCK_FRAMES framů spočítá max |L|,|R| a poté
+     * zpětným průchodem suffix maximum (úroveň od bloku do konce samplu).
+     * Výsledek slouží Voice k předčasnému ukončení neslyšitelných hlasů.
+     * Při chybě alokace: log error a std::exit(1).
+     */
+    void buildTailPeakProfile(uint8_t velocity, uint8_t midi_note, Logger& logger);
+
+    /**
+     * @brief Uvolní profil dozvuku jedné vrstvy (bezpečné i pro nullptr)
+     */
+    void freeTailPeakProfile(Instrument& instrument, int velocity);
+
     /**
      * @brief Otevře sample soubor pro čtení
      * @param sampleIndex Index samplu v SamplerIO
@@ -68,6 +68,35 @@ float LfoPanning::getSineValue(float phase) noexcept {
     return sine_table[index] + fraction * (sine_table[next_index] - sine_table[index]);
 }
 
+float LfoPanning::getSineValueFixed(uint32_t phase) noexcept {
+    // Horní bity = index do tabulky, dolní bity = interpolační zlomek
+    const uint32_t index = phase >> SINE_FRACTION_BITS;
+    const uint32_t next_index = (index + 1) & (SINE_TABLE_SIZE - 1);
+    const float fraction = static_cast<float>(phase & ((1u << SINE_FRACTION_BITS) - 1)) *
+                           (1.0f / static_cast<float>(1u << SINE_FRACTION_BITS));
+
+    return sine_table[index] + fraction * (sine_table[next_index] - sine_table[index]);
+}
+
+uint32_t LfoPanning::calculatePhaseIncrementFixed(float frequency, int sampleRate) noexcept {
+    if (sampleRate <= 0 || frequency <= 0.0f) return 0;
+
+    // Podíl periody na vzorek; frekvence LFO (max 2 Hz) je hluboko pod Nyquistem
+    const double cycles = static_cast<double>(frequency) / static_cast<double>(sampleRate);
+    return static_cast<uint32_t>(std::min(cycles, 0.5) * PHASE_FIXED_SCALE);
+}
+
+void LfoPanning::getConstantPowerGains(float pan, float& leftGain, float& rightGain) noexcept {
+    pan = std::max(-1.0f, std::min(1.0f, pan));
+
+    // Úhel (pan + 1) * π/4 v rozsahu 0..π/2 = 0..2^30 ve fixed-point fázi
+    constexpr float QUARTER_TURN = 1073741824.0f;
+    const uint32_t angle = static_cast<uint32_t>((pan + 1.0f) * (QUARTER_TURN * 0.5f));
+
+    leftGain = getSineValueFixed(angle + (1u << 30));  // cos = sin(x + π/2)
+    rightGain = getSineValueFixed(angle);
+}
+
 float LfoPanning::calculatePhaseIncrement(float frequency, int sampleRate) noexcept {
     if (sampleRate <= 0 || frequency < 0.0f) return 0.0f;
     
@@ -43,6 +43,33 @@ public:
      */
     static float getSineValue(float phase) noexcept;
 
+    /**
+     * @brief Získá hodnotu sinusovky pro fázi ve fixed-point formátu
+     * @param phase Fáze jako uint32_t (2^32 = 2π, přetečení = wrap)
+     * @return Sinusová hodnota (-1.0 až +1.0)
+     * @note RT-safe: horních 13 bitů indexuje tabulku, zbytek je lineární
+     *       interpolace - bez floor, clamp a wrapPhase
+     */
+    static float getSineValueFixed(uint32_t phase) noexcept;
+
+    /**
+     * @brief Vypočítá fixed-point přírůstek fáze na vzorek (2^32 = 2π)
+     * @param frequency Frekvence LFO v Hz
+     * @param sampleRate Vzorkovací frekvence v Hz
+     * @return Přírůstek fáze na vzorek
+     * @note RT-safe: přímý výpočet, volá se jednou za segment
+     */
+    static uint32_t calculatePhaseIncrementFixed(float frequency, int sampleRate) noexcept;
+
+    /**
+     * @brief Konstantní výkonové gainy pro pozici panoramy
+     * @param pan Pozice (-1.0 = vlevo, 0.0 = střed, +1.0 = vpravo)
+     * @param leftGain Výstup: cos((pan + 1) * π/4)
+     * @param rightGain Výstup: sin((pan + 1) * π/4)
+     * @note RT-safe: spojitý zákon přes sinusovou tabulku (střed = 0.7071 / 0.7071)
+     */
+    static void getConstantPowerGains(float pan, float& leftGain, float& rightGain) noexcept;
+
     /**
      * @brief Vypočítá přírůstek fáze na vzorek pro danou frekvenci
      * @param frequency Frekvence LFO v Hz
@@ -75,10 +102,15 @@ public:
     // Veřejná konstanta pro externí výpočty fází
     static constexpr float TWO_PI = 6.283185307179586f;
 
+    // Fixed-point fáze: celý rozsah uint32_t odpovídá jedné periodě (2π)
+    static constexpr double PHASE_FIXED_SCALE = 4294967296.0;
+
 private:
     // Velikosti lookup tabulek
     static constexpr int MIDI_TABLE_SIZE = 128;
-    static constexpr int SINE_TABLE_SIZE = 8192; // Zvýšeno pro vyšší přesnost
+    static constexpr int SINE_TABLE_BITS = 13;
+    static constexpr int SINE_TABLE_SIZE = 1 << SINE_TABLE_BITS; // 8192 - zvýšeno pro vyšší přesnost
+    static constexpr int SINE_FRACTION_BITS = 32 - SINE_TABLE_BITS;
     
     // Předpočítané lookup tabulky
     static float frequency_table[MIDI_TABLE_SIZE];
@@ -0,0 +1,63 @@
+#ifndef MIDI_EVENT_H
+#define MIDI_EVENT_H
+
+#include <cstdint>
+
+/**
+ * @file midi_event.h
+ * @brief Časově označená MIDI událost pro sample-accurate zpracování
+ *
+ * Události předává host do VoiceManager::processBlock() jako pole
+ * seřazené podle sampleOffset. VoiceManager si blok sám rozdělí na
+ * segmenty mezi událostmi - integrátor už nemusí volat
+ * processBlockSegment()/finalizeBlock() ručně.
+ */
+
+/**
+ * @enum MidiEventType
+ * @brief Typ události - odpovídá jednotlivým *MIDI setterům VoiceManageru
+ */
+enum class MidiEventType : uint8_t {
+    NoteOn,             // data1 = MIDI nota, data2 = velocity
+    NoteOff,            // data1 = MIDI nota, data2 = release velocity (ignorováno)
+    SustainPedal,       // data1 = CC64 hodnota (>= 64 = pedál dole)
+    MasterGain,         // data1 = 0-127 → setPartMasterGainMIDI(channel)
+    Pan,                // data1 = 0-127 → setPartPanMIDI(channel)
+    Attack,             // data1 = 0-127 → setPartAttackMIDI(channel)
+    Release,            // data1 = 0-127 → setPartReleaseMIDI(channel)
+    SustainLevel,       // data1 = 0-127 → setPartSustainLevelMIDI(channel)
+    StereoField,        // data1 = 0-127 → setPartStereoFieldAmountMIDI(channel)
+    PanSpeed,           // data1 = 0-127 → setAllVoicesPanSpeedMIDI
+    PanDepth,           // data1 = 0-127 → setAllVoicesPanDepthMIDI
+    LimiterThreshold,   // data1 = 0-127 → setLimiterThresholdMIDI
+    LimiterRelease,     // data1 = 0-127 → setLimiterReleaseMIDI
+    LimiterEnabled,     // data1 = 0-127 → setLimiterEnabledMIDI
+    BBEDefinition,      // data1 = 0-127 → setBBEDefinitionMIDI
+    BBEBassBoost        // data1 = 0-127 → setBBEBassBoostMIDI
+};
+
+/**
+ * @struct MidiEvent
+ * @brief Jedna událost s pozicí uvnitř audio bloku
+ *
+ * sampleOffset je relativní k začátku bloku (0 .. samplesPerBlock-1).
+ * Hodnoty mimo rozsah jsou ořezány - záporné na 0, příliš velké na poslední vzorek.
+ * channel vybírá part v multi-timbral režimu (0-15, viz VoiceManager::setPartCount());
+ * v klasickém režimu se ignoruje (omni). Globální události (LFO, DSP) jej ignorují vždy.
+ * Velikost 8 bytů, POD - vhodné pro předalokovaná pole v audio threadu.
+ */
+struct MidiEvent {
+    int sampleOffset;
+    MidiEventType type;
+    uint8_t data1;
+    uint8_t data2;
+    uint8_t channel;
+
+    MidiEvent() : sampleOffset(0), type(MidiEventType::NoteOn), data1(0), data2(0), channel(0) {}
+    MidiEvent(int offset, MidiEventType t, uint8_t d1, uint8_t d2 = 0, uint8_t ch = 0)
+        : sampleOffset(offset), type(t), data1(d1), data2(d2), channel(ch) {}
+};
+
+static_assert(sizeof(MidiEvent) == 8, "MidiEvent must stay 8 bytes");
+
+#endif // MIDI_EVENT_H
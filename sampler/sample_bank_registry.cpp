@@ -0,0 +1,96 @@
+#include "sample_bank_registry.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <system_error>
+
+// ===== STATIC STATE =====
+
+std::mutex SampleBankRegistry::mutex_;
+std::map<SampleBankRegistry::BankKey, std::weak_ptr<const SampleBank>> SampleBankRegistry::banks_;
+
+// ===== PUBLIC API =====
+
+std::shared_ptr<const SampleBank> SampleBankRegistry::acquire(const std::string& sampleDir, int sampleRate,
+                                                              int velocityLayerCount, Logger& logger) {
+    const std::string directory = canonicalDirectory(sampleDir);
+    const BankKey key(directory, sampleRate, velocityLayerCount);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Úklid záznamů bank, které už nikdo nedrží
+    for (auto it = banks_.begin(); it != banks_.end();) {
+        if (it->second.expired()) it = banks_.erase(it);
+        else ++it;
+    }
+
+    auto found = banks_.find(key);
+    if (found != banks_.end()) {
+        if (std::shared_ptr<const SampleBank> bank = found->second.lock()) {
+            logger.log("SampleBankRegistry/acquire", LogSeverity::Info,
+                       "Sharing loaded bank '" + (directory.empty() ? std::string("<sine>") : directory) +
+                       "' at " + std::to_string(sampleRate) + " Hz, " +
+                       std::to_string(velocityLayerCount) + " velocity layers (" +
+                       std::to_string(bank.use_count() - 1) + " other users)");
+            return bank;
+        }
+    }
+
+    std::shared_ptr<const SampleBank> bank = loadBank(directory, sampleRate, velocityLayerCount, logger);
+    banks_[key] = bank;
+    return bank;
+}
+
+int SampleBankRegistry::getLoadedBankCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    int count = 0;
+    for (const auto& entry : banks_) {
+        if (!entry.second.expired()) ++count;
+    }
+    return count;
+}
+
+// ===== PRIVATE HELPERS =====
+
+std::string SampleBankRegistry::canonicalDirectory(const std::string& sampleDir) {
+    if (sampleDir.empty()) return std::string();
+
+    std::error_code ec;
+    const std::filesystem::path canonical = std::filesystem::weakly_canonical(sampleDir, ec);
+    if (ec) return sampleDir;  // Nelze kanonizovat - klíčem zůstane zadaná cesta
+
+    return canonical.string();
+}
+
+std::shared_ptr<const SampleBank> SampleBankRegistry::loadBank(const std::string& directory, int sampleRate,
+                                                               int velocityLayerCount, Logger& logger) {
+    logger.log("SampleBankRegistry/loadBank", LogSeverity::Info,
+               "Loading new bank '" + (directory.empty() ? std::string("<sine>") : directory) + "' at " +
+               std::to_string(sampleRate) + " Hz, " + std::to_string(velocityLayerCount) + " velocity layers");
+
+    std::shared_ptr<SampleBank> bank(new SampleBank());
+    bank->directory_ = directory;
+    bank->instrumentLoader_.setVelocityLayerCount(velocityLayerCount);
+
+    if (directory.empty()) {
+        bank->instrumentLoader_.loadSineWaveData(sampleRate, logger);
+        return bank;
+    }
+
+    bank->samplerIO_.scanSampleDirectory(directory, logger);
+    if (bank->samplerIO_.getLoadedSampleList().empty()) {
+        const std::string errorMsg = "[SampleBankRegistry/loadBank] error: No valid samples found in directory '" + directory + "'";
+        logger.log("SampleBankRegistry/loadBank", LogSeverity::Error, errorMsg);
+        std::exit(1);
+    }
+
+    bank->instrumentLoader_.loadInstrumentData(bank->samplerIO_, sampleRate, logger);
+    if (bank->instrumentLoader_.getTotalLoadedSamples() == 0) {
+        const std::string errorMsg = "[SampleBankRegistry/loadBank] error: Failed to load any instrument data";
+        logger.log("SampleBankRegistry/loadBank", LogSeverity::Error, errorMsg);
+        std::exit(1);
+    }
+
+    return bank;
+}
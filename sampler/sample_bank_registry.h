@@ -0,0 +1,109 @@
+#ifndef SAMPLE_BANK_REGISTRY_H
+#define SAMPLE_BANK_REGISTRY_H
+
+#include "sampler.h"
+#include "instrument_loader.h"
+#include "core_logger.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+/**
+ * @class SampleBank
+ * @brief Jedna načtená banka samplů (SamplerIO + InstrumentLoader) sdílená mezi instancemi
+ *
+ * Po načtení je banka pouze ke čtení - hlasy dostávají const Instrument& a
+ * const InstrumentLoader*, takže ji může souběžně číst libovolný počet
+ * VoiceManagerů (i z různých audio threadů) bez synchronizace.
+ *
+ * @note Vytváří ji výhradně SampleBankRegistry. Objekt se nepřesouvá
+ *       (InstrumentLoader drží pointer na vlastní SamplerIO).
+ */
+class SampleBank {
+public:
+    SampleBank(const SampleBank&) = delete;
+    SampleBank& operator=(const SampleBank&) = delete;
+
+    const InstrumentLoader& getInstrumentLoader() const { return instrumentLoader_; }
+
+    const Instrument& getInstrumentNote(uint8_t midi_note) const {
+        return instrumentLoader_.getInstrumentNote(midi_note);
+    }
+
+    int getSampleRate() const { return instrumentLoader_.getActualSampleRate(); }
+
+    /**
+     * @brief Adresář banky (kanonický), prázdný řetězec = sinusový fallback
+     */
+    const std::string& getDirectory() const { return directory_; }
+
+private:
+    friend class SampleBankRegistry;
+
+    SampleBank() = default;
+
+    std::string directory_;
+    SamplerIO samplerIO_;
+    InstrumentLoader instrumentLoader_;
+};
+
+/**
+ * @class SampleBankRegistry
+ * @brief Procesově globální registr načtených bank s počítáním referencí
+ *
+ * Klíčem je (kanonický adresář, sample rate, počet velocity vrstev). První
+ * acquire() banku naskenuje a načte, další instance se stejným klíčem dostanou
+ * tutéž banku bez dalšího načítání a paměti. Banka se uvolní ve chvíli, kdy
+ * poslední držitel pustí svůj shared_ptr (registr drží jen weak_ptr).
+ *
+ * Prázdný adresář znamená sinusový fallback (InstrumentLoader::loadSineWaveData),
+ * sdílený stejným mechanismem.
+ *
+ * @note Non-RT: acquire() alokuje a načítá soubory, uvolnění banky volá free().
+ *       Souběžné acquire() jsou serializovány mutexem - stejný klíč se tak
+ *       nikdy nenačítá dvakrát.
+ * @note Chyby načítání (prázdný adresář se samply, žádný načtený sample) vedou
+ *       stejně jako dříve k error logu a std::exit(1).
+ */
+class SampleBankRegistry {
+public:
+    /**
+     * @brief Vrátí sdílenou banku pro daný klíč, případně ji načte
+     * @param sampleDir Adresář se samply (prázdný = sinusový fallback)
+     * @param sampleRate Cílová frekvence vzorkování (44100 nebo 48000 Hz)
+     * @param velocityLayerCount Počet velocity vrstev (1-8)
+     * @param logger Reference na Logger
+     * @return Sdílená read-only banka (nikdy nullptr)
+     * @note Non-RT
+     */
+    static std::shared_ptr<const SampleBank> acquire(const std::string& sampleDir, int sampleRate,
+                                                     int velocityLayerCount, Logger& logger);
+
+    /**
+     * @brief Počet aktuálně načtených (živých) bank
+     * @note Diagnostika, non-RT
+     */
+    static int getLoadedBankCount();
+
+private:
+    using BankKey = std::tuple<std::string, int, int>;
+
+    static std::mutex mutex_;
+    static std::map<BankKey, std::weak_ptr<const SampleBank>> banks_;
+
+    /**
+     * @brief Kanonická podoba cesty (různé zápisy stejného adresáře = jeden klíč)
+     */
+    static std::string canonicalDirectory(const std::string& sampleDir);
+
+    /**
+     * @brief Naskenuje a načte novou banku (volá se pod mutexem)
+     */
+    static std::shared_ptr<const SampleBank> loadBank(const std::string& directory, int sampleRate,
+                                                      int velocityLayerCount, Logger& logger);
+};
+
+#endif // SAMPLE_BANK_REGISTRY_H
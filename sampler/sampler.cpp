@@ -20,7 +20,7 @@ int runSampler(Logger& logger) {
     try {
         // FÁZE 0: KRITICKÁ - Globální inicializace envelope dat
         logger.log("runSampler", LogSeverity::Info, "Initializing envelope static data...");
-        if (!EnvelopeStaticData::initialize(logger)) {
+        if (!EnvelopeStaticData::initialize(logger, EnvelopeStaticData::getConfiguredCachePath())) {
             logger.log("runSampler", LogSeverity::Error, "Failed to initialize envelope static data");
             return 1;
         }
@@ -47,7 +47,91 @@ int runSampler(Logger& logger) {
             logger.log("runSampler", LogSeverity::Error, "Basic functionality verification failed");
             return 1;
         }
+
+        // FÁZE 5b: Regrese denormálů - žádné subnormální hodnoty během tichého doznívání
+        if (!runDenormalTailTest(voiceManager, logger)) {
+            logger.log("runSampler", LogSeverity::Error, "Denormal tail test failed");
+            return 1;
+        }
         
+        // FÁZE 5c: Audibility culling - rozhodnutí o ukončení hlasu
+        if (!runVoiceRetireTest(logger)) {
+            logger.log("runSampler", LogSeverity::Error, "Voice retire test failed");
+            return 1;
+        }
+
+        // FÁZE 5d: Idle fast path - přeskočení LFO/DSP bez změny výstupu
+        if (!runIdleFastPathTest(logger)) {
+            logger.log("runSampler", LogSeverity::Error, "Idle fast path test failed");
+            return 1;
+        }
+
+        // FÁZE 5e: Multi-timbral party - routing, polyfonie, krádež hlasů
+        if (!runMultiTimbralTest(logger)) {
+            logger.log("runSampler", LogSeverity::Error, "Multi-timbral part test failed");
+            return 1;
+        }
+
+        // FÁZE 5f: Vyhlazení parametrů hlasu po vzorcích
+        if (!runParameterSmoothingTest(logger)) {
+            logger.log("runSampler", LogSeverity::Error, "Voice parameter smoothing test failed");
+            return 1;
+        }
+
+        // FÁZE 5g: BBE - vypnutí bass boostu bez kliknutí
+        if (!runBassBoostSwitchTest(logger)) {
+            logger.log("runSampler", LogSeverity::Error, "BBE bass boost switch test failed");
+            return 1;
+        }
+
+        // FÁZE 5h: DspChain - insert/remove/move souběžně s process()
+        if (!runDspChainStressTest(logger)) {
+            logger.log("runSampler", LogSeverity::Error, "DspChain stress test failed");
+            return 1;
+        }
+
+        // FÁZE 5i: Limiter - fast path vs. per-sample reference
+        if (!runLimiterFastPathTest(logger)) {
+            logger.log("runSampler", LogSeverity::Error, "Limiter fast path test failed");
+            return 1;
+        }
+
+        // FÁZE 5j: Konvoluce - přímá reference, rampa mixu
+        if (!runConvolutionTest(logger)) {
+            logger.log("runSampler", LogSeverity::Error, "Convolution test failed");
+            return 1;
+        }
+
+        // FÁZE 5k: SIMD dispatch - bitová shoda všech úrovní kernelů
+        if (!runSimdDispatchTest(logger)) {
+            logger.log("runSampler", LogSeverity::Error, "SIMD dispatch test failed");
+            return 1;
+        }
+
+        // FÁZE 5l: Render pool - bitová shoda jednoho a více vláken
+        if (!runRenderPoolDeterminismTest(logger)) {
+            logger.log("runSampler", LogSeverity::Error, "Render pool determinism test failed");
+            return 1;
+        }
+
+        // FÁZE 5m: processBlock() - události přesně na svém vzorku
+        if (!runSampleAccurateEventsTest(logger)) {
+            logger.log("runSampler", LogSeverity::Error, "Sample-accurate MIDI events test failed");
+            return 1;
+        }
+
+        // FÁZE 5n: SampleBankRegistry - sdílení a uvolnění bank
+        if (!runSampleBankRegistryTest(logger)) {
+            logger.log("runSampler", LogSeverity::Error, "Sample bank registry test failed");
+            return 1;
+        }
+
+        // FÁZE 5o: Cache obálek - round trip a odmítnutí poškozených souborů
+        if (!runEnvelopeCacheTest(logger)) {
+            logger.log("runSampler", LogSeverity::Error, "Envelope cache test failed");
+            return 1;
+        }
+
         // FÁZE 6: Systémové statistiky
         voiceManager.logSystemStatistics(logger);
         
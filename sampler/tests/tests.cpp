@@ -2,11 +2,31 @@
 #include <memory>
 #include <vector>
 #include <algorithm>
+#include <sstream>
+#include <cmath>
+#include <cstring>
+#include <atomic>
+#include <thread>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
 
 #include "tests.h"
 #include "test_helpers.h"
 #include "../voice_manager.h"
 #include "../voice.h"
+#include "../instrument_loader.h"
+#include "../sample_bank_registry.h"
+#include "../envelopes/envelope.h"
+#include "../envelopes/envelope_static_data.h"
+#include "../voice_params.h"
+#include "common/denormal_guard.h"
+#include "common/simd_dispatch.h"
+#include "dsp/dsp_chain.h"
+#include "dsp/bbe/bbe_processor.h"
+#include "dsp/limiter/limiter.h"
+#include "dsp/convolution/convolution_effect.h"
 
 
 bool verifyBasicFunctionality(VoiceManager& voiceManager, Logger& logger) {
@@ -158,4 +178,1841 @@ bool runSimpleNoteTest(VoiceManager& voiceManager, Logger& logger) {
         logger.log("runSimpleNoteTest", LogSeverity::Error, "Simple note test failed: unknown error");
         return false;
     }
-}
\ No newline at end of file
+}
+
+namespace {
+
+/**
+ * @brief One-pole zpětnovazební filtr, který počítá subnormální hodnoty
+ *
+ * y = x + feedback · y - po utichnutí vstupu stav geometricky klesá přes
+ * subnormální rozsah do nuly. S FTZ/DAZ skočí z nejmenšího normálního
+ * čísla rovnou na 0, bez ochrany projde desítky tisíc subnormálních kroků.
+ * Subnormály se poznají z bitů (porovnání float by při DAZ vrátilo nulu).
+ */
+class DenormalProbeEffect : public DspEffect {
+public:
+    void prepare(int sampleRate, int maxBlockSize) override {
+        (void)sampleRate;
+        (void)maxBlockSize;
+    }
+
+    void reset() noexcept override { state_ = 0.0f; }
+
+    void process(float* leftBuffer, float* rightBuffer, int numSamples) noexcept override {
+        for (int i = 0; i < numSamples; ++i) {
+            if (isSubnormal(leftBuffer[i]) || isSubnormal(rightBuffer[i])) ++subnormalInputs_;
+            state_ = leftBuffer[i] + FEEDBACK * state_;
+            if (isSubnormal(state_)) ++subnormalStates_;
+            if (state_ != 0.0f) reachedZero_ = false;
+            else if (excited_) reachedZero_ = true;
+            if (std::abs(state_) > 1e-3f) excited_ = true;
+        }
+    }
+
+    void setEnabled(bool enabled) noexcept override { (void)enabled; }
+    bool isEnabled() const noexcept override { return true; }
+    bool isTailSilent() const noexcept override { return bitsOf(state_) == 0; }
+    const char* getName() const noexcept override { return "DenormalProbe"; }
+
+    uint64_t getSubnormalInputs() const noexcept { return subnormalInputs_; }
+    uint64_t getSubnormalStates() const noexcept { return subnormalStates_; }
+    bool hasDecayedToZero() const noexcept { return excited_ && reachedZero_; }
+
+private:
+    static constexpr float FEEDBACK = 0.99f;
+
+    static uint32_t bitsOf(float value) noexcept {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits & 0x7FFFFFFFu;
+    }
+
+    static bool isSubnormal(float value) noexcept {
+        const uint32_t bits = bitsOf(value);
+        return bits != 0 && bits < 0x00800000u;     // Nulový exponent, nenulová mantisa
+    }
+
+    float state_ = 0.0f;
+    uint64_t subnormalInputs_ = 0;
+    uint64_t subnormalStates_ = 0;
+    bool excited_ = false;
+    bool reachedZero_ = false;
+};
+
+} // namespace
+
+bool runDenormalTailTest(VoiceManager& voiceManager, Logger& logger) {
+    try {
+        logger.log("runDenormalTailTest", LogSeverity::Info, "Starting denormal tail test");
+
+#if !defined(DENORMAL_GUARD_MXCSR) && !defined(DENORMAL_GUARD_FPCR) && !defined(DENORMAL_GUARD_FPSCR)
+        // Bez FTZ/DAZ (jiná platforma nebo ITHACA_ENABLE_DENORMAL_PROTECTION 0) subnormály vznikat smí
+        logger.log("runDenormalTailTest", LogSeverity::Info, "Denormal protection not available in this build - test skipped");
+        return true;
+#else
+        // Testovací parametry
+        const uint8_t chordNotes[] = { 48, 55, 60, 64, 67 };
+        const uint8_t testVelocity = 100;
+        const int blockSize = 512;
+        const int sampleRate = voiceManager.getCurrentSampleRate();
+        const double sustainDurationSec = 0.5;   // Znějící akord nabudí zpětnou vazbu
+        const double maxTailDurationSec = 10.0;  // Limit doznívání do úplné nuly
+
+        const int sustainBlocks = calculateBlocksForDuration(sustainDurationSec, sampleRate, blockSize);
+        const int maxTailBlocks = calculateBlocksForDuration(maxTailDurationSec, sampleRate, blockSize);
+
+        std::vector<float> leftBuffer(blockSize, 0.0f);
+        std::vector<float> rightBuffer(blockSize, 0.0f);
+
+        // Sonda na konci dynamického řetězce - běží uvnitř RT cesty VoiceManageru
+        DspChain* chain = voiceManager.getDspChain();
+        auto probeOwner = std::make_unique<DenormalProbeEffect>();
+        const DenormalProbeEffect* probe = probeOwner.get();
+        const size_t probeIndex = chain->getEffectCount();
+        chain->addEffect(std::move(probeOwner));
+
+        // Dlouhý release - doznívající obálka sondu plynule utlumí
+        voiceManager.setAllVoicesReleaseMIDI(127);
+
+        for (uint8_t note : chordNotes) {
+            voiceManager.setNoteStateMIDI(note, true, testVelocity);
+        }
+        for (int block = 0; block < sustainBlocks; ++block) {
+            voiceManager.processBlockUninterleaved(leftBuffer.data(), rightBuffer.data(), blockSize);
+        }
+        for (uint8_t note : chordNotes) {
+            voiceManager.setNoteStateMIDI(note, false);
+        }
+
+        // Doznívání, dokud hlasy neutichnou a stav sondy neklesne na nulu
+        int tailBlocks = 0;
+        while (tailBlocks < maxTailBlocks &&
+               (voiceManager.getActiveVoicesCount() > 0 || !probe->hasDecayedToZero())) {
+            voiceManager.processBlockUninterleaved(leftBuffer.data(), rightBuffer.data(), blockSize);
+            ++tailBlocks;
+        }
+
+        const uint64_t subnormalInputs = probe->getSubnormalInputs();
+        const uint64_t subnormalStates = probe->getSubnormalStates();
+        const bool decayed = probe->hasDecayedToZero();
+
+        // Návrat k výchozímu stavu (release viz initializeVoicesWithInstruments)
+        chain->removeEffect(probeIndex);
+        voiceManager.setAllVoicesReleaseMIDI(4);
+
+        logger.log("runDenormalTailTest", LogSeverity::Info,
+                   "Tail blocks: " + std::to_string(tailBlocks) + ", subnormal inputs: " +
+                   std::to_string(subnormalInputs) + ", subnormal feedback states: " + std::to_string(subnormalStates));
+
+        if (subnormalInputs != 0 || subnormalStates != 0) {
+            logger.log("runDenormalTailTest", LogSeverity::Error,
+                       "Denormal tail test failed - subnormal values reached the RT path (FTZ/DAZ not active)");
+            return false;
+        }
+        if (!decayed) {
+            logger.log("runDenormalTailTest", LogSeverity::Error,
+                       "Denormal tail test failed - feedback state did not decay to zero within the tail limit");
+            return false;
+        }
+
+        logger.log("runDenormalTailTest", LogSeverity::Info, "Denormal tail test passed - no subnormals in the tail");
+        return true;
+#endif
+
+    } catch (const std::exception& e) {
+        logger.log("runDenormalTailTest", LogSeverity::Error, "Denormal tail test failed: " + std::string(e.what()));
+        return false;
+    } catch (...) {
+        logger.log("runDenormalTailTest", LogSeverity::Error, "Denormal tail test failed: unknown error");
+        return false;
+    }
+}
+
+/**
+ * @brief Naplní Instrument syntetickým samplem pro všechny velocity vrstvy
+ */
+static void fillTestInstrument(Instrument& instrument, std::vector<float>& stereoData,
+                               std::vector<float>& tailProfile, int frameCount) {
+    for (int layer = 0; layer < 8; ++layer) {
+        instrument.sample_ptr_velocity[layer] = stereoData.data();
+        instrument.velocityExists[layer] = true;
+        instrument.frame_count_stereo[layer] = frameCount;
+        instrument.total_samples_stereo[layer] = frameCount * 2;
+        instrument.tail_peak_velocity[layer] = tailProfile.data();
+        instrument.tail_peak_block_count[layer] = static_cast<int>(tailProfile.size());
+    }
+}
+
+bool runVoiceRetireTest(Logger& logger) {
+    try {
+        logger.log("runVoiceRetireTest", LogSeverity::Info, "Starting voice retire decision test");
+
+        // Testovací parametry
+        const int sampleRate = 48000;
+        const int blockSize = 512;
+        const int frameCount = 4 * sampleRate;        // Délka samplu
+        const int loudFrames = 2 * sampleRate;        // Slyšitelná část, poté -120 dB
+        const float loudLevel = 0.5f;
+        const float quietLevel = 1.0e-6f;
+        const uint8_t testVelocity = 100;
+
+        // Sample: první polovina slyšitelná, druhá pod prahem; profil = max od bloku do konce
+        const int profileBlocks = (frameCount + TAIL_PEAK_BLOCK_FRAMES - 1) / TAIL_PEAK_BLOCK_FRAMES;
+        std::vector<float> loudData(static_cast<size_t>(frameCount) * 2);
+        std::vector<float> loudProfile(static_cast<size_t>(profileBlocks));
+        for (int frame = 0; frame < frameCount; ++frame) {
+            const float level = frame < loudFrames ? loudLevel : quietLevel;
+            loudData[static_cast<size_t>(frame) * 2] = level;
+            loudData[static_cast<size_t>(frame) * 2 + 1] = level;
+        }
+        for (int block = 0; block < profileBlocks; ++block) {
+            loudProfile[static_cast<size_t>(block)] =
+                (block + 1) * TAIL_PEAK_BLOCK_FRAMES <= loudFrames ? loudLevel : quietLevel;
+        }
+
+        std::vector<float> quietData(static_cast<size_t>(frameCount) * 2, quietLevel);
+        std::vector<float> quietProfile(static_cast<size_t>(profileBlocks), quietLevel);
+
+        Instrument loudInstrument;
+        Instrument quietInstrument;
+        fillTestInstrument(loudInstrument, loudData, loudProfile, frameCount);
+        fillTestInstrument(quietInstrument, quietData, quietProfile, frameCount);
+
+        std::vector<float> leftBuffer(blockSize, 0.0f);
+        std::vector<float> rightBuffer(blockSize, 0.0f);
+        auto processVoice = [&](Voice& voice) {
+            std::fill(leftBuffer.begin(), leftBuffer.end(), 0.0f);
+            std::fill(rightBuffer.begin(), rightBuffer.end(), 0.0f);
+            voice.processBlock(leftBuffer.data(), rightBuffer.data(), blockSize);
+            float peak = 0.0f;
+            for (int i = 0; i < blockSize; ++i) {
+                peak = std::max(peak, std::max(std::abs(leftBuffer[i]), std::abs(rightBuffer[i])));
+            }
+            return peak;
+        };
+
+        bool passed = true;
+
+        // ===== 1. MASTER GAIN 0 NEUKONČÍ DRŽENOU NOTU =====
+
+        Envelope envelope;
+        Voice voice(60);
+        voice.initialize(loudInstrument, sampleRate, envelope, logger, nullptr);
+        voice.prepareToPlay(blockSize);
+        voice.setMasterGain(0.0f);
+        voice.setNoteState(true, testVelocity);
+
+        const int muteBlocks = calculateBlocksForDuration(1.0, sampleRate, blockSize);
+        for (int block = 0; block < muteBlocks; ++block) {
+            processVoice(voice);
+            if (voice.isRetiring() || !voice.isActive()) {
+                logger.log("runVoiceRetireTest", LogSeverity::Error,
+                           "Held note retired while master gain was 0 (block " + std::to_string(block) + ")");
+                passed = false;
+                break;
+            }
+        }
+
+        voice.setMasterGain(1.0f);
+        float restoredPeak = 0.0f;
+        const int restoreBlocks = calculateBlocksForDuration(0.2, sampleRate, blockSize);
+        for (int block = 0; block < restoreBlocks; ++block) {
+            restoredPeak = processVoice(voice);
+        }
+        if (restoredPeak < 0.1f * loudLevel) {
+            logger.log("runVoiceRetireTest", LogSeverity::Error,
+                       "Held note silent after master gain restore (peak " + std::to_string(restoredPeak) + ")");
+            passed = false;
+        }
+
+        // ===== 2. TICHÝ ZBYTEK SAMPLU HLAS UKONČÍ =====
+
+        // Držená nota dojde do tiché části - musí skončit krátce za hranicí, ne na konci samplu
+        const int maxRetireBlock = (loudFrames + TAIL_PEAK_BLOCK_FRAMES) / blockSize + 2;
+        int processedBlocks = muteBlocks + restoreBlocks;
+        while (voice.isActive() && processedBlocks * blockSize < frameCount) {
+            processVoice(voice);
+            ++processedBlocks;
+        }
+        if (voice.isActive() || processedBlocks > maxRetireBlock) {
+            logger.log("runVoiceRetireTest", LogSeverity::Error,
+                       "Inaudible held note not retired in time (block " + std::to_string(processedBlocks) +
+                       ", limit " + std::to_string(maxRetireBlock) + ")");
+            passed = false;
+        }
+
+        // ===== 3. ATTACK SE NEUKONČÍ NIKDY =====
+
+        Envelope slowEnvelope;
+        Voice attackVoice(61);
+        attackVoice.initialize(quietInstrument, sampleRate, slowEnvelope, logger, nullptr, 127);
+        attackVoice.prepareToPlay(blockSize);
+        attackVoice.setNoteState(true, testVelocity);
+
+        int attackBlocks = 0;
+        const int maxBlocks = frameCount / blockSize;
+        while (attackVoice.getState() == VoiceState::Attacking && attackBlocks < maxBlocks) {
+            processVoice(attackVoice);
+            ++attackBlocks;
+            if (attackVoice.isRetiring()) {
+                logger.log("runVoiceRetireTest", LogSeverity::Error,
+                           "Voice retired during attack (block " + std::to_string(attackBlocks) + ")");
+                passed = false;
+                break;
+            }
+        }
+
+        // Po attacku už tichý hlas skončit musí
+        int sustainBlocks = 0;
+        while (attackVoice.isActive() && sustainBlocks < 4) {
+            processVoice(attackVoice);
+            ++sustainBlocks;
+        }
+        if (attackBlocks < 2 || attackVoice.isActive()) {
+            logger.log("runVoiceRetireTest", LogSeverity::Error,
+                       "Quiet voice not retired after attack (attack blocks " + std::to_string(attackBlocks) + ")");
+            passed = false;
+        }
+
+        voice.cleanup(logger);
+        attackVoice.cleanup(logger);
+
+        logger.log("runVoiceRetireTest", passed ? LogSeverity::Info : LogSeverity::Error,
+                   passed ? "Voice retire test passed" : "Voice retire test failed");
+        return passed;
+
+    } catch (const std::exception& e) {
+        logger.log("runVoiceRetireTest", LogSeverity::Error, "Voice retire test failed: " + std::string(e.what()));
+        return false;
+    } catch (...) {
+        logger.log("runVoiceRetireTest", LogSeverity::Error, "Voice retire test failed: unknown error");
+        return false;
+    }
+}
+
+/**
+ * @brief Nastaví VoiceManager pro test idle fast path - LFO pan, BBE, limiter a konvoluce
+ */
+static void configureIdleTestManager(VoiceManager& voiceManager, const std::vector<float>& impulse,
+                                     int sampleRate, int blockSize, Logger& logger) {
+    voiceManager.prepareToPlay(blockSize);
+    voiceManager.setAllVoicesReleaseMIDI(10);
+    voiceManager.setAllVoicesPanSpeedMIDI(60);
+    voiceManager.setAllVoicesPanDepthMIDI(90);
+    voiceManager.setBBEDefinitionMIDI(80);
+    voiceManager.setBBEBassBoostMIDI(60);
+    voiceManager.setLimiterEnabledMIDI(127);
+    voiceManager.setLimiterThresholdMIDI(100);
+
+    // Dozvuk konvoluce trvá i po skončení všech hlasů
+    auto convolution = std::make_unique<ConvolutionEffect>(logger);
+    convolution->setImpulseResponse(impulse.data(), nullptr, static_cast<int>(impulse.size()), sampleRate);
+    convolution->setMixMIDI(64);
+    voiceManager.getDspChain()->addEffect(std::move(convolution));
+}
+
+bool runIdleFastPathTest(Logger& logger) {
+    try {
+        logger.log("runIdleFastPathTest", LogSeverity::Info, "Starting idle fast path test");
+
+        // Testovací parametry - blok = sub-blok, referenční cesta tak volá LFO/DSP
+        // na stejných hranicích jako renderSubBlock()
+        const int sampleRate = ITHACA_DEFAULT_SAMPLE_RATE;
+        const int blockSize = ITHACA_INTERNAL_BLOCK_SIZE;
+        const uint8_t testNotes[] = { 60, 64 };
+        const uint8_t testVelocity = 100;
+
+        const int noteBlocks = calculateBlocksForDuration(0.3, sampleRate, blockSize);
+        const int idleBlocks = calculateBlocksForDuration(2.0, sampleRate, blockSize);
+
+        // Impulsní odezva: 0.5 s exponenciálně doznívajícího deterministického šumu
+        std::vector<float> impulse(static_cast<size_t>(sampleRate / 2));
+        uint32_t noiseState = 12345u;
+        for (size_t i = 0; i < impulse.size(); ++i) {
+            noiseState = noiseState * 1664525u + 1013904223u;
+            const float noise = static_cast<float>(noiseState >> 8) / 8388608.0f - 1.0f;
+            impulse[i] = 0.3f * noise * std::exp(-6.0f * static_cast<float>(i) / static_cast<float>(impulse.size()));
+        }
+
+        // Dvě stejné instance (sine mode): fast path vs. LFO/DSP vždy nad celým blokem
+        VoiceManager fastManager(logger, 8, sampleRate);
+        VoiceManager referenceManager(logger, 8, sampleRate);
+        configureIdleTestManager(fastManager, impulse, sampleRate, blockSize, logger);
+        configureIdleTestManager(referenceManager, impulse, sampleRate, blockSize, logger);
+
+        std::vector<float> fastLeft(blockSize), fastRight(blockSize);
+        std::vector<float> refLeft(blockSize), refRight(blockSize);
+
+        bool passed = true;
+        int mismatchBlocks = 0;
+        float maxDifference = 0.0f;
+
+        // Vrací true pokud některý hlas fast instance ještě zní
+        auto processBoth = [&]() {
+            const bool fastActive = fastManager.processBlockUninterleaved(fastLeft.data(), fastRight.data(), blockSize);
+
+            std::fill(refLeft.begin(), refLeft.end(), 0.0f);
+            std::fill(refRight.begin(), refRight.end(), 0.0f);
+            referenceManager.processBlockSegment(refLeft.data(), refRight.data(), blockSize);
+            referenceManager.finalizeBlock(refLeft.data(), refRight.data(), blockSize);
+
+            bool identical = true;
+            for (int i = 0; i < blockSize; ++i) {
+                if (fastLeft[i] != refLeft[i] || fastRight[i] != refRight[i]) {
+                    identical = false;
+                    maxDifference = std::max(maxDifference, std::max(std::abs(fastLeft[i] - refLeft[i]),
+                                                                     std::abs(fastRight[i] - refRight[i])));
+                }
+            }
+            if (!identical) {
+                ++mismatchBlocks;
+            }
+            return fastActive;
+        };
+
+        auto blockPeak = [&]() {
+            float peak = 0.0f;
+            for (int i = 0; i < blockSize; ++i) {
+                peak = std::max(peak, std::max(std::abs(fastLeft[i]), std::abs(fastRight[i])));
+            }
+            return peak;
+        };
+
+        // Druhá nota po dlouhém tichu ověří, že přeskočené bloky posunuly LFO stejně
+        for (uint8_t note : testNotes) {
+            fastManager.setNoteStateMIDI(note, true, testVelocity);
+            referenceManager.setNoteStateMIDI(note, true, testVelocity);
+            for (int block = 0; block < noteBlocks; ++block) {
+                processBoth();
+            }
+
+            fastManager.setNoteStateMIDI(note, false);
+            referenceManager.setNoteStateMIDI(note, false);
+
+            // Doznívání: po skončení hlasu musí konvoluce ještě znít
+            int idleBlock = 0;
+            while (idleBlock < idleBlocks && processBoth()) {
+                ++idleBlock;
+            }
+            float tailPeak = 0.0f;
+            for (; idleBlock < idleBlocks; ++idleBlock) {
+                processBoth();
+                tailPeak = std::max(tailPeak, blockPeak());
+            }
+
+            if (tailPeak <= 0.0f) {
+                logger.log("runIdleFastPathTest", LogSeverity::Error,
+                           "Effect tail cut off after voice end (note " + std::to_string(note) + ")");
+                passed = false;
+            }
+
+            // Na konci ticha musí fast path skutečně přeskakovat (jinak test nic neověří)
+            if (!fastManager.getDspChain()->isTailSilent() || blockPeak() != 0.0f) {
+                logger.log("runIdleFastPathTest", LogSeverity::Error,
+                           "Effect tail did not settle to silence (note " + std::to_string(note) + ")");
+                passed = false;
+            }
+        }
+
+        if (mismatchBlocks > 0) {
+            logger.log("runIdleFastPathTest", LogSeverity::Error,
+                       "Idle fast path output differs from full LFO/DSP processing in " +
+                       std::to_string(mismatchBlocks) + " blocks (max difference " +
+                       std::to_string(maxDifference) + ")");
+            passed = false;
+        }
+
+        logger.log("runIdleFastPathTest", passed ? LogSeverity::Info : LogSeverity::Error,
+                   passed ? "Idle fast path test passed" : "Idle fast path test failed");
+        return passed;
+
+    } catch (const std::exception& e) {
+        logger.log("runIdleFastPathTest", LogSeverity::Error, "Idle fast path test failed: " + std::string(e.what()));
+        return false;
+    } catch (...) {
+        logger.log("runIdleFastPathTest", LogSeverity::Error, "Idle fast path test failed: unknown error");
+        return false;
+    }
+}
+
+bool runMultiTimbralTest(Logger& logger) {
+    try {
+        logger.log("runMultiTimbralTest", LogSeverity::Info, "Starting multi-timbral part test");
+
+        // Testovací parametry
+        const int sampleRate = ITHACA_DEFAULT_SAMPLE_RATE;
+        const int blockSize = 512;
+        const uint8_t testVelocity = 100;
+
+        VoiceManager voiceManager(logger, 8, sampleRate);
+        voiceManager.prepareToPlay(blockSize);
+
+        std::vector<float> leftBuffer(blockSize, 0.0f);
+        std::vector<float> rightBuffer(blockSize, 0.0f);
+        auto processBlocks = [&](int blocks) {
+            float peak = 0.0f;
+            for (int block = 0; block < blocks; ++block) {
+                voiceManager.processBlockUninterleaved(leftBuffer.data(), rightBuffer.data(), blockSize);
+                for (int i = 0; i < blockSize; ++i) {
+                    peak = std::max(peak, std::max(std::abs(leftBuffer[i]), std::abs(rightBuffer[i])));
+                }
+            }
+            return peak;
+        };
+
+        // Hlas poolu (index), který hraje danou notu - -1 pokud žádný
+        auto findSoundingVoice = [&](uint8_t midiNote) {
+            for (int index = 0; index < 128; ++index) {
+                Voice& voice = voiceManager.getVoiceMIDI(static_cast<uint8_t>(index));
+                if (voice.isActive() && voice.getMidiNote() == midiNote) return index;
+            }
+            return -1;
+        };
+
+        const int settleBlocks = calculateBlocksForDuration(0.5, sampleRate, blockSize);
+        bool passed = true;
+        auto check = [&](bool condition, const std::string& message) {
+            if (!condition) {
+                logger.log("runMultiTimbralTest", LogSeverity::Error, message);
+                passed = false;
+            }
+        };
+
+        // ===== 1. ROUTING PODLE KANÁLU =====
+
+        voiceManager.setPartCount(2, logger);
+        voiceManager.setPartMasterGainMIDI(0, 0);
+
+        voiceManager.setPartNoteStateMIDI(0, 60, true, testVelocity);
+        const float mutedPeak = processBlocks(settleBlocks);
+        check(voiceManager.getPartActiveVoicesCount(0) == 1 && voiceManager.getPartActiveVoicesCount(1) == 0,
+              "Note-on on part 0 not owned by part 0");
+        check(mutedPeak < 1.0e-4f, "Part 0 with master gain 0 is audible (peak " + std::to_string(mutedPeak) + ")");
+
+        // Stejná nota na druhém kanálu dostane vlastní hlas s parametry partu 1
+        voiceManager.setPartNoteStateMIDI(1, 60, true, testVelocity);
+        const float audiblePeak = processBlocks(settleBlocks);
+        check(voiceManager.getPartActiveVoicesCount(1) == 1 && voiceManager.getActiveVoicesCount() == 2,
+              "Same note on part 1 did not get its own voice");
+        check(audiblePeak > 0.01f, "Part 1 note is silent (peak " + std::to_string(audiblePeak) + ")");
+
+        // Note-off partu 0 nesmí ukončit stejnou notu partu 1
+        voiceManager.setPartNoteStateMIDI(0, 60, false, 0);
+        const float remainingPeak = processBlocks(settleBlocks);
+        check(voiceManager.getPartActiveVoicesCount(0) == 0 && voiceManager.getPartActiveVoicesCount(1) == 1,
+              "Note-off on part 0 affected part 1");
+        check(remainingPeak > 0.01f, "Part 1 note silenced by note-off on part 0");
+
+        // ===== 2. LIMIT POLYFONIE PARTU =====
+
+        voiceManager.setPartPolyphony(1, 3);
+        voiceManager.setPartNoteStateMIDI(1, 61, true, testVelocity);
+        voiceManager.setPartNoteStateMIDI(1, 62, true, testVelocity);
+        processBlocks(1);
+
+        // 61 dostala hlas 0 uvolněný partem 0; retrigger obnoví její pořadí, takže
+        // nejstarší je 60 (hlas 1), ne hlas s nejnižším indexem
+        voiceManager.setPartNoteStateMIDI(1, 61, true, testVelocity);
+        voiceManager.setPartNoteStateMIDI(1, 63, true, testVelocity);
+        processBlocks(1);
+        check(voiceManager.getPartActiveVoicesCount(1) == 3, "Part 1 exceeded its polyphony limit");
+        check(findSoundingVoice(60) < 0 && findSoundingVoice(61) == 0 && findSoundingVoice(63) >= 0,
+              "Polyphony limit did not steal the oldest note of the part");
+
+        // Limit partu 1 neomezuje part 0
+        for (uint8_t note = 70; note < 75; ++note) {
+            voiceManager.setPartNoteStateMIDI(0, note, true, testVelocity);
+        }
+        processBlocks(1);
+        check(voiceManager.getPartActiveVoicesCount(0) == 5 && voiceManager.getPartActiveVoicesCount(1) == 3,
+              "Polyphony limit of part 1 affected part 0");
+
+        // ===== 3. KRÁDEŽ NEJSTARŠÍHO HLASU Z PLNÉHO POOLU =====
+
+        voiceManager.setPartCount(2, logger);
+
+        // Nota n dostane hlas n; retrigger 0-63 udělá z hlasů 64-127 ty nejstarší
+        for (int note = 0; note < 128; ++note) {
+            voiceManager.setPartNoteStateMIDI(0, static_cast<uint8_t>(note), true, testVelocity);
+        }
+        processBlocks(2);
+        for (int note = 0; note < 64; ++note) {
+            voiceManager.setPartNoteStateMIDI(0, static_cast<uint8_t>(note), true, testVelocity);
+        }
+        processBlocks(2);
+
+        voiceManager.setPartNoteStateMIDI(0, 10, false, 0);
+        voiceManager.setPartNoteStateMIDI(0, 70, false, 0);
+
+        // Releasing hlasy mají přednost, mezi nimi nejstarší note-on (70 před 10)
+        voiceManager.setPartNoteStateMIDI(1, 100, true, testVelocity);
+        check(voiceManager.getVoiceMIDI(70).getMidiNote() == 100 && voiceManager.getVoiceMIDI(10).getMidiNote() == 10,
+              "Full pool did not steal the oldest releasing voice");
+        voiceManager.setPartNoteStateMIDI(1, 101, true, testVelocity);
+        check(voiceManager.getVoiceMIDI(10).getMidiNote() == 101,
+              "Full pool did not steal the remaining releasing voice");
+
+        // Bez releasing hlasů nejstarší sustaining (64), ne nejnižší index
+        voiceManager.setPartNoteStateMIDI(1, 102, true, testVelocity);
+        check(voiceManager.getVoiceMIDI(64).getMidiNote() == 102,
+              "Full pool did not steal the oldest sustaining voice");
+        check(voiceManager.getActiveVoicesCount() == 128 && voiceManager.getPartActiveVoicesCount(1) == 3,
+              "Voice ownership inconsistent after stealing");
+
+        // ===== 4. UKRADENÝ HLAS DOZNÍ PŘES DAMPING BUFFER =====
+
+        voiceManager.setPartCount(2, logger);
+        voiceManager.setPartPolyphony(0, 1);
+
+        voiceManager.setPartNoteStateMIDI(0, 60, true, testVelocity);
+        processBlocks(settleBlocks);
+
+        // Referenční krok mezi sousedními vzorky znějící noty
+        float steadyStep = 0.0f;
+        for (int i = 1; i < blockSize; ++i) {
+            steadyStep = std::max(steadyStep, std::abs(leftBuffer[i] - leftBuffer[i - 1]));
+        }
+        const float lastSample = leftBuffer[blockSize - 1];
+
+        voiceManager.setPartNoteStateMIDI(0, 72, true, testVelocity);
+        processBlocks(1);
+        const float stealJump = std::abs(leftBuffer[0] - lastSample);
+
+        check(voiceManager.getPartActiveVoicesCount(0) == 1 && findSoundingVoice(72) >= 0,
+              "Part with polyphony 1 did not reuse its voice");
+        check(stealJump <= 2.0f * steadyStep,
+              "Stolen voice cut off without damping (jump " + std::to_string(stealJump) +
+              ", steady step " + std::to_string(steadyStep) + ")");
+
+        voiceManager.setPartCount(1, logger);
+
+        logger.log("runMultiTimbralTest", passed ? LogSeverity::Info : LogSeverity::Error,
+                   passed ? "Multi-timbral part test passed" : "Multi-timbral part test failed");
+        return passed;
+
+    } catch (const std::exception& e) {
+        logger.log("runMultiTimbralTest", LogSeverity::Error, "Multi-timbral part test failed: " + std::string(e.what()));
+        return false;
+    } catch (...) {
+        logger.log("runMultiTimbralTest", LogSeverity::Error, "Multi-timbral part test failed: unknown error");
+        return false;
+    }
+}
+
+bool runParameterSmoothingTest(Logger& logger) {
+    try {
+        logger.log("runParameterSmoothingTest", LogSeverity::Info, "Starting voice parameter smoothing test");
+
+        // Testovací parametry
+        const int sampleRate = 48000;
+        const int blockSize = 512;
+        const int frameCount = 4 * sampleRate;
+        const float level = 0.5f;                   // DC sample - výstup = level × gainy
+        const uint8_t testVelocity = 100;
+
+        // Max. změna parametru na vzorek (viz Voice::initialize())
+        const float paramStep = 1000.0f / (ITHACA_VOICE_PARAM_SMOOTHING_MS * static_cast<float>(sampleRate));
+
+        const int profileBlocks = (frameCount + TAIL_PEAK_BLOCK_FRAMES - 1) / TAIL_PEAK_BLOCK_FRAMES;
+        std::vector<float> stereoData(static_cast<size_t>(frameCount) * 2, level);
+        std::vector<float> tailProfile(static_cast<size_t>(profileBlocks), level);
+        Instrument instrument;
+        fillTestInstrument(instrument, stereoData, tailProfile, frameCount);
+
+        VoiceParams params;
+        Envelope envelope;
+        Voice voice(60);
+        voice.initialize(instrument, sampleRate, envelope, logger, nullptr);
+        voice.bindParameters(params);
+        voice.prepareToPlay(blockSize);
+        voice.setNoteState(true, testVelocity);
+
+        std::vector<float> leftBuffer(blockSize, 0.0f);
+        std::vector<float> rightBuffer(blockSize, 0.0f);
+        float previousLeft = 0.0f;
+        float previousRight = 0.0f;
+
+        // Největší skok mezi sousedními vzorky (i přes hranice bloků a sub-bloků)
+        auto processBlocks = [&](int blocks) {
+            float maxJump = 0.0f;
+            for (int block = 0; block < blocks; ++block) {
+                std::fill(leftBuffer.begin(), leftBuffer.end(), 0.0f);
+                std::fill(rightBuffer.begin(), rightBuffer.end(), 0.0f);
+                voice.processBlock(leftBuffer.data(), rightBuffer.data(), blockSize);
+                for (int i = 0; i < blockSize; ++i) {
+                    maxJump = std::max(maxJump, std::max(std::abs(leftBuffer[i] - previousLeft),
+                                                         std::abs(rightBuffer[i] - previousRight)));
+                    previousLeft = leftBuffer[i];
+                    previousRight = rightBuffer[i];
+                }
+            }
+            return maxJump;
+        };
+
+        // Ustálená sustain úroveň při master gainu 1.0 a panu ve středu
+        processBlocks(calculateBlocksForDuration(0.2, sampleRate, blockSize));
+        const float steadyLevel = previousLeft;
+        const float maxAllowedJump = 4.0f * steadyLevel * paramStep;
+        const int changeBlocks = calculateBlocksForDuration(0.1, sampleRate, blockSize);
+
+        bool passed = steadyLevel > 0.0f;
+        if (!passed) {
+            logger.log("runParameterSmoothingTest", LogSeverity::Error, "Test voice is silent");
+        }
+
+        // ===== 1. MASTER GAIN - RAMPA PO VZORCÍCH =====
+
+        params.setMasterGain(0.2f);
+        const float gainJump = processBlocks(changeBlocks);
+        if (gainJump > maxAllowedJump) {
+            logger.log("runParameterSmoothingTest", LogSeverity::Error,
+                       "Master gain change steps between samples (jump " + std::to_string(gainJump) +
+                       ", allowed " + std::to_string(maxAllowedJump) + ")");
+            passed = false;
+        }
+        if (std::abs(previousLeft - 0.2f * steadyLevel) > 1.0e-5f) {
+            logger.log("runParameterSmoothingTest", LogSeverity::Error,
+                       "Master gain did not reach its target (" + std::to_string(previousLeft) + ")");
+            passed = false;
+        }
+
+        // ===== 2. PAN - RAMPA PO VZORCÍCH =====
+
+        params.setPan(-1.0f);
+        const float panJump = processBlocks(changeBlocks);
+        if (panJump > maxAllowedJump) {
+            logger.log("runParameterSmoothingTest", LogSeverity::Error,
+                       "Pan change steps between samples (jump " + std::to_string(panJump) +
+                       ", allowed " + std::to_string(maxAllowedJump) + ")");
+            passed = false;
+        }
+        if (std::abs(previousRight) > 1.0e-5f) {
+            logger.log("runParameterSmoothingTest", LogSeverity::Error,
+                       "Hard left pan not reached (right " + std::to_string(previousRight) + ")");
+            passed = false;
+        }
+
+        voice.cleanup(logger);
+
+        logger.log("runParameterSmoothingTest", passed ? LogSeverity::Info : LogSeverity::Error,
+                   passed ? "Voice parameter smoothing test passed" : "Voice parameter smoothing test failed");
+        return passed;
+
+    } catch (const std::exception& e) {
+        logger.log("runParameterSmoothingTest", LogSeverity::Error, "Voice parameter smoothing test failed: " + std::string(e.what()));
+        return false;
+    } catch (...) {
+        logger.log("runParameterSmoothingTest", LogSeverity::Error, "Voice parameter smoothing test failed: unknown error");
+        return false;
+    }
+}
+
+bool runBassBoostSwitchTest(Logger& logger) {
+    try {
+        logger.log("runBassBoostSwitchTest", LogSeverity::Info, "Starting BBE bass boost switch test");
+
+        // Testovací parametry
+        const int sampleRate = 48000;
+        const int blockSize = ITHACA_INTERNAL_BLOCK_SIZE;
+        const double toneHz = 60.0;                 // Basové pásmo - prochází shelfem
+        const float toneLevel = 0.5f;
+
+        BBEProcessor bbe;
+        bbe.prepare(sampleRate, blockSize);
+        bbe.setDefinitionMIDI(100);                 // Wet cesta zůstane aktivní i bez bass boostu
+        bbe.setBassBoostMIDI(127);
+
+        std::vector<float> leftBuffer(blockSize);
+        std::vector<float> rightBuffer(blockSize);
+        double phase = 0.0;
+        const double phaseStep = 2.0 * 3.14159265358979323846 * toneHz / sampleRate;
+        float previous = 0.0f;
+
+        // Největší skok mezi sousedními vzorky výstupu
+        auto processBlocks = [&](int blocks) {
+            float maxJump = 0.0f;
+            for (int block = 0; block < blocks; ++block) {
+                for (int i = 0; i < blockSize; ++i) {
+                    leftBuffer[i] = rightBuffer[i] = toneLevel * static_cast<float>(std::sin(phase));
+                    phase += phaseStep;
+                }
+                bbe.process(leftBuffer.data(), rightBuffer.data(), blockSize);
+                for (int i = 0; i < blockSize; ++i) {
+                    maxJump = std::max(maxJump, std::abs(leftBuffer[i] - previous));
+                    previous = leftBuffer[i];
+                }
+            }
+            return maxJump;
+        };
+
+        processBlocks(calculateBlocksForDuration(0.5, sampleRate, blockSize));
+        const float steadyJump = processBlocks(calculateBlocksForDuration(0.5, sampleRate, blockSize));
+
+        // Vypnutí boostu: shelf dojede na 0 dB se zachovaným stavem filtru, bez skoku
+        bbe.setBassBoostMIDI(0);
+        const float switchJump = processBlocks(calculateBlocksForDuration(1.0, sampleRate, blockSize));
+
+        const bool passed = switchJump <= 1.5f * steadyJump;
+        logger.log("runBassBoostSwitchTest", passed ? LogSeverity::Info : LogSeverity::Error,
+                   "Max sample step: steady " + std::to_string(steadyJump) +
+                   ", bass boost off " + std::to_string(switchJump));
+        logger.log("runBassBoostSwitchTest", passed ? LogSeverity::Info : LogSeverity::Error,
+                   passed ? "BBE bass boost switch test passed" : "BBE bass boost switch test failed - click on switch-off");
+        return passed;
+
+    } catch (const std::exception& e) {
+        logger.log("runBassBoostSwitchTest", LogSeverity::Error, "BBE bass boost switch test failed: " + std::string(e.what()));
+        return false;
+    } catch (...) {
+        logger.log("runBassBoostSwitchTest", LogSeverity::Error, "BBE bass boost switch test failed: unknown error");
+        return false;
+    }
+}
+
+namespace {
+
+/**
+ * @brief Testovací efekt pro stress test DspChain
+ *
+ * Přičte ke každému samplu 1.0 - výstup chainu z nulového vstupu je tedy
+ * počet efektů v grafu, který audio thread právě zpracoval. Destruktor
+ * hlídá, že ho nikdo neuvolní uprostřed process() (graf uvolněný příliš brzy).
+ */
+class ChainStressEffect : public DspEffect {
+public:
+    static std::atomic<int> liveCount;
+    static std::atomic<int> destroyedWhileProcessing;
+
+    ChainStressEffect() noexcept { liveCount.fetch_add(1, std::memory_order_relaxed); }
+
+    ~ChainStressEffect() override {
+        if (processing_.load(std::memory_order_seq_cst) != 0) {
+            destroyedWhileProcessing.fetch_add(1, std::memory_order_relaxed);
+        }
+        liveCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void prepare(int sampleRate, int maxBlockSize) override {
+        (void)sampleRate;
+        (void)maxBlockSize;
+    }
+
+    void reset() noexcept override {}
+
+    void process(float* leftBuffer, float* rightBuffer, int numSamples) noexcept override {
+        processing_.fetch_add(1, std::memory_order_seq_cst);
+        for (int i = 0; i < numSamples; ++i) {
+            leftBuffer[i] += 1.0f;
+            rightBuffer[i] += 1.0f;
+        }
+        processing_.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    void setEnabled(bool enabled) noexcept override { (void)enabled; }
+    bool isEnabled() const noexcept override { return true; }
+    const char* getName() const noexcept override { return "ChainStress"; }
+
+private:
+    std::atomic<int> processing_{0};
+};
+
+std::atomic<int> ChainStressEffect::liveCount{0};
+std::atomic<int> ChainStressEffect::destroyedWhileProcessing{0};
+
+} // namespace
+
+bool runDspChainStressTest(Logger& logger) {
+    try {
+        logger.log("runDspChainStressTest", LogSeverity::Info, "Starting DspChain concurrent reconfiguration stress test");
+
+        // Testovací parametry
+        const int blockSize = ITHACA_INTERNAL_BLOCK_SIZE;
+        const size_t minEffects = 2;
+        const size_t maxEffects = 8;
+        const int controlOperations = 20000;
+        const uint64_t minAudioBlocks = 5000;
+
+        ChainStressEffect::liveCount.store(0);
+        ChainStressEffect::destroyedWhileProcessing.store(0);
+
+        bool passed = true;
+        {
+            DspChain chain;
+            chain.prepare(ITHACA_DEFAULT_SAMPLE_RATE, blockSize);
+            chain.setProfilingEnabled(true);    // Měřiče putují s efekty - i ty musí přežít výměny
+            for (size_t i = 0; i < minEffects; ++i) {
+                chain.addEffect(std::make_unique<ChainStressEffect>());
+            }
+
+            std::atomic<bool> stop{false};
+            std::atomic<uint64_t> audioBlocks{0};
+            std::atomic<uint64_t> badBlocks{0};
+
+            // Audio thread: process() bez přestávky, každý blok musí odpovídat
+            // celému publikovanému grafu (minEffects..maxEffects efektů)
+            std::thread audioThread([&]() {
+                std::vector<float> leftBuffer(blockSize);
+                std::vector<float> rightBuffer(blockSize);
+                while (!stop.load(std::memory_order_acquire)) {
+                    std::fill(leftBuffer.begin(), leftBuffer.end(), 0.0f);
+                    std::fill(rightBuffer.begin(), rightBuffer.end(), 0.0f);
+                    chain.process(leftBuffer.data(), rightBuffer.data(), blockSize);
+
+                    const float effects = leftBuffer[0];
+                    bool consistent = effects >= static_cast<float>(minEffects) &&
+                                      effects <= static_cast<float>(maxEffects);
+                    for (int i = 0; i < blockSize && consistent; ++i) {
+                        consistent = leftBuffer[i] == effects && rightBuffer[i] == effects;
+                    }
+                    if (!consistent) {
+                        badBlocks.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    audioBlocks.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+
+            // Řídicí thread: náhodné insert / remove / move (deterministické LCG)
+            uint32_t random = 12345u;
+            auto nextRandom = [&random]() {
+                random = random * 1664525u + 1013904223u;
+                return random >> 8;
+            };
+
+            int inserts = 0;
+            int removes = 0;
+            int moves = 0;
+            for (int op = 0; op < controlOperations ||
+                             audioBlocks.load(std::memory_order_relaxed) < minAudioBlocks; ++op) {
+                const size_t count = chain.getEffectCount();
+                switch (nextRandom() % 3) {
+                    case 0:
+                        if (count < maxEffects) {
+                            chain.insertEffect(nextRandom() % (count + 1), std::make_unique<ChainStressEffect>());
+                            ++inserts;
+                        }
+                        break;
+                    case 1:
+                        if (count > minEffects && chain.removeEffect(nextRandom() % count)) {
+                            ++removes;
+                        }
+                        break;
+                    default:
+                        if (chain.moveEffect(nextRandom() % count, nextRandom() % count)) {
+                            ++moves;
+                        }
+                        break;
+                }
+                if ((op & 63) == 0) {
+                    std::this_thread::yield();
+                }
+            }
+
+            stop.store(true, std::memory_order_release);
+            audioThread.join();
+
+            // Po zastavení audia musí jít uvolnit všechny vyřazené grafy
+            chain.reclaimRetired();
+            const size_t finalCount = chain.getEffectCount();
+            const int liveAfterReclaim = ChainStressEffect::liveCount.load();
+
+            std::vector<float> leftBuffer(blockSize, 0.0f);
+            std::vector<float> rightBuffer(blockSize, 0.0f);
+            chain.process(leftBuffer.data(), rightBuffer.data(), blockSize);
+
+            logger.log("runDspChainStressTest", LogSeverity::Info,
+                       "Control ops: " + std::to_string(inserts) + " inserts, " + std::to_string(removes) +
+                       " removes, " + std::to_string(moves) + " moves; audio blocks: " +
+                       std::to_string(audioBlocks.load()) + ", inconsistent: " + std::to_string(badBlocks.load()));
+
+            if (badBlocks.load() != 0) {
+                logger.log("runDspChainStressTest", LogSeverity::Error, "Audio thread saw a torn or invalid effect graph");
+                passed = false;
+            }
+            if (liveAfterReclaim != static_cast<int>(finalCount)) {
+                logger.log("runDspChainStressTest", LogSeverity::Error,
+                           "Live effects after reclaim: " + std::to_string(liveAfterReclaim) +
+                           ", expected " + std::to_string(finalCount));
+                passed = false;
+            }
+            if (leftBuffer[0] != static_cast<float>(finalCount)) {
+                logger.log("runDspChainStressTest", LogSeverity::Error, "Final graph does not match effect count");
+                passed = false;
+            }
+        }
+
+        if (ChainStressEffect::destroyedWhileProcessing.load() != 0) {
+            logger.log("runDspChainStressTest", LogSeverity::Error,
+                       "Effects destroyed while processing: " +
+                       std::to_string(ChainStressEffect::destroyedWhileProcessing.load()));
+            passed = false;
+        }
+        if (ChainStressEffect::liveCount.load() != 0) {
+            logger.log("runDspChainStressTest", LogSeverity::Error, "Effects leaked after chain destruction");
+            passed = false;
+        }
+
+        logger.log("runDspChainStressTest", passed ? LogSeverity::Info : LogSeverity::Error,
+                   passed ? "DspChain stress test passed" : "DspChain stress test failed");
+        return passed;
+
+    } catch (const std::exception& e) {
+        logger.log("runDspChainStressTest", LogSeverity::Error, "DspChain stress test failed: " + std::string(e.what()));
+        return false;
+    } catch (...) {
+        logger.log("runDspChainStressTest", LogSeverity::Error, "DspChain stress test failed: unknown error");
+        return false;
+    }
+}
+
+bool runLimiterFastPathTest(Logger& logger) {
+    try {
+        logger.log("runLimiterFastPathTest", LogSeverity::Info, "Starting limiter fast/slow path comparison");
+
+        // Testovací parametry
+        const int sampleRate = ITHACA_DEFAULT_SAMPLE_RATE;
+        const float thresholdDb = -6.0f;
+        const float releaseMs = 20.0f;
+        const float gainTolerance = 1e-6f;          // rcp + Newton-Raphson vs. dělení (viz limiter.cpp)
+        const int blockSizes[] = { 128, 1, 37, 64, 200, 5, 127, 63 };   // Přes hranice GAIN_CHUNK i SIMD zbytky
+
+        Limiter limiter;
+        limiter.prepare(sampleRate, ITHACA_INTERNAL_BLOCK_SIZE);
+        limiter.setThreshold(thresholdDb);
+        limiter.setRelease(releaseMs);
+
+        // Referenční limiter: per-sample smyčka s přesným dělením, bez fast path
+        const float threshold = std::pow(10.0f, thresholdDb / 20.0f);
+        const float releaseCoeff = std::exp(-1.0f / (releaseMs / 1000.0f * static_cast<float>(sampleRate)));
+        float referenceEnvelope = 1.0f;
+
+        // Signál: tichý → hlasitý šum (limiting) → tichý (release, pak usazení) → hlasitý → tichý
+        struct Segment { float level; double seconds; };
+        const Segment segments[] = { {0.3f, 0.2}, {1.5f, 0.1}, {0.3f, 0.5}, {0.9f, 0.05}, {0.2f, 0.5} };
+
+        uint32_t random = 987654321u;
+        double phase = 0.0;
+        float maxGainError = 0.0f;
+        float maxOutputPeak = 0.0f;
+        bool settledExact = true;
+        int settledBlocks = 0;
+        int releasingBlocks = 0;
+        int blockIndex = 0;
+
+        std::vector<float> leftBuffer;
+        std::vector<float> rightBuffer;
+        std::vector<float> inputLeft;
+        std::vector<float> inputRight;
+
+        for (const Segment& segment : segments) {
+            int remaining = static_cast<int>(segment.seconds * sampleRate);
+            while (remaining > 0) {
+                const int blockSize = std::min(remaining, blockSizes[blockIndex++ % 8]);
+                remaining -= blockSize;
+
+                leftBuffer.resize(blockSize);
+                rightBuffer.resize(blockSize);
+                for (int i = 0; i < blockSize; ++i) {
+                    random = random * 1664525u + 1013904223u;
+                    const float noise = static_cast<float>(random >> 8) / 16777216.0f * 2.0f - 1.0f;
+                    leftBuffer[i] = segment.level * static_cast<float>(std::sin(phase));
+                    rightBuffer[i] = segment.level * noise;
+                    phase += 0.05;
+                }
+                inputLeft = leftBuffer;
+                inputRight = rightBuffer;
+
+                // Stav na začátku bloku - usazený a pod thresholdem = fast path
+                const bool settled = (1.0f + releaseCoeff * (referenceEnvelope - 1.0f) == referenceEnvelope);
+                if (settled) {
+                    ++settledBlocks;
+                } else {
+                    ++releasingBlocks;
+                }
+
+                limiter.process(leftBuffer.data(), rightBuffer.data(), blockSize);
+
+                for (int i = 0; i < blockSize; ++i) {
+                    const float peak = std::max(std::abs(inputLeft[i]), std::abs(inputRight[i]));
+                    const float targetGain = (peak > threshold) ? threshold / peak : 1.0f;
+                    referenceEnvelope = (targetGain < referenceEnvelope)
+                        ? targetGain
+                        : targetGain + releaseCoeff * (referenceEnvelope - targetGain);
+
+                    // Výstup = vstup × envelope → chyba gainu nezávisle na amplitudě
+                    const float inputs[2] = { inputLeft[i], inputRight[i] };
+                    const float outputs[2] = { leftBuffer[i], rightBuffer[i] };
+                    for (int channel = 0; channel < 2; ++channel) {
+                        const float expected = inputs[channel] * referenceEnvelope;
+                        if (settled && referenceEnvelope == 1.0f && outputs[channel] != expected) {
+                            settledExact = false;
+                        }
+                        maxGainError = std::max(maxGainError, std::abs(outputs[channel] - expected));
+                        maxOutputPeak = std::max(maxOutputPeak, std::abs(outputs[channel]));
+                    }
+                }
+            }
+        }
+
+        // Relativní přesah thresholdu (rcp + 1 krok NR může gain nadhodnotit o jednotky ulp)
+        const float overshoot = maxOutputPeak / threshold - 1.0f;
+
+        std::ostringstream summary;
+        summary << "Blocks settled: " << settledBlocks << ", releasing: " << releasingBlocks
+                << ", max gain error: " << maxGainError << ", threshold overshoot: " << overshoot;
+        logger.log("runLimiterFastPathTest", LogSeverity::Info, summary.str());
+
+        bool passed = true;
+        if (settledBlocks == 0 || releasingBlocks == 0) {
+            logger.log("runLimiterFastPathTest", LogSeverity::Error, "Signal did not exercise both settled and releasing envelopes");
+            passed = false;
+        }
+        if (!settledExact) {
+            logger.log("runLimiterFastPathTest", LogSeverity::Error, "Fast path changed a settled block below threshold");
+            passed = false;
+        }
+        if (maxGainError > gainTolerance * 1.5f) {        // |vstup| ≤ 1.5
+            logger.log("runLimiterFastPathTest", LogSeverity::Error, "Limiter output deviates from the per-sample reference");
+            passed = false;
+        }
+        if (overshoot > gainTolerance) {
+            logger.log("runLimiterFastPathTest", LogSeverity::Error, "Limiter output exceeds threshold beyond rounding");
+            passed = false;
+        }
+
+        logger.log("runLimiterFastPathTest", passed ? LogSeverity::Info : LogSeverity::Error,
+                   passed ? "Limiter fast path test passed" : "Limiter fast path test failed");
+        return passed;
+
+    } catch (const std::exception& e) {
+        logger.log("runLimiterFastPathTest", LogSeverity::Error, "Limiter fast path test failed: " + std::string(e.what()));
+        return false;
+    } catch (...) {
+        logger.log("runLimiterFastPathTest", LogSeverity::Error, "Limiter fast path test failed: unknown error");
+        return false;
+    }
+}
+
+bool runConvolutionTest(Logger& logger) {
+    try {
+        logger.log("runConvolutionTest", LogSeverity::Info, "Starting convolution accuracy and mix ramp test");
+
+        // Testovací parametry
+        const int sampleRate = ITHACA_DEFAULT_SAMPLE_RATE;
+        const int maxBlockSize = 512;
+        const int irLength = 2 * ConvolutionEffect::TAIL_BLOCK_SIZE + 1900;    // head + tail0 + tail (worker)
+        const int blockSizes[] = { 1, 7, 64, 129, 512, 33, 300, 2, 511, 65 };
+        const double maxRelativeError = 1e-5;
+        bool passed = true;
+
+        uint32_t random = 24680u;
+        auto nextNoise = [&random]() {
+            random = random * 1664525u + 1013904223u;
+            return static_cast<float>(random >> 8) / 16777216.0f * 2.0f - 1.0f;
+        };
+
+        // ===== 1. Přesnost proti přímé konvoluci (nepravidelné bloky, tichá mezera) =====
+        {
+            std::vector<float> irLeft(irLength);
+            std::vector<float> irRight(irLength);
+            for (int i = 0; i < irLength; ++i) {
+                const float decay = std::exp(-3.0f * static_cast<float>(i) / irLength);
+                irLeft[i] = nextNoise() * decay;
+                irRight[i] = nextNoise() * decay;
+            }
+
+            // Šum → ticho delší než dozvuk (přeskočení doznělého stavu) → šum
+            const int noiseLength = 6000;
+            const int gapLength = irLength + 4 * ConvolutionEffect::TAIL_BLOCK_SIZE;
+            const int inputLength = 2 * noiseLength + gapLength;
+            std::vector<float> inputLeft(inputLength, 0.0f);
+            std::vector<float> inputRight(inputLength, 0.0f);
+            for (int i = 0; i < inputLength; ++i) {
+                if (i < noiseLength || i >= noiseLength + gapLength) {
+                    inputLeft[i] = 0.5f * nextNoise();
+                    inputRight[i] = 0.5f * nextNoise();
+                }
+            }
+
+            ConvolutionEffect convolution(logger);
+            convolution.setImpulseResponse(irLeft.data(), irRight.data(), irLength, sampleRate);
+            convolution.setMixMIDI(127);                    // Čistě wet = výstup konvoluce
+            convolution.prepare(sampleRate, maxBlockSize);
+
+            std::vector<float> outputLeft = inputLeft;
+            std::vector<float> outputRight = inputRight;
+            int blockIndex = 0;
+            for (int offset = 0; offset < inputLength; ) {
+                const int block = std::min(blockSizes[blockIndex++ % 10], inputLength - offset);
+                convolution.process(outputLeft.data() + offset, outputRight.data() + offset, block);
+                offset += block;
+            }
+
+            double maxError = 0.0;
+            double referencePeak = 0.0;
+            const std::vector<float>* inputs[2] = { &inputLeft, &inputRight };
+            const std::vector<float>* irs[2] = { &irLeft, &irRight };
+            const std::vector<float>* outputs[2] = { &outputLeft, &outputRight };
+            for (int channel = 0; channel < 2; ++channel) {
+                const std::vector<float>& input = *inputs[channel];
+                const std::vector<float>& ir = *irs[channel];
+                for (int n = 0; n < inputLength; ++n) {
+                    double reference = 0.0;
+                    for (int k = std::max(0, n - irLength + 1); k <= n; ++k) {
+                        reference += static_cast<double>(input[k]) * ir[n - k];
+                    }
+                    referencePeak = std::max(referencePeak, std::abs(reference));
+                    maxError = std::max(maxError, std::abs(reference - (*outputs[channel])[n]));
+                }
+            }
+
+            const double relativeError = referencePeak > 0.0 ? maxError / referencePeak : 1.0;
+            std::ostringstream summary;
+            summary << "Direct convolution: IR " << irLength << " samples, max error " << maxError
+                    << " (relative " << relativeError << ")";
+            logger.log("runConvolutionTest", LogSeverity::Info, summary.str());
+
+            if (relativeError > maxRelativeError) {
+                logger.log("runConvolutionTest", LogSeverity::Error, "Convolution output deviates from direct convolution");
+                passed = false;
+            }
+        }
+
+        // ===== 2. Změna mixu bez skoku =====
+        // Invertující IR: dry = x, wet = -x - skok mixu 0 → 127 by na DC
+        // vstupu skočil o 2·x za jediný vzorek
+        {
+            const float dcLevel = 0.5f;
+            const float invertingImpulse = -1.0f;
+            const int blockSize = ITHACA_INTERNAL_BLOCK_SIZE;
+
+            ConvolutionEffect convolution(logger);
+            convolution.setImpulseResponse(&invertingImpulse, nullptr, 1, sampleRate);
+            convolution.setMixMIDI(0);
+            convolution.prepare(sampleRate, blockSize);
+
+            std::vector<float> leftBuffer(blockSize);
+            std::vector<float> rightBuffer(blockSize);
+            float previous = dcLevel;
+            auto processBlocks = [&](int blocks) {
+                float maxJump = 0.0f;
+                for (int block = 0; block < blocks; ++block) {
+                    std::fill(leftBuffer.begin(), leftBuffer.end(), dcLevel);
+                    std::fill(rightBuffer.begin(), rightBuffer.end(), dcLevel);
+                    convolution.process(leftBuffer.data(), rightBuffer.data(), blockSize);
+                    for (int i = 0; i < blockSize; ++i) {
+                        maxJump = std::max(maxJump, std::abs(leftBuffer[i] - previous));
+                        previous = leftBuffer[i];
+                    }
+                }
+                return maxJump;
+            };
+
+            processBlocks(4);
+            convolution.setMixMIDI(127);
+            const float switchJump = processBlocks(calculateBlocksForDuration(0.2, sampleRate, blockSize));
+            const float settledOutput = leftBuffer[blockSize - 1];
+
+            // Lineární rampa: nejvýš 2·x / délka rampy na vzorek (rampa ≥ 10 ms)
+            const float maxAllowedJump = 2.0f * dcLevel / (0.01f * sampleRate);
+            std::ostringstream summary;
+            summary << "Mix 0 -> 127: max sample step " << switchJump << " (limit " << maxAllowedJump
+                    << "), settled output " << settledOutput;
+            logger.log("runConvolutionTest", LogSeverity::Info, summary.str());
+
+            if (switchJump > maxAllowedJump) {
+                logger.log("runConvolutionTest", LogSeverity::Error, "Mix change is not smoothed - click on the output");
+                passed = false;
+            }
+            if (std::abs(settledOutput + dcLevel) > 1e-6f) {
+                logger.log("runConvolutionTest", LogSeverity::Error, "Mix ramp did not reach the target");
+                passed = false;
+            }
+        }
+
+        logger.log("runConvolutionTest", passed ? LogSeverity::Info : LogSeverity::Error,
+                   passed ? "Convolution test passed" : "Convolution test failed");
+        return passed;
+
+    } catch (const std::exception& e) {
+        logger.log("runConvolutionTest", LogSeverity::Error, "Convolution test failed: " + std::string(e.what()));
+        return false;
+    } catch (...) {
+        logger.log("runConvolutionTest", LogSeverity::Error, "Convolution test failed: unknown error");
+        return false;
+    }
+}
+
+bool runSimdDispatchTest(Logger& logger) {
+    try {
+        logger.log("runSimdDispatchTest", LogSeverity::Info, "Starting SIMD dispatch cross-level bit-identity test");
+
+        // Délky přes SIMD šířky 4/8/16 i zbytky; vstupy posunuté o 1 float (nezarovnané)
+        const int lengths[] = { 1, 3, 4, 7, 8, 15, 16, 17, 31, 33, 64, 127, 128, 515 };
+        const SimdDispatch::Level levels[] = {
+            SimdDispatch::Level::SSE2, SimdDispatch::Level::AVX2,
+            SimdDispatch::Level::AVX512, SimdDispatch::Level::NEON
+        };
+
+        const SimdDispatch::Level originalLevel = SimdDispatch::kernels().level;
+
+        uint32_t random = 13579u;
+        auto nextNoise = [&random]() {
+            random = random * 1664525u + 1013904223u;
+            return static_cast<float>(random >> 8) / 16777216.0f * 2.0f - 1.0f;
+        };
+
+        // Výstupy všech kernelů jedné úrovně za sebou (porovnání po bitech)
+        auto runKernels = [](const std::vector<float>& source, const std::vector<float>& envelope,
+                             const std::vector<float>& left, const std::vector<float>& right, int n) {
+            const SimdDispatch::Kernels& simd = SimdDispatch::kernels();
+            std::vector<float> mixLeft = left;
+            std::vector<float> mixRight = right;
+            std::vector<float> rampLeft = left;
+            std::vector<float> rampRight = right;
+            std::vector<float> interleaved(2 * n + 1, 0.0f);
+            std::vector<float> gain = left;
+            std::vector<float> gainRamp = right;
+
+            simd.mixStereo(mixLeft.data() + 1, mixRight.data() + 1, source.data() + 1, envelope.data() + 1,
+                           0.3f, 0.7f, n);
+            simd.mixStereoRamp(rampLeft.data() + 1, rampRight.data() + 1, source.data() + 1, envelope.data() + 1,
+                               0.9f, 0.1f, -0.0023f, 0.0041f, n);
+            simd.interleaveStereo(left.data() + 1, right.data() + 1, interleaved.data() + 1, n);
+            simd.applyGain(gain.data() + 1, n, 0.77f);
+            simd.applyGainRamp(gainRamp.data() + 1, n, 0.2f, 0.0031f);
+            const float peak = simd.peakAbs(left.data() + 1, right.data() + 1, n);
+
+            std::vector<float> all;
+            for (const std::vector<float>* result : { &mixLeft, &mixRight, &rampLeft, &rampRight,
+                                                      &interleaved, &gain, &gainRamp }) {
+                all.insert(all.end(), result->begin(), result->end());
+            }
+            all.push_back(peak);
+            return all;
+        };
+
+        bool passed = true;
+        int comparedLevels = 0;
+
+        for (SimdDispatch::Level level : levels) {
+            if (!SimdDispatch::selectLevel(level)) {
+                continue;   // CPU nebo build úroveň nepodporuje
+            }
+            ++comparedLevels;
+
+            int mismatches = 0;
+            for (int n : lengths) {
+                std::vector<float> source(2 * n + 2);
+                std::vector<float> envelope(n + 1);
+                std::vector<float> left(n + 1);
+                std::vector<float> right(n + 1);
+                for (float& x : source) x = nextNoise();
+                for (float& x : envelope) x = nextNoise();
+                for (float& x : left) x = nextNoise();
+                for (float& x : right) x = nextNoise();
+
+                const std::vector<float> tested = runKernels(source, envelope, left, right, n);
+                SimdDispatch::selectLevel(SimdDispatch::Level::Scalar);
+                const std::vector<float> reference = runKernels(source, envelope, left, right, n);
+                SimdDispatch::selectLevel(level);
+
+                if (tested.size() != reference.size() ||
+                    std::memcmp(tested.data(), reference.data(), tested.size() * sizeof(float)) != 0) {
+                    ++mismatches;
+                }
+            }
+
+            logger.log("runSimdDispatchTest", mismatches == 0 ? LogSeverity::Info : LogSeverity::Error,
+                       std::string(SimdDispatch::getLevelName(level)) + " vs Scalar: " +
+                       std::to_string(mismatches) + " mismatching lengths");
+            if (mismatches != 0) {
+                passed = false;
+            }
+        }
+
+        SimdDispatch::selectLevel(originalLevel);
+
+        if (comparedLevels == 0) {
+            logger.log("runSimdDispatchTest", LogSeverity::Info, "Only scalar kernels available - nothing to compare");
+        }
+
+        logger.log("runSimdDispatchTest", passed ? LogSeverity::Info : LogSeverity::Error,
+                   passed ? "SIMD dispatch test passed" : "SIMD dispatch test failed - levels are not bit-identical");
+        return passed;
+
+    } catch (const std::exception& e) {
+        SimdDispatch::selectLevel(SimdDispatch::getSupportedLevel());
+        logger.log("runSimdDispatchTest", LogSeverity::Error, "SIMD dispatch test failed: " + std::string(e.what()));
+        return false;
+    } catch (...) {
+        SimdDispatch::selectLevel(SimdDispatch::getSupportedLevel());
+        logger.log("runSimdDispatchTest", LogSeverity::Error, "SIMD dispatch test failed: unknown error");
+        return false;
+    }
+}
+
+bool runRenderPoolDeterminismTest(Logger& logger) {
+    try {
+        logger.log("runRenderPoolDeterminismTest", LogSeverity::Info, "Starting render pool determinism test");
+
+        // Testovací parametry - nepravidelné bloky, aby hranice sub-bloků nebyly zarovnané
+        const int sampleRate = ITHACA_DEFAULT_SAMPLE_RATE;
+        const int blockSizes[] = { 512, 300, 128, 77 };
+        const int maxBlockSize = 512;
+        const int maxBlocks = calculateBlocksForDuration(6.0, sampleRate, 128);
+        const int firstNote = 48;
+        const int chordSize = VOICE_RENDER_POOL_MIN_PARALLEL_VOICES + 4;
+        const int secondChordBlock = 12;
+        const int releaseBlock = 30;
+
+        const int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+        const int poolThreads = std::max(2, std::min(4, hardwareThreads));
+
+        // Dvě stejné instance (sine mode): jedno vlákno vs. pool
+        VoiceManager singleManager(logger, 8, sampleRate);
+        VoiceManager poolManager(logger, 8, sampleRate);
+        for (VoiceManager* manager : { &singleManager, &poolManager }) {
+            manager->prepareToPlay(maxBlockSize);
+            manager->setAllVoicesReleaseMIDI(20);
+            manager->setAllVoicesMasterGainMIDI(40, logger);
+        }
+        singleManager.setRenderThreadCount(1, logger);
+        poolManager.setRenderThreadCount(poolThreads, logger);
+
+        bool passed = true;
+        if (poolManager.getRenderThreadCount() < 2) {
+            logger.log("runRenderPoolDeterminismTest", LogSeverity::Error,
+                       "Render pool did not start worker threads");
+            passed = false;
+        }
+
+        std::vector<float> singleLeft(maxBlockSize), singleRight(maxBlockSize);
+        std::vector<float> poolLeft(maxBlockSize), poolRight(maxBlockSize);
+
+        // Stejná MIDI sekvence do obou instancí
+        auto noteOnChord = [&](int baseNote) {
+            for (int i = 0; i < chordSize; ++i) {
+                const uint8_t note = static_cast<uint8_t>(baseNote + i);
+                const uint8_t velocity = static_cast<uint8_t>(40 + (i * 37) % 87);
+                singleManager.setNoteStateMIDI(note, true, velocity);
+                poolManager.setNoteStateMIDI(note, true, velocity);
+            }
+        };
+        auto noteOffChord = [&](int baseNote, int count) {
+            for (int i = 0; i < count; ++i) {
+                const uint8_t note = static_cast<uint8_t>(baseNote + i);
+                singleManager.setNoteStateMIDI(note, false);
+                poolManager.setNoteStateMIDI(note, false);
+            }
+        };
+
+        int mismatchBlocks = 0;
+        int renderedBlocks = 0;
+        int maxActiveVoices = 0;
+        bool active = true;
+
+        noteOnChord(firstNote);
+
+        for (int block = 0; block < maxBlocks && active; ++block) {
+            // Druhý akord a release poloviny prvního uprostřed pasáže, pak release všeho
+            if (block == secondChordBlock) {
+                noteOffChord(firstNote, chordSize / 2);
+                noteOnChord(firstNote + chordSize);
+            }
+            if (block == releaseBlock) {
+                noteOffChord(firstNote, 2 * chordSize);
+            }
+
+            maxActiveVoices = std::max(maxActiveVoices, poolManager.getActiveVoicesCount());
+
+            const int blockSize = blockSizes[block % 4];
+            const bool singleActive = singleManager.processBlockUninterleaved(singleLeft.data(), singleRight.data(), blockSize);
+            const bool poolActive = poolManager.processBlockUninterleaved(poolLeft.data(), poolRight.data(), blockSize);
+
+            const size_t bytes = static_cast<size_t>(blockSize) * sizeof(float);
+            if (singleActive != poolActive ||
+                std::memcmp(singleLeft.data(), poolLeft.data(), bytes) != 0 ||
+                std::memcmp(singleRight.data(), poolRight.data(), bytes) != 0) {
+                ++mismatchBlocks;
+            }
+
+            active = singleActive || poolActive;
+            ++renderedBlocks;
+        }
+
+        if (active) {
+            logger.log("runRenderPoolDeterminismTest", LogSeverity::Error,
+                       "Voices did not finish within " + std::to_string(maxBlocks) + " blocks");
+            passed = false;
+        }
+
+        // Pool míchá paralelně jen od VOICE_RENDER_POOL_MIN_PARALLEL_VOICES slotů
+        if (maxActiveVoices < VOICE_RENDER_POOL_MIN_PARALLEL_VOICES) {
+            logger.log("runRenderPoolDeterminismTest", LogSeverity::Error,
+                       "Only " + std::to_string(maxActiveVoices) + " voices active - parallel mix not exercised");
+            passed = false;
+        }
+
+        if (mismatchBlocks > 0) {
+            logger.log("runRenderPoolDeterminismTest", LogSeverity::Error,
+                       std::to_string(poolThreads) + "-thread output differs from single-thread output in " +
+                       std::to_string(mismatchBlocks) + " of " + std::to_string(renderedBlocks) + " blocks");
+            passed = false;
+        }
+
+        logger.log("runRenderPoolDeterminismTest", passed ? LogSeverity::Info : LogSeverity::Error,
+                   passed ? "Render pool determinism test passed (" + std::to_string(renderedBlocks) + " blocks, " +
+                                std::to_string(maxActiveVoices) + " voices, " + std::to_string(poolThreads) + " threads)"
+                          : "Render pool determinism test failed");
+        return passed;
+
+    } catch (const std::exception& e) {
+        logger.log("runRenderPoolDeterminismTest", LogSeverity::Error,
+                   "Render pool determinism test failed: " + std::string(e.what()));
+        return false;
+    } catch (...) {
+        logger.log("runRenderPoolDeterminismTest", LogSeverity::Error, "Render pool determinism test failed: unknown error");
+        return false;
+    }
+}
+
+bool runSampleAccurateEventsTest(Logger& logger) {
+    try {
+        logger.log("runSampleAccurateEventsTest", LogSeverity::Info, "Starting sample-accurate MIDI events test");
+
+        // Testovací parametry
+        const int sampleRate = ITHACA_DEFAULT_SAMPLE_RATE;
+        const int blockSize = 512;
+        const int totalBlocks = 40;
+        const int noteOnOffset = 100;
+
+        // Události po blocích (v pořadí, v jakém je dostane processBlock())
+        std::vector<std::vector<MidiEvent>> blockEvents(totalBlocks);
+        blockEvents[1] = { MidiEvent(noteOnOffset, MidiEventType::NoteOn, 60, 127),
+                           MidiEvent(300, MidiEventType::LimiterThreshold, 20) };
+        // Dvě události na stejném offsetu: pedál, pak note-off (odloží se)
+        blockEvents[3] = { MidiEvent(200, MidiEventType::SustainPedal, 127),
+                           MidiEvent(200, MidiEventType::NoteOff, 60) };
+        blockEvents[6] = { MidiEvent(50, MidiEventType::SustainPedal, 0),
+                           MidiEvent(333, MidiEventType::LimiterThreshold, 90) };
+        blockEvents[8] = { MidiEvent(0, MidiEventType::NoteOn, 64, 110),
+                           MidiEvent(0, MidiEventType::NoteOn, 67, 90),
+                           MidiEvent(511, MidiEventType::SustainPedal, 127) };
+        // Offsety mimo blok: záporný → 0, příliš velký → poslední vzorek
+        blockEvents[11] = { MidiEvent(-5, MidiEventType::NoteOn, 72, 100),
+                            MidiEvent(blockSize + 200, MidiEventType::SustainPedal, 0) };
+        // Neseřazené offsety: opožděná událost padne na aktuální pozici
+        blockEvents[14] = { MidiEvent(400, MidiEventType::NoteOff, 64),
+                            MidiEvent(100, MidiEventType::NoteOff, 67),
+                            MidiEvent(250, MidiEventType::LimiterThreshold, 40) };
+        blockEvents[18] = { MidiEvent(7, MidiEventType::NoteOff, 72) };
+
+        // Dvě stejné instance (sine mode): processBlock() vs. ruční dělení na segmenty
+        VoiceManager eventManager(logger, 8, sampleRate);
+        VoiceManager referenceManager(logger, 8, sampleRate);
+        for (VoiceManager* manager : { &eventManager, &referenceManager }) {
+            manager->prepareToPlay(blockSize);
+            manager->setAllVoicesReleaseMIDI(10);
+            manager->setLimiterEnabledMIDI(127);
+            manager->setLimiterThresholdMIDI(127);
+            manager->setBBEDefinitionMIDI(80);
+        }
+
+        std::vector<float> eventLeft(blockSize), eventRight(blockSize);
+        std::vector<float> refLeft(blockSize), refRight(blockSize);
+
+        // Reference: sub-bloky jako renderSubBlock(), segment od začátku do pozice události
+        auto renderReference = [&](int begin, int end) {
+            for (int offset = begin; offset < end; offset += ITHACA_INTERNAL_BLOCK_SIZE) {
+                const int chunk = std::min(ITHACA_INTERNAL_BLOCK_SIZE, end - offset);
+                referenceManager.processBlockSegment(refLeft.data() + offset, refRight.data() + offset, chunk);
+                referenceManager.finalizeBlock(refLeft.data() + offset, refRight.data() + offset, chunk);
+            }
+        };
+
+        bool passed = true;
+        int mismatchBlocks = 0;
+
+        for (int block = 0; block < totalBlocks; ++block) {
+            const std::vector<MidiEvent>& events = blockEvents[block];
+            eventManager.processBlock(events.data(), events.data() + events.size(),
+                                      eventLeft.data(), eventRight.data(), blockSize);
+
+            std::fill(refLeft.begin(), refLeft.end(), 0.0f);
+            std::fill(refRight.begin(), refRight.end(), 0.0f);
+            int position = 0;
+            for (const MidiEvent& event : events) {
+                const int offset = std::max(position, std::max(0, std::min(event.sampleOffset, blockSize - 1)));
+                renderReference(position, offset);
+                referenceManager.handleMidiEvent(event);
+                position = offset;
+            }
+            renderReference(position, blockSize);
+
+            const size_t bytes = static_cast<size_t>(blockSize) * sizeof(float);
+            if (std::memcmp(eventLeft.data(), refLeft.data(), bytes) != 0 ||
+                std::memcmp(eventRight.data(), refRight.data(), bytes) != 0) {
+                ++mismatchBlocks;
+                logger.log("runSampleAccurateEventsTest", LogSeverity::Error,
+                           "Block " + std::to_string(block) + " differs from manual segment split");
+            }
+
+            // Note-on nesmí zaznít před svým offsetem, po něm ano
+            if (block == 1) {
+                float peakBefore = 0.0f;
+                float peakAfter = 0.0f;
+                for (int i = 0; i < blockSize; ++i) {
+                    const float peak = std::max(std::abs(eventLeft[i]), std::abs(eventRight[i]));
+                    if (i < noteOnOffset) {
+                        peakBefore = std::max(peakBefore, peak);
+                    } else {
+                        peakAfter = std::max(peakAfter, peak);
+                    }
+                }
+                if (peakBefore != 0.0f || peakAfter <= 0.0f) {
+                    std::ostringstream oss;
+                    oss << "Note-on at offset " << noteOnOffset << " not sample-accurate (peak before "
+                        << peakBefore << ", after " << peakAfter << ")";
+                    logger.log("runSampleAccurateEventsTest", LogSeverity::Error, oss.str());
+                    passed = false;
+                }
+            }
+        }
+
+        if (mismatchBlocks > 0) {
+            passed = false;
+        }
+
+        logger.log("runSampleAccurateEventsTest", passed ? LogSeverity::Info : LogSeverity::Error,
+                   passed ? "Sample-accurate MIDI events test passed" : "Sample-accurate MIDI events test failed");
+        return passed;
+
+    } catch (const std::exception& e) {
+        logger.log("runSampleAccurateEventsTest", LogSeverity::Error,
+                   "Sample-accurate MIDI events test failed: " + std::string(e.what()));
+        return false;
+    } catch (...) {
+        logger.log("runSampleAccurateEventsTest", LogSeverity::Error, "Sample-accurate MIDI events test failed: unknown error");
+        return false;
+    }
+}
+
+bool runSampleBankRegistryTest(Logger& logger) {
+    try {
+        logger.log("runSampleBankRegistryTest", LogSeverity::Info, "Starting sample bank registry test");
+
+        // Klíč, který jiné instance nepoužívají (sinusová banka, 3 velocity vrstvy)
+        const int sampleRate = 48000;
+        const int otherSampleRate = ITHACA_DEFAULT_SAMPLE_RATE;
+        const int velocityLayers = 3;
+
+        bool passed = true;
+        auto expectBankCount = [&](int expected, const std::string& stage) {
+            const int count = SampleBankRegistry::getLoadedBankCount();
+            if (count != expected) {
+                logger.log("runSampleBankRegistryTest", LogSeverity::Error,
+                           stage + ": " + std::to_string(count) + " loaded banks, expected " +
+                           std::to_string(expected));
+                passed = false;
+            }
+        };
+
+        // Banky ostatních instancí (např. hlavního VoiceManageru) se nezapočítávají
+        const int baseline = SampleBankRegistry::getLoadedBankCount();
+
+        auto first = std::make_unique<VoiceManager>(logger, velocityLayers, sampleRate);
+        expectBankCount(baseline + 1, "First instance");
+
+        auto second = std::make_unique<VoiceManager>(logger, velocityLayers, sampleRate);
+        expectBankCount(baseline + 1, "Second instance with the same key");
+
+        // Obě instance musí držet tentýž objekt banky (+ tento odkaz)
+        std::shared_ptr<const SampleBank> probe =
+            SampleBankRegistry::acquire(std::string(), sampleRate, velocityLayers, logger);
+        if (probe.use_count() != 3) {
+            logger.log("runSampleBankRegistryTest", LogSeverity::Error,
+                       "Bank has " + std::to_string(probe.use_count() - 1) + " owners besides the probe, expected 2");
+            passed = false;
+        }
+        const std::weak_ptr<const SampleBank> bank = probe;
+        probe.reset();
+
+        // Jiný sample rate = jiný klíč = vlastní banka, uvolněná se svou instancí
+        auto other = std::make_unique<VoiceManager>(logger, velocityLayers, otherSampleRate);
+        expectBankCount(baseline + 2, "Instance with a different sample rate");
+        other.reset();
+        expectBankCount(baseline + 1, "After destroying the different-key instance");
+
+        // Sdílená banka žije, dokud ji drží poslední instance
+        first.reset();
+        expectBankCount(baseline + 1, "After destroying the first owner");
+        if (bank.expired()) {
+            logger.log("runSampleBankRegistryTest", LogSeverity::Error, "Bank freed while still owned");
+            passed = false;
+        }
+
+        second.reset();
+        expectBankCount(baseline, "After destroying the last owner");
+        if (!bank.expired()) {
+            logger.log("runSampleBankRegistryTest", LogSeverity::Error, "Bank not freed after the last owner");
+            passed = false;
+        }
+
+        logger.log("runSampleBankRegistryTest", passed ? LogSeverity::Info : LogSeverity::Error,
+                   passed ? "Sample bank registry test passed" : "Sample bank registry test failed");
+        return passed;
+
+    } catch (const std::exception& e) {
+        logger.log("runSampleBankRegistryTest", LogSeverity::Error,
+                   "Sample bank registry test failed: " + std::string(e.what()));
+        return false;
+    } catch (...) {
+        logger.log("runSampleBankRegistryTest", LogSeverity::Error, "Sample bank registry test failed: unknown error");
+        return false;
+    }
+}
+
+/**
+ * @brief Projde všechny attack/release tabulky obou frekvencí (callback: data, délka)
+ */
+template <typename Visitor>
+static void forEachEnvelopeTable(Visitor&& visit) {
+    for (int sampleRate : { 44100, 48000 }) {
+        for (int midi = 0; midi <= 127; ++midi) {
+            const EnvelopeStaticData::EnvelopeIndex attack =
+                EnvelopeStaticData::getAttackTable(static_cast<uint8_t>(midi), sampleRate);
+            const EnvelopeStaticData::EnvelopeIndex release =
+                EnvelopeStaticData::getReleaseTable(static_cast<uint8_t>(midi), sampleRate);
+            visit(attack.data, attack.length);
+            visit(release.data, release.length);
+        }
+    }
+}
+
+bool runEnvelopeCacheTest(Logger& logger) {
+    const std::string cachePath =
+        (std::filesystem::temp_directory_path() / "ithaca_envelope_cache_test.bin").string();
+
+    // Po testu vždy zpět na konfigurovanou cache (žádný VoiceManager teď nerenderuje)
+    auto restore = [&]() {
+        EnvelopeStaticData::cleanup();
+        std::remove(cachePath.c_str());
+        EnvelopeStaticData::initialize(logger, EnvelopeStaticData::getConfiguredCachePath());
+    };
+
+    try {
+        logger.log("runEnvelopeCacheTest", LogSeverity::Info, "Starting envelope cache test");
+
+        // Rozložení EnvelopeCacheHeader: magic[8], version (offset 8), ..., tauDivisor (offset 36)
+        const std::streamoff versionOffset = 8;
+        const std::streamoff tauDivisorOffset = 36;
+        const size_t prefixSize = 64;  // Hlavička + začátek délek
+
+        bool passed = true;
+        auto check = [&](bool condition, const std::string& message) {
+            if (!condition) {
+                logger.log("runEnvelopeCacheTest", LogSeverity::Error, message);
+                passed = false;
+            }
+        };
+
+        // Soubor má stovky MB - čte a přepisuje se jen začátek
+        auto readPrefix = [&]() {
+            std::vector<char> prefix(prefixSize, 0);
+            std::ifstream in(cachePath, std::ios::binary);
+            in.read(prefix.data(), static_cast<std::streamsize>(prefix.size()));
+            return prefix;
+        };
+        auto patchFile = [&](std::streamoff offset, const void* bytes, size_t size) {
+            std::fstream file(cachePath, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(offset);
+            file.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+        };
+        auto fileSize = [&]() {
+            std::error_code ec;
+            const auto size = std::filesystem::file_size(cachePath, ec);
+            return ec ? static_cast<uintmax_t>(0) : size;
+        };
+
+        // Reference: čerstvě vygenerované tabulky bez cache
+        EnvelopeStaticData::cleanup();
+        EnvelopeStaticData::initialize(logger);
+        std::vector<float> generated;
+        forEachEnvelopeTable([&](const float* data, int length) {
+            generated.push_back(static_cast<float>(length));
+            if (data) generated.insert(generated.end(), data, data + length);
+        });
+
+        auto matchesGenerated = [&]() {
+            size_t position = 0;
+            bool identical = true;
+            forEachEnvelopeTable([&](const float* data, int length) {
+                if (!identical || position + 1 + static_cast<size_t>(length) > generated.size() ||
+                    generated[position] != static_cast<float>(length) || !data ||
+                    std::memcmp(generated.data() + position + 1, data, static_cast<size_t>(length) * sizeof(float)) != 0) {
+                    identical = false;
+                    return;
+                }
+                position += 1 + static_cast<size_t>(length);
+            });
+            return identical && position == generated.size();
+        };
+
+        // Bez souboru: vygenerovat a uložit
+        EnvelopeStaticData::cleanup();
+        std::remove(cachePath.c_str());
+        EnvelopeStaticData::initialize(logger, cachePath);
+        check(!EnvelopeStaticData::isMappedFromCache(), "Missing cache file reported as mapped");
+        const uintmax_t savedSize = fileSize();
+        const std::vector<char> savedPrefix = readPrefix();
+        check(savedSize > prefixSize, "Envelope cache was not saved: " + cachePath);
+
+        // Round trip: namapovaná cache musí být bitově shodná s generátorem
+        EnvelopeStaticData::cleanup();
+        EnvelopeStaticData::initialize(logger, cachePath);
+        check(EnvelopeStaticData::isMappedFromCache(), "Saved envelope cache was not mapped");
+        check(matchesGenerated(), "Tables mapped from cache differ from generated tables");
+
+        // Poškozené soubory: odmítnout, vygenerovat tabulky a cache přepsat platnou
+        uint32_t version;
+        float tauDivisor;
+        std::memcpy(&version, savedPrefix.data() + versionOffset, sizeof(version));
+        std::memcpy(&tauDivisor, savedPrefix.data() + tauDivisorOffset, sizeof(tauDivisor));
+
+        const std::pair<const char*, std::function<void()>> corruptions[] = {
+            { "truncated", [&]() { std::filesystem::resize_file(cachePath, savedSize - 100); } },
+            { "wrong magic", [&]() { const char magic = 'X'; patchFile(0, &magic, 1); } },
+            { "wrong version", [&]() { const uint32_t v = version + 1; patchFile(versionOffset, &v, sizeof(v)); } },
+            { "stale parameters", [&]() { const float t = tauDivisor * 1.5f; patchFile(tauDivisorOffset, &t, sizeof(t)); } },
+        };
+
+        for (const auto& corruption : corruptions) {
+            const std::string name(corruption.first);
+            if (savedSize <= prefixSize) break;
+
+            EnvelopeStaticData::cleanup();
+            corruption.second();
+            EnvelopeStaticData::initialize(logger, cachePath);
+            check(!EnvelopeStaticData::isMappedFromCache(), "Cache accepted: " + name);
+            check(matchesGenerated(), "Regenerated tables differ after rejected cache: " + name);
+            check(fileSize() == savedSize && readPrefix() == savedPrefix,
+                  "Cache not rewritten after rejected cache: " + name);
+        }
+
+        restore();
+
+        logger.log("runEnvelopeCacheTest", passed ? LogSeverity::Info : LogSeverity::Error,
+                   passed ? "Envelope cache test passed" : "Envelope cache test failed");
+        return passed;
+
+    } catch (const std::exception& e) {
+        restore();
+        logger.log("runEnvelopeCacheTest", LogSeverity::Error, "Envelope cache test failed: " + std::string(e.what()));
+        return false;
+    } catch (...) {
+        restore();
+        logger.log("runEnvelopeCacheTest", LogSeverity::Error, "Envelope cache test failed: unknown error");
+        return false;
+    }
+}
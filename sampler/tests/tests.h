@@ -30,4 +30,193 @@ bool runSimpleNoteTest(VoiceManager& voiceManager, Logger& logger);
  */
 bool runEnvelopeTest(VoiceManager& voiceManager, Logger& logger);
 
+/**
+ * @brief Regrese denormálů - žádné subnormální hodnoty během tichého doznívání
+ *
+ * Na konec DSP řetězce se dočasně vloží zpětnovazební one-pole sonda,
+ * akord s dlouhým release ji nabudí a pak doznívá, dokud stav sondy
+ * neklesne na nulu. S FTZ/DAZ v RT cestě nesmí sonda ani její vstup
+ * projít jedinou subnormální hodnotou (bez ochrany jich jsou tisíce).
+ * Master gain test nemění, release vrátí na výchozí hodnotu.
+ *
+ * @param voiceManager Reference na VoiceManager
+ * @param logger Reference na Logger
+ * @return true pokud doznívání proběhlo bez subnormálních hodnot
+ */
+bool runDenormalTailTest(VoiceManager& voiceManager, Logger& logger);
+
+/**
+ * @brief Rozhodnutí o předčasném ukončení neslyšitelného hlasu (audibility culling)
+ *
+ * Hlas nad syntetickým samplem se známým profilem dozvuku:
+ * - master gain 0 během držené noty hlas neukončí (po návratu gainu zní)
+ * - pokles zbytku samplu pod práh hlas ukončí dlouho před koncem samplu
+ * - během attack fáze se hlas neukončí nikdy, ani nad tichým samplem
+ *
+ * @param logger Reference na Logger
+ * @return true pokud všechna rozhodnutí odpovídají
+ */
+bool runVoiceRetireTest(Logger& logger);
+
+/**
+ * @brief Idle fast path - přeskočení LFO/DSP bez hlasů nemění výstup
+ *
+ * Dvě stejně nastavené instance (LFO pan, BBE, limiter, konvoluce s dozvukem)
+ * hrají stejné noty. Jedna běží přes processBlockUninterleaved() s idle
+ * fast path, druhá volá LFO a DSP chain na každý blok (processBlockSegment()
+ * + finalizeBlock()). Výstup musí být bitově shodný, dozvuk efektu po
+ * skončení hlasů nesmí být uříznut a po doznění musí fast path přeskakovat.
+ *
+ * @param logger Reference na Logger
+ * @return true pokud je výstup shodný a dozvuk kompletní
+ */
+bool runIdleFastPathTest(Logger& logger);
+
+/**
+ * @brief Multi-timbral režim - routing partů, limit polyfonie a krádež hlasů
+ *
+ * - nota na kanálu patří svému partu (gain partu, note-off jen vlastní noty)
+ * - part na limitu polyfonie ukradne svůj nejstarší hlas, ostatní party nechá
+ * - plný pool ukradne nejstarší releasing, pak nejstarší sustaining hlas
+ *   (podle pořadí note-on, ne podle indexu)
+ * - ukradený hlas dozní přes damping buffer bez skoku ve výstupu
+ *
+ * @param logger Reference na Logger
+ * @return true pokud všechna přidělení odpovídají
+ */
+bool runMultiTimbralTest(Logger& logger);
+
+/**
+ * @brief Vyhlazení sdílených parametrů hlasu po vzorcích (bez zipper noise)
+ *
+ * Hlas nad DC samplem: změna master gainu a panu ve sdíleném bloku
+ * (VoiceParams) se projeví lineární rampou - žádný skok mezi sousedními
+ * vzorky nepřekročí krok vyhlazení, ani na hranici sub-bloku.
+ *
+ * @param logger Reference na Logger
+ * @return true pokud jsou změny plynulé a dosáhnou cíle
+ */
+bool runParameterSmoothingTest(Logger& logger);
+
+/**
+ * @brief Vypnutí bass boostu BBE bez kliknutí
+ *
+ * Basový tón přes BBE s plným bass boostem, poté boost na 0. Low shelf
+ * zůstává v lanes (0 dB) se svým stavem - skok mezi vzorky při doběhu
+ * nesmí překročit skok ustáleného signálu.
+ *
+ * @param logger Reference na Logger
+ * @return true pokud vypnutí boostu nezpůsobí skok
+ */
+bool runBassBoostSwitchTest(Logger& logger);
+
+/**
+ * @brief Stress test změn DspChain za běhu audia
+ *
+ * Audio thread volá process() bez přestávky, řídicí thread mezitím
+ * náhodně vkládá, odebírá a přesouvá efekty. Každý blok musí odpovídat
+ * celému publikovanému grafu, žádný efekt nesmí být uvolněn během
+ * process() a po reclaimRetired() nesmí zůstat žádný vyřazený efekt.
+ *
+ * @param logger Reference na Logger
+ * @return true pokud chain vydrží souběžnou rekonfiguraci
+ */
+bool runDspChainStressTest(Logger& logger);
+
+/**
+ * @brief Fast path limiteru proti per-sample referenci
+ *
+ * Tichý/hlasitý šum v nepravidelných blocích: bloky s usazenou obálkou
+ * (fast path) i bloky v release (plná smyčka). Usazené bloky pod
+ * thresholdem musí projít beze změny, ostatní se smí od reference
+ * s přesným dělením lišit jen o chybu rcp + Newton-Raphson (< 1e-6),
+ * o stejnou mez smí výstup přesáhnout threshold.
+ *
+ * @param logger Reference na Logger
+ * @return true pokud obě cesty odpovídají referenci
+ */
+bool runLimiterFastPathTest(Logger& logger);
+
+/**
+ * @brief Konvoluční efekt proti přímé konvoluci a plynulá změna mixu
+ *
+ * - stereo šumová IR přes head, tail0 i tail (background worker), vstup
+ *   v nepravidelných blocích s tichou mezerou delší než dozvuk; výstup
+ *   (mix 127) se porovná s přímou konvolucí v double (relativně < 1e-5)
+ * - mix 0 → 127 s invertující IR na DC vstupu: wet gain se mění rampou,
+ *   žádný skok mezi vzorky a výstup dojede na cíl
+ *
+ * @param logger Reference na Logger
+ * @return true pokud konvoluce odpovídá referenci a mix nepraská
+ */
+bool runConvolutionTest(Logger& logger);
+
+/**
+ * @brief Bitová shoda SIMD kernelů napříč úrovněmi (SimdDispatch::selectLevel)
+ *
+ * Každá úroveň podporovaná CPU a buildem (SSE2, AVX2, AVX-512, NEON) se
+ * porovná se skalárními kernely - mixStereo, mixStereoRamp, interleave,
+ * gain, gain ramp i peak scan, nezarovnané vstupy a délky se zbytky.
+ * Na konci se vrátí původně aktivní úroveň.
+ *
+ * @param logger Reference na Logger
+ * @return true pokud jsou výstupy všech úrovní bitově shodné
+ */
+bool runSimdDispatchTest(Logger& logger);
+
+/**
+ * @brief Bitová shoda mixu hlasů v jednom vlákně a ve VoiceRenderPool
+ *
+ * Dvě stejné instance (sine mode) s setRenderThreadCount(1) a s více vlákny
+ * renderují stejnou pasáž v nepravidelných blocích: akord alespoň
+ * VOICE_RENDER_POOL_MIN_PARALLEL_VOICES hlasů, uprostřed release části
+ * a další note-on, nakonec release všeho až do ticha. Každý blok se
+ * porovná memcmp.
+ *
+ * @param logger Reference na Logger
+ * @return true pokud jsou výstupy obou instancí bitově shodné
+ */
+bool runRenderPoolDeterminismTest(Logger& logger);
+
+/**
+ * @brief Sample-accurate MIDI události v processBlock(eventsBegin, eventsEnd, ...)
+ *
+ * Note-on, CC64 a změna thresholdu limiteru uvnitř bloku, dvě události na
+ * stejném offsetu, offsety mimo blok (záporný, za koncem) i neseřazené
+ * offsety. Každý blok se porovná memcmp s ruční referencí: processBlockSegment()
+ * + finalizeBlock() po sub-blocích až k offsetu události, pak handleMidiEvent().
+ * Note-on navíc nesmí zaznít před svým offsetem.
+ *
+ * @param logger Reference na Logger
+ * @return true pokud všechny události platí přesně od svého vzorku
+ */
+bool runSampleAccurateEventsTest(Logger& logger);
+
+/**
+ * @brief Sdílení a životnost bank v SampleBankRegistry
+ *
+ * Dvě instance VoiceManager se stejným klíčem (adresář, sample rate,
+ * velocity vrstvy) musí držet jednu banku, instance s jiným sample rate
+ * vlastní. getLoadedBankCount() sleduje acquire i uvolnění a banka zanikne
+ * až se zánikem posledního držitele.
+ *
+ * @param logger Reference na Logger
+ * @return true pokud registr banky sdílí a včas uvolňuje
+ */
+bool runSampleBankRegistryTest(Logger& logger);
+
+/**
+ * @brief Binární cache obálek: round trip a odmítnutí neplatných souborů
+ *
+ * Uložená cache se musí namapovat bitově shodná s čerstvě vygenerovanými
+ * tabulkami. Zkrácený soubor, špatný magic, jiná verze a zastaralé parametry
+ * generátoru se odmítnou, tabulky se vygenerují a cache přepíše platnou.
+ * Test dočasně reinicializuje EnvelopeStaticData - volat bez běžícího audia;
+ * na konci se obnoví konfigurovaná cache.
+ *
+ * @param logger Reference na Logger
+ * @return true pokud cache funguje i odmítá poškozené soubory
+ */
+bool runEnvelopeCacheTest(Logger& logger);
+
 #endif // TESTS_H
@@ -33,26 +33,43 @@ Voice::Voice()
       instrument_(nullptr),
       instrumentLoader_(nullptr),
       sampleRate_(0),
+      envelope_(nullptr),
       state_(VoiceState::Idle),
       position_(0),
       currentVelocityLayer_(0),
-      envelope_gain_(0.0f),
-      velocity_gain_(0.0f),
       master_gain_(1.0f),
+      velocity_gain_(0.0f),
+      envelope_gain_(0.0f),
       pan_(0.0f),
-      envelope_(nullptr),
+      params_(nullptr),
+      overrideMask_(0),
+      masterGainOverride_(1.0f),
+      panOverride_(0.0f),
+      stereoFieldOverride_(0),
+      paramStepPerSample_(0.0f),
+      channelGainLeft_(0.0f),
+      channelGainRight_(0.0f),
+      channelGainStartLeft_(0.0f),
+      channelGainStartRight_(0.0f),
+      channelGainStepLeft_(0.0f),
+      channelGainStepRight_(0.0f),
+      stereoFieldGainLeft_(1.0f),
+      stereoFieldGainRight_(1.0f),
+      stereoFieldAmount_(0),
       envelope_attack_position_(0),
       envelope_release_position_(0),
       release_start_gain_(1.0f),
       dampingLength_(0),
       dampingPosition_(0),
       dampingActive_(false),
-      stereoFieldGainLeft_(1.0f),
-      stereoFieldGainRight_(1.0f),
-      stereoFieldAmount_(0) {
+      outputLevelEstimate_(0.0f),
+      audibilityThreshold_(0.0f),
+      retireFadeLength_(0),
+      retireFadePosition_(0),
+      retiring_(false) {
     
-    // Pre-allocate gain buffer with large reserve (64KB for maximum buffer size)
-    gainBuffer_.reserve(16384);
+    // Gain buffer má pevnou velikost jednoho sub-bloku (žádná alokace na audio threadu)
+    gainBuffer_.fill(0.0f);
     
     // Pre-allocate damping buffers (will be properly sized in initialize())
     // Reserve ~21ms @ 48kHz = 1024 samples
@@ -65,26 +82,43 @@ Voice::Voice(uint8_t midiNote)
       instrument_(nullptr),
       instrumentLoader_(nullptr),
       sampleRate_(0),
+      envelope_(nullptr),
       state_(VoiceState::Idle),
       position_(0),
       currentVelocityLayer_(0),
-      envelope_gain_(0.0f),
-      velocity_gain_(0.0f),
       master_gain_(1.0f),
+      velocity_gain_(0.0f),
+      envelope_gain_(0.0f),
       pan_(0.0f),
-      envelope_(nullptr),
+      params_(nullptr),
+      overrideMask_(0),
+      masterGainOverride_(1.0f),
+      panOverride_(0.0f),
+      stereoFieldOverride_(0),
+      paramStepPerSample_(0.0f),
+      channelGainLeft_(0.0f),
+      channelGainRight_(0.0f),
+      channelGainStartLeft_(0.0f),
+      channelGainStartRight_(0.0f),
+      channelGainStepLeft_(0.0f),
+      channelGainStepRight_(0.0f),
+      stereoFieldGainLeft_(1.0f),
+      stereoFieldGainRight_(1.0f),
+      stereoFieldAmount_(0),
       envelope_attack_position_(0),
       envelope_release_position_(0),
       release_start_gain_(1.0f),
       dampingLength_(0),
       dampingPosition_(0),
       dampingActive_(false),
-      stereoFieldGainLeft_(1.0f),
-      stereoFieldGainRight_(1.0f),
-      stereoFieldAmount_(0) {
+      outputLevelEstimate_(0.0f),
+      audibilityThreshold_(0.0f),
+      retireFadeLength_(0),
+      retireFadePosition_(0),
+      retiring_(false) {
     
-    // Pre-allocate gain buffer with large reserve (64KB for maximum buffer size)
-    gainBuffer_.reserve(16384);
+    // Gain buffer má pevnou velikost jednoho sub-bloku (žádná alokace na audio threadu)
+    gainBuffer_.fill(0.0f);
     
     // Pre-allocate damping buffers (will be properly sized in initialize())
     // Reserve ~21ms @ 48kHz = 1024 samples
@@ -141,6 +175,15 @@ void Voice::initialize(const Instrument& instrument, int sampleRate,
     dampingBufferLeft_.resize(dampingLength_);
     dampingBufferRight_.resize(dampingLength_);
     
+    // ===== AUDIBILITY THRESHOLD AND RETIRE FADE =====
+
+    audibilityThreshold_ = std::pow(10.0f, ITHACA_VOICE_AUDIBILITY_THRESHOLD_DB / 20.0f);
+    retireFadeLength_ = std::max(1, static_cast<int>((ITHACA_VOICE_RETIRE_FADE_MS / 1000.0f) * sampleRate_));
+
+    // ===== SHARED PARAMETER SMOOTHING =====
+
+    paramStepPerSample_ = 1.0f / ((ITHACA_VOICE_PARAM_SMOOTHING_MS / 1000.0f) * sampleRate_);
+
     // ===== RESET STATE =====
     
     // Reset all states for clean start
@@ -148,18 +191,11 @@ void Voice::initialize(const Instrument& instrument, int sampleRate,
     
     // ===== CONFIGURE ENVELOPE =====
     
+    envelope_->setSampleRate(sampleRate_);
     envelope_->setAttackMIDI(attackMIDI);
     envelope_->setReleaseMIDI(releaseMIDI);
     envelope_->setSustainLevelMIDI(sustainMIDI);
 
-    // ===== VERIFY GAIN BUFFER =====
-    
-    if (gainBuffer_.capacity() < 16384) {
-        const std::string errorMsg = "[Voice/initialize] warning: gainBuffer capacity insufficient, attempting reserve";
-        logger.log("Voice/initialize", LogSeverity::Warning, errorMsg);
-        gainBuffer_.reserve(16384);
-    }
-    
     // ===== LOG INITIALIZATION SUCCESS =====
     
     logger.log("Voice/initialize", LogSeverity::Info,
@@ -171,21 +207,9 @@ void Voice::initialize(const Instrument& instrument, int sampleRate,
 }
 
 void Voice::prepareToPlay(int maxBlockSize) noexcept {
-    // ===== BUFFER SIZE VALIDATION =====
-
-    // Critical errors must be logged even in RT context for visibility
-    if (maxBlockSize > 16384) {
-        std::cerr << "[Voice/prepareToPlay] error: Block size " << maxBlockSize
-                  << " exceeds pre-allocated buffer capacity 16384" << std::endl;
-        return; // Fail gracefully but visibly
-    }
-    
-    // ===== RESIZE GAIN BUFFER IF NEEDED =====
-    
-    // Resize only if buffer is smaller and we're in safe context
-    if (gainBuffer_.size() < static_cast<size_t>(maxBlockSize)) {
-        gainBuffer_.resize(maxBlockSize);
-    }
+    // Libovolná velikost bloku hostitele: processBlock() i VoiceManager dělí bloky
+    // na sub-bloky ITHACA_INTERNAL_BLOCK_SIZE, gain buffer tak nikdy neroste
+    (void)maxBlockSize;
 }
 
 void Voice::cleanup(Logger& logger) {
@@ -207,6 +231,23 @@ void Voice::reinitialize(const Instrument& instrument, int sampleRate,
            std::to_string(midiNote_));
 }
 
+void Voice::retarget(uint8_t midiNote, const Instrument& instrument, Envelope& envelope,
+                     const VoiceParams& params) noexcept {
+    // Dozvuk předchozí noty do damping bufferu, dokud ještě ukazujeme na její data
+    if (state_ != VoiceState::Idle) {
+        captureDampingBuffer();
+        state_ = VoiceState::Idle;
+    }
+
+    midiNote_ = midiNote;
+    instrument_ = &instrument;
+    envelope_ = &envelope;
+    params_ = &params;
+
+    // Stereo pole závisí na notě
+    calculateStereoFieldGains();
+}
+
 // =====================================================================
 // NOTE CONTROL
 // =====================================================================
@@ -257,12 +298,19 @@ void Voice::startNote(uint8_t velocity) noexcept {
     
     // Update velocity gain with logarithmic scaling
     updateVelocityGain(velocity);
+
+    // Nová nota převezme sdílené parametry hned, bez vyhlazení
+    syncParameters(0);
     
     // Initialize attack phase
     state_ = VoiceState::Attacking;
     position_ = 0;
     envelope_gain_ = 0.0f;
     envelope_attack_position_ = 0;
+
+    // Nová nota je vždy slyšitelná - zrušit případný micro-fade
+    retiring_ = false;
+    retireFadePosition_ = 0;
 }
 
 void Voice::stopNote() noexcept {
@@ -307,10 +355,13 @@ void Voice::setSustainLevelMIDI(uint8_t midi_value) noexcept {
 // =====================================================================
 
 void Voice::setPan(float pan) noexcept {
-    pan_ = pan;
+    panOverride_ = pan;
+    overrideMask_ |= OVERRIDE_PAN;
 }
 
 void Voice::setStereoFieldAmountMIDI(uint8_t midiValue) noexcept {
+    stereoFieldOverride_ = midiValue;
+    overrideMask_ |= OVERRIDE_STEREO_FIELD;
     stereoFieldAmount_ = midiValue;
     
     // Immediately calculate and cache stereo field gains
@@ -321,10 +372,64 @@ void Voice::setStereoFieldAmountMIDI(uint8_t midiValue) noexcept {
 void Voice::setMasterGain(float gain) noexcept {
     // RT-safe version: silent validation without logging
     if (gain >= 0.0f && gain <= 1.0f) {
-        master_gain_ = gain;
+        masterGainOverride_ = gain;
+        overrideMask_ |= OVERRIDE_MASTER_GAIN;
     }
 }
 
+void Voice::syncParameters(int frames) noexcept {
+    // Cíl: per-voice override, jinak sdílený blok, jinak beze změny
+    float gainTarget = master_gain_;
+    float panTarget = pan_;
+    uint8_t stereoTarget = stereoFieldAmount_;
+
+    if (params_) {
+        gainTarget = params_->getMasterGain();
+        panTarget = params_->getPan();
+        stereoTarget = params_->getStereoFieldAmountMIDI();
+    }
+    if (overrideMask_ & OVERRIDE_MASTER_GAIN) gainTarget = masterGainOverride_;
+    if (overrideMask_ & OVERRIDE_PAN) panTarget = panOverride_;
+    if (overrideMask_ & OVERRIDE_STEREO_FIELD) stereoTarget = stereoFieldOverride_;
+
+    // Lineární krok na sub-blok, cíl se vždy přesně dosáhne
+    if (frames > 0) {
+        const float maxStep = paramStepPerSample_ * static_cast<float>(frames);
+        master_gain_ += std::max(-maxStep, std::min(maxStep, gainTarget - master_gain_));
+        pan_ += std::max(-maxStep, std::min(maxStep, panTarget - pan_));
+    } else {
+        master_gain_ = gainTarget;
+        pan_ = panTarget;
+    }
+
+    // Stereo field je diskrétní (MIDI) - přepočet gainů jen při změně
+    if (stereoTarget != stereoFieldAmount_) {
+        stereoFieldAmount_ = stereoTarget;
+        calculateStereoFieldGains();
+    }
+
+    // Kanálové gainy na konci sub-bloku; mix k nim jde po vzorcích lineární rampou
+    float targetLeft, targetRight;
+    calculateChannelGains(targetLeft, targetRight);
+
+    if (frames > 0 && (targetLeft != channelGainLeft_ || targetRight != channelGainRight_)) {
+        const float invFrames = 1.0f / static_cast<float>(frames);
+        channelGainStartLeft_ = channelGainLeft_;
+        channelGainStartRight_ = channelGainRight_;
+        channelGainStepLeft_ = (targetLeft - channelGainLeft_) * invFrames;
+        channelGainStepRight_ = (targetRight - channelGainRight_) * invFrames;
+    } else {
+        // Ustálené parametry (nebo nová nota) - konstantní gain, stejný mix jako bez rampy
+        channelGainStartLeft_ = targetLeft;
+        channelGainStartRight_ = targetRight;
+        channelGainStepLeft_ = 0.0f;
+        channelGainStepRight_ = 0.0f;
+    }
+
+    channelGainLeft_ = targetLeft;
+    channelGainRight_ = targetRight;
+}
+
 // =====================================================================
 // DEBUG AND DIAGNOSTICS
 // =====================================================================
@@ -366,6 +471,14 @@ void Voice::resetVoiceState() noexcept {
     velocity_gain_ = 0.0f;
     envelope_gain_ = 0.0f;
     pan_ = 0.0f;
+    overrideMask_ = 0;
+
+    channelGainLeft_ = 0.0f;
+    channelGainRight_ = 0.0f;
+    channelGainStartLeft_ = 0.0f;
+    channelGainStartRight_ = 0.0f;
+    channelGainStepLeft_ = 0.0f;
+    channelGainStepRight_ = 0.0f;
     
     // ===== RESET ENVELOPE STATE =====
     
@@ -377,6 +490,11 @@ void Voice::resetVoiceState() noexcept {
     
     dampingPosition_ = 0;
     dampingActive_ = false;
+    // ===== RESET AUDIBILITY STATE =====
+
+    outputLevelEstimate_ = 0.0f;
+    retireFadePosition_ = 0;
+    retiring_ = false;
 }
 
 bool Voice::isVoiceReady() const noexcept {
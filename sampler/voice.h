@@ -6,9 +6,11 @@
 #include <atomic>
 #include <cstring>
 #include <vector>
+#include <array>
 #include "instrument_loader.h"
 #include "core_logger.h"
 #include "envelopes/envelope.h"
+#include "voice_params.h"
 
 // ===== DAMPING RELEASE CONFIGURATION =====
 // Duration of damping release envelope for retrigger click elimination
@@ -16,6 +18,35 @@
 #define DAMPING_RELEASE_MS 3.0f  // Milliseconds
 #endif
 
+// ===== INTERNAL SUB-BLOCK SIZE =====
+// Fallback pro nadřazený IthacaConfig.h bez této volby
+#ifndef ITHACA_INTERNAL_BLOCK_SIZE
+#define ITHACA_INTERNAL_BLOCK_SIZE 128  // Frames, gain buffer hlasu i mix lanes
+#endif
+
+static_assert(ITHACA_INTERNAL_BLOCK_SIZE >= 16 && ITHACA_INTERNAL_BLOCK_SIZE <= 4096,
+              "ITHACA_INTERNAL_BLOCK_SIZE must be 16-4096 frames");
+
+// ===== AUDIBILITY-BASED VOICE TERMINATION =====
+// Fallback pro nadřazený IthacaConfig.h bez těchto voleb
+#ifndef ITHACA_ENABLE_VOICE_AUDIBILITY_CULLING
+#define ITHACA_ENABLE_VOICE_AUDIBILITY_CULLING 1
+#endif
+
+#ifndef ITHACA_VOICE_AUDIBILITY_THRESHOLD_DB
+#define ITHACA_VOICE_AUDIBILITY_THRESHOLD_DB -90.0f  // dBFS, úroveň noty (velocity * obálka * sample) před master gainem
+#endif
+
+#ifndef ITHACA_VOICE_RETIRE_FADE_MS
+#define ITHACA_VOICE_RETIRE_FADE_MS 5.0f  // Milliseconds, micro-fade před ukončením hlasu
+#endif
+
+// ===== SHARED PARAMETER SMOOTHING =====
+// Fallback pro nadřazený IthacaConfig.h bez této volby
+#ifndef ITHACA_VOICE_PARAM_SMOOTHING_MS
+#define ITHACA_VOICE_PARAM_SMOOTHING_MS 20.0f  // Milliseconds, plný rozsah master gainu / panu
+#endif
+
 // ===== VELOCITY LAYER MODULATION CONFIGURATION =====
 // Fine-tune gain adjustment within velocity layers for smooth dynamic response
 #ifndef VELOCITY_LAYER_MODULATION
@@ -60,6 +91,30 @@ struct AudioData {
     AudioData(float l, float r) : left(l), right(r) {}
 };
 
+/**
+ * @struct VoiceRenderBatch
+ * @brief Horký stav aktivních hlasů pro jeden blok ve formě SoA (structure-of-arrays)
+ *
+ * VoiceManager v první smyčce projde aktivní hlasy, každý krokuje obálku
+ * a zapíše sem jen to, co mix potřebuje (zdroj, délku, gain obálky,
+ * složené kanálové gainy a jejich krok na vzorek). Druhá smyčka pak mixuje souvislá pole
+ * bez přeskakování přes velké Voice objekty.
+ *
+ * @note Platnost slotů: do dalšího volání Voice::prepareRenderBlock()
+ */
+struct VoiceRenderBatch {
+    int count = 0;
+    std::array<const float*, ITHACA_MAX_VOICES> source{};        // Prokládané stereo od aktuální pozice
+    std::array<const float*, ITHACA_MAX_VOICES> envelopeGains{}; // Per-sample gain obálky (gainBuffer_ hlasu)
+    std::array<int, ITHACA_MAX_VOICES> frames{};                 // Počet vzorků k mixu
+    std::array<float, ITHACA_MAX_VOICES> gainLeft{};             // velocity * pan * master * stereo field (L)
+    std::array<float, ITHACA_MAX_VOICES> gainRight{};            // velocity * pan * master * stereo field (R)
+    std::array<float, ITHACA_MAX_VOICES> gainStepLeft{};         // Krok gainLeft na vzorek (vyhlazení parametrů)
+    std::array<float, ITHACA_MAX_VOICES> gainStepRight{};        // Krok gainRight na vzorek (vyhlazení parametrů)
+
+    void clear() noexcept { count = 0; }
+};
+
 /**
  * @enum VoiceState
  * @brief Voice lifecycle states for envelope and processing control
@@ -108,7 +163,7 @@ public:
      * @brief Default constructor with pre-allocated buffers
      * 
      * Pre-allocates:
-     * - 64KB gain buffer for envelope processing
+     * - Gain buffer for one internal sub-block (ITHACA_INTERNAL_BLOCK_SIZE frames)
      * - ~1024 samples for damping buffers (sized properly in initialize())
      */
     Voice();
@@ -146,8 +201,9 @@ public:
 
     /**
      * @brief Prepare voice for audio processing with specified buffer size
-     * @param maxBlockSize Maximum expected block size from DAW
-     * @note RT-safe: only validates, no allocations if pre-allocation sufficient
+     * @param maxBlockSize Maximum expected block size from DAW (libovolná)
+     * @note RT-safe: gain buffer má pevnou velikost sub-bloku, delší bloky
+     *       processBlock() zpracuje po částech - nic se nealokuje ani nepřeskočí
      */
     void prepareToPlay(int maxBlockSize) noexcept;
 
@@ -179,6 +235,30 @@ public:
                  const InstrumentLoader* instrumentLoader,
                  uint8_t attackMIDI = 0, uint8_t releaseMIDI = 16, uint8_t sustainMIDI = 127);
 
+    /**
+     * @brief Přesměruje hlas na jinou notu a obálku (multi-timbral voice pool)
+     *
+     * Hraje-li hlas, jeho aktuální zvuk se nejprve zachytí do damping bufferu
+     * (stejně jako při retriggeru) a hlas přejde do Idle - následný startNote()
+     * tak začne novou notu bez kliku a bez druhého zachycení.
+     * Damping buffery i sample rate zůstávají z initialize().
+     *
+     * @param midiNote Nová MIDI nota (0-127)
+     * @param instrument Instrument nové noty (ze stejné banky)
+     * @param envelope Obálka partu, který hlas vlastní
+     * @param params Blok parametrů partu, který hlas vlastní
+     * @note RT-safe: bez alokací a logování
+     */
+    void retarget(uint8_t midiNote, const Instrument& instrument, Envelope& envelope,
+                  const VoiceParams& params) noexcept;
+
+    /**
+     * @brief Naváže hlas na sdílený blok parametrů (master gain, pan, stereo field)
+     * @param params Blok vlastněný VoiceManagerem (musí hlas přežít)
+     * @note Hlas blok čte na začátku každého sub-bloku (viz VoiceParams)
+     */
+    void bindParameters(const VoiceParams& params) noexcept { params_ = &params; }
+
     // ===== NOTE CONTROL =====
 
     /**
@@ -214,6 +294,7 @@ public:
      * @brief Set attack time via MIDI value
      * @param midi_value MIDI value (0-127) for attack speed
      * @note RT-safe
+     * @note Obálka je sdílená - změna platí pro všechny hlasy se stejnou obálkou
      */
     void setAttackMIDI(uint8_t midi_value) noexcept;
 
@@ -268,19 +349,61 @@ public:
      * 
      * @param outputLeft Left channel output buffer (additive mixing)
      * @param outputRight Right channel output buffer (additive mixing)
-     * @param samplesPerBlock Number of samples to process
-     * @param panBuffer Optional per-sample pan buffer for LFO panning (nullptr = use static pan_)
+     * @param samplesPerBlock Number of samples to process (any size, split into
+     *                        ITHACA_INTERNAL_BLOCK_SIZE sub-blocks internally)
      * @return true if voice remains active
      * @note RT-safe: no allocations, pre-calculated gains
      */
     bool processBlock(float* outputLeft, float* outputRight, int samplesPerBlock) noexcept;
 
+    /**
+     * @brief Batch rendering fáze 1a: přimixuje aktivní damping buffer (retrigger)
+     * @param outputLeft Levý výstupní buffer (aditivně)
+     * @param outputRight Pravý výstupní buffer (aditivně)
+     * @param samplesPerBlock Počet vzorků
+     * @note RT-safe, no-op pokud damping neběží
+     */
+    void mixDampingBlock(float* outputLeft, float* outputRight, int samplesPerBlock) noexcept;
+
+    /**
+     * @brief Batch rendering fáze 1b: krok obálky a zápis slotu do SoA batche
+     *
+     * Stejná logika jako processBlock() (stavový automat obálky, posun pozice,
+     * konec vzorku), ale místo mixu zapíše zdroj a gainy do batch.
+     * Damping se zde NEzpracovává - viz mixDampingBlock().
+     *
+     * @param samplesPerBlock Počet vzorků, nejvýše ITHACA_INTERNAL_BLOCK_SIZE
+     *                        (slot ukazuje na gain buffer hlasu - VoiceManager dělí segmenty)
+     * @param batch Cílový batch (slot se přidá jen pokud je co mixovat)
+     * @return true pokud hlas zůstává aktivní
+     * @note RT-safe
+     */
+    bool prepareRenderBlock(int samplesPerBlock, VoiceRenderBatch& batch) noexcept;
+
+    /**
+     * @brief Batch rendering fáze 2: mixovací jádro jednoho slotu
+     * @param outputLeft Levý výstupní buffer (aditivně)
+     * @param outputRight Pravý výstupní buffer (aditivně)
+     * @param stereoSource Prokládaná stereo data
+     * @param envelopeGains Per-sample gain obálky
+     * @param leftGain Složený gain levého kanálu před prvním vzorkem
+     * @param rightGain Složený gain pravého kanálu před prvním vzorkem
+     * @param leftStep Krok gainu levého kanálu na vzorek (vzorek i: leftGain + leftStep · (i + 1))
+     * @param rightStep Krok gainu pravého kanálu na vzorek
+     * @param numSamples Počet vzorků
+     * @note RT-safe, statická - sdílená processBlock() i VoiceRenderPool.
+     *       Nulové kroky (ustálené parametry) mixují konstantním gainem.
+     */
+    static void mixSamples(float* outputLeft, float* outputRight, const float* stereoSource,
+                           const float* envelopeGains, float leftGain, float rightGain,
+                           float leftStep, float rightStep, int numSamples) noexcept;
+
     // ===== GAIN CONTROL =====
 
     /**
-     * @brief Set pan position
+     * @brief Set pan position (per-voice override)
      * @param pan Pan value (-1.0 = hard left, 0.0 = center, +1.0 = hard right)
-     * @note RT-safe
+     * @note RT-safe, má přednost před sdíleným blokem až do clearParameterOverrides()
      */
     void setPan(float pan) noexcept;
     
@@ -292,16 +415,22 @@ public:
      * Stereo field gains are calculated immediately and cached for RT performance.
      * 
      * @param midiValue MIDI value 0-127 (0 = disabled/mono, 127 = maximum stereo width ±20%)
-     * @note RT-safe, pre-calculates gains
+     * @note RT-safe, pre-calculates gains; per-voice override sdíleného bloku
      */
     void setStereoFieldAmountMIDI(uint8_t midiValue) noexcept;
 
     /**
-     * @brief Set master gain with validation
-     * @param gain Master gain (0.0-1.0)
-     * @param logger Reference to Logger
+     * @brief Set master gain with validation (per-voice override)
+     * @param gain Master gain (0.0-1.0), jiné hodnoty se ignorují
+     * @note RT-safe, má přednost před sdíleným blokem až do clearParameterOverrides()
+     */
+    void setMasterGain(float gain) noexcept;
+
+    /**
+     * @brief Zruší per-voice override - hlas se vrátí k hodnotám sdíleného bloku
+     * @note RT-safe
      */
-    void setMasterGain(float gain) noexcept;;
+    void clearParameterOverrides() noexcept { overrideMask_ = 0; }
 
 
     // ===== GETTERS =====
@@ -312,10 +441,11 @@ public:
     int getPosition() const noexcept { return position_; }
     uint8_t getCurrentVelocityLayer() const noexcept { return currentVelocityLayer_; }
     
-    // Gain getters
+    // Gain getters (master gain a pan jsou aktuální vyhlazené hodnoty)
     float getCurrentEnvelopeGain() const noexcept { return envelope_gain_; }
     float getVelocityGain() const noexcept { return velocity_gain_; }
     float getMasterGain() const noexcept { return master_gain_; }
+    float getPan() const noexcept { return pan_; }
     
     // Stereo field getters
     uint8_t getStereoFieldAmountMIDI() const noexcept { return stereoFieldAmount_; }
@@ -327,6 +457,10 @@ public:
     int getDampingPosition() const noexcept { return dampingPosition_; }
     int getDampingLength() const noexcept { return dampingLength_; }
 
+    // Audibility getters (for diagnostics)
+    float getOutputLevelEstimate() const noexcept { return outputLevelEstimate_; }
+    bool isRetiring() const noexcept { return retiring_; }
+
     // ===== RT MODE CONTROL =====
 
     /**
@@ -374,6 +508,24 @@ private:
     float               envelope_gain_;             // Current envelope gain (0.0-1.0)
     float               pan_;                       // Pan position (-1.0 to +1.0)
     
+    // --- Shared parameter block and per-voice overrides ---
+    const VoiceParams*  params_;                    // Sdílený blok parametrů (non-owning, nullptr = jen override)
+    uint8_t             overrideMask_;              // OVERRIDE_* bity - lokální hodnota má přednost před blokem
+    float               masterGainOverride_;        // Per-voice master gain (OVERRIDE_MASTER_GAIN)
+    float               panOverride_;               // Per-voice pan (OVERRIDE_PAN)
+    uint8_t             stereoFieldOverride_;       // Per-voice stereo field (OVERRIDE_STEREO_FIELD)
+    float               paramStepPerSample_;        // Max. změna parametru na vzorek (vyhlazení)
+    float               channelGainLeft_;           // Složený gain L na konci posledního sub-bloku
+    float               channelGainRight_;          // Složený gain R na konci posledního sub-bloku
+    float               channelGainStartLeft_;      // Gain L před prvním vzorkem aktuálního sub-bloku
+    float               channelGainStartRight_;     // Gain R před prvním vzorkem aktuálního sub-bloku
+    float               channelGainStepLeft_;       // Krok gainu L na vzorek v aktuálním sub-bloku
+    float               channelGainStepRight_;      // Krok gainu R na vzorek v aktuálním sub-bloku
+    
+    static constexpr uint8_t OVERRIDE_MASTER_GAIN = 1u << 0;
+    static constexpr uint8_t OVERRIDE_PAN = 1u << 1;
+    static constexpr uint8_t OVERRIDE_STEREO_FIELD = 1u << 2;
+    
     // --- Stereo field simulation ---
     float               stereoFieldGainLeft_;       // Left channel stereo field modifier (0.8-1.2)
     float               stereoFieldGainRight_;      // Right channel stereo field modifier (0.8-1.2)
@@ -385,7 +537,7 @@ private:
     float               release_start_gain_;        // Gain value when release started
     
     // --- Pre-allocated RT buffers ---
-    mutable std::vector<float> gainBuffer_;         // Envelope gain buffer (64KB reserve)
+    mutable std::array<float, ITHACA_INTERNAL_BLOCK_SIZE> gainBuffer_; // Envelope gain buffer (jeden sub-blok)
     
     // --- Damping release buffers (retrigger click elimination) ---
     std::vector<float>  dampingBufferLeft_;         // Pre-computed damping samples (left channel)
@@ -393,6 +545,13 @@ private:
     int                 dampingLength_;             // Total damping buffer length in samples
     int                 dampingPosition_;           // Current playback position in damping buffer
     bool                dampingActive_;             // Flag indicating damping playback is active
+
+    // --- Audibility-based early termination ---
+    float               outputLevelEstimate_;       // Odhad špičkové výstupní úrovně zbytku hlasu (lineárně)
+    float               audibilityThreshold_;       // Práh slyšitelnosti (lineárně, z ITHACA_VOICE_AUDIBILITY_THRESHOLD_DB)
+    int                 retireFadeLength_;          // Délka micro-fade při ukončení ve vzorcích
+    int                 retireFadePosition_;        // Aktuální pozice v micro-fade
+    bool                retiring_;                  // Hlas je pod prahem a dobíhá micro-fade
     
     // --- Shared RT mode flag ---
     static std::atomic<bool> rtMode_;
@@ -423,9 +582,21 @@ private:
     /**
      * @brief Reset all voice state variables to defaults
      *
-     * Includes resetting damping state to inactive.
+     * Includes resetting damping state to inactive and per-voice overrides.
      */
     void resetVoiceState() noexcept;
+
+    /**
+     * @brief Převezme master gain, pan a stereo field ze sdíleného bloku / override
+     * @param frames Délka následujícího sub-bloku pro vyhlazení (0 = skok na cíl, nová nota)
+     *
+     * Parametry se posunou k cíli nejvýše o paramStepPerSample_ na vzorek a nové
+     * kanálové gainy se rozprostřou po vzorcích sub-bloku jako lineární rampa
+     * (channelGainStart*_ + channelGainStep*_ · (i + 1)) - bez schodů na hranici sub-bloku.
+     *
+     * @note RT-safe, voláno na začátku každého sub-bloku a při startNote()
+     */
+    void syncParameters(int frames) noexcept;
     
     /**
      * @brief Check if voice is ready for processing
@@ -462,7 +633,8 @@ private:
     /**
      * @brief Calculate stereo field gain modifiers based on note position
      * 
-     * Called when stereo field amount changes via setStereoFieldAmountMIDI().
+     * Called when the effective stereo field amount changes (syncParameters(),
+     * setStereoFieldAmountMIDI()) or the voice is retargeted to another note.
      * Calculates and caches stereo field gains based on MIDI note distance from Middle C.
      * Updates stereoFieldGainLeft_ and stereoFieldGainRight_.
      * 
@@ -471,7 +643,7 @@ private:
      * - Middle C (60): no stereo offset (1.0, 1.0)
      * - Notes above Middle C (61-108): progressively boost right, reduce left
      * 
-     * @note Private method, called automatically by setStereoFieldAmountMIDI()
+     * @note Private method, called automatically on amount or note change
      */
     void calculateStereoFieldGains() noexcept;
     
@@ -529,12 +701,46 @@ private:
      * @brief Zpracuje audio s vypočtenými gainy
      * @param outputLeft Výstupní buffer levého kanálu
      * @param outputRight Výstupní buffer pravého kanálu
-     * @param stereoBuffer Zdrojová stereo data vzorků
+     * @param stereoBuffer Zdrojová stereo data od začátku bloku
      * @param samplesToProcess Počet vzorků ke zpracování
      * @note Používá pouze statický panning (pan_) bez LFO modulace
      */
     void processAudioWithGains(float* outputLeft, float* outputRight,
                               const float* stereoBuffer, int samplesToProcess) noexcept;
+
+    /**
+     * @brief Krokuje obálku pro blok a posune pozici ve vzorku
+     * @param samplesPerBlock Požadovaný počet vzorků
+     * @param stereoBuffer Výstup: zdrojová data od začátku bloku (nullptr = nic k mixu)
+     * @param samplesToProcess Výstup: počet vzorků k mixu
+     * @return true pokud hlas zůstává aktivní
+     * @note Společné jádro processBlock() a prepareRenderBlock()
+     */
+    bool advanceEnvelopeBlock(int samplesPerBlock, const float*& stereoBuffer,
+                              int& samplesToProcess) noexcept;
+
+    /**
+     * @brief Odhad výstupní úrovně a předčasné ukončení neslyšitelného hlasu
+     *
+     * Úroveň = špička zbytku samplu (Instrument::get_tail_peak) * obálka * velocity.
+     * Master gain, pan ani stereo field se nezapočítávají - jde o úroveň noty
+     * samotné, dočasné ztlumení master gainem hlas neukončí.
+     * Mimo attack fázi při poklesu pod audibilityThreshold_ spustí lineární
+     * micro-fade (retireFadeLength_) aplikovaný přímo do gainBuffer_.
+     *
+     * @param gainBuffer Gainy obálky aktuálního bloku (fade se aplikuje in-place)
+     * @param frames Vstup: délka bloku, výstup: zkráceno na konec fade
+     * @return false pokud fade v tomto bloku skončil (hlas po mixu končí)
+     * @note RT-safe: jeden lookup do profilu na blok
+     */
+    bool processAudibility(float* gainBuffer, int& frames) noexcept;
+
+    /**
+     * @brief Složené kanálové gainy (velocity * pan * master * stereo field)
+     * @param leftGain Výstupní gain levého kanálu
+     * @param rightGain Výstupní gain pravého kanálu
+     */
+    void calculateChannelGains(float& leftGain, float& rightGain) noexcept;
     
     /**
      * @brief Vypočítá gainy pro konstantní panning
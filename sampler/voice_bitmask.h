@@ -0,0 +1,128 @@
+#ifndef VOICE_BITMASK_H
+#define VOICE_BITMASK_H
+
+#include "IthacaConfig.h"
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @file voice_bitmask.h
+ * @brief Bitová množina hlasů velikosti voice poolu (ITHACA_MAX_VOICES bitů)
+ *
+ * Nahrazuje vektor ukazatelů s lineárním hledáním:
+ * - set/reset/test: O(1)
+ * - count(): popcount přes několik 64bit slov
+ * - forEach(): iterace přes nastavené bity pomocí ctz, vzestupně podle indexu
+ *   (= podle MIDI noty, tj. sekvenčně v paměti voice poolu)
+ *
+ * @note Není atomická - vlastníkem je audio thread
+ */
+class VoiceBitmask {
+public:
+    static constexpr int BITS = ITHACA_MAX_VOICES;
+    static constexpr int WORDS = (BITS + 63) / 64;
+
+    VoiceBitmask() noexcept { clear(); }
+
+    void set(int index) noexcept {
+        words_[index >> 6] |= (uint64_t(1) << (index & 63));
+    }
+
+    void reset(int index) noexcept {
+        words_[index >> 6] &= ~(uint64_t(1) << (index & 63));
+    }
+
+    bool test(int index) const noexcept {
+        return (words_[index >> 6] >> (index & 63)) & 1u;
+    }
+
+    void clear() noexcept {
+        for (int w = 0; w < WORDS; ++w) words_[w] = 0;
+    }
+
+    bool any() const noexcept {
+        for (int w = 0; w < WORDS; ++w) {
+            if (words_[w]) return true;
+        }
+        return false;
+    }
+
+    int count() const noexcept {
+        int total = 0;
+        for (int w = 0; w < WORDS; ++w) total += popcount64(words_[w]);
+        return total;
+    }
+
+    /**
+     * @brief Nejnižší nastavený bit, -1 pokud je množina prázdná
+     */
+    int findFirst() const noexcept {
+        for (int w = 0; w < WORDS; ++w) {
+            if (words_[w]) return (w << 6) + ctz64(words_[w]);
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Nejnižší nenastavený bit, -1 pokud je množina plná
+     */
+    int findFirstClear() const noexcept {
+        for (int w = 0; w < WORDS; ++w) {
+            if (~words_[w]) {
+                const int index = (w << 6) + ctz64(~words_[w]);
+                return (index < BITS) ? index : -1;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Zavolá fn(index) pro každý nastavený bit
+     * @note Každé slovo je před iterací zkopírováno - fn smí měnit
+     *       tuto množinu (typicky reset právě zpracovaného indexu)
+     */
+    template <typename Fn>
+    void forEach(Fn&& fn) const noexcept {
+        for (int w = 0; w < WORDS; ++w) {
+            uint64_t bits = words_[w];
+            while (bits) {
+                fn((w << 6) + ctz64(bits));
+                bits &= bits - 1;  // Smazat nejnižší nastavený bit
+            }
+        }
+    }
+
+private:
+    uint64_t words_[WORDS];
+
+    static int popcount64(uint64_t x) noexcept {
+#if defined(_MSC_VER) && defined(_M_X64)
+        return static_cast<int>(__popcnt64(x));
+#elif defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(x);
+#else
+        int n = 0;
+        while (x) { x &= x - 1; ++n; }
+        return n;
+#endif
+    }
+
+    static int ctz64(uint64_t x) noexcept {
+#if defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, x);
+        return static_cast<int>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(x);
+#else
+        int n = 0;
+        while (!(x & 1u)) { x >>= 1; ++n; }
+        return n;
+#endif
+    }
+};
+
+#endif // VOICE_BITMASK_H
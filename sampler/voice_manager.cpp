@@ -4,37 +4,50 @@
 #include "envelopes/envelope_static_data.h"
 #include "pan.h"
 #include "lfopan.h"
+#include "common/denormal_guard.h"
+#include "common/simd_dispatch.h"
 #include <algorithm>
 #include <cstdlib>
+#include <filesystem>
 #include <iostream>
+#include <system_error>
+
+// processBlockInterleaved() zapisuje AudioData jako souvislé pole floatů [L0,R0,L1,R1,...]
+static_assert(sizeof(AudioData) == 2 * sizeof(float), "AudioData must be two packed floats");
 
 // ===== CONSTRUCTOR AND INITIALIZATION =====
 
 VoiceManager::VoiceManager(const std::string& sampleDir, Logger& logger, int velocityLayerCount)
-    : samplerIO_(),
-      instrumentLoader_(),
+    : sampleBank_(),
       envelope_(),
       currentSampleRate_(0),
       sampleDir_(sampleDir),
       systemInitialized_(false),
       velocityLayerCount_(velocityLayerCount),  // Nově
       voices_(128),
-      activeVoices_(),
-      voicesToRemove_(),
+      activeVoiceMask_(),
+      sustainingVoiceMask_(),
+      releasingVoiceMask_(),
       activeVoicesCount_(0),
       rtMode_(false),
       sustainPedalActive_(false),
       delayedNoteOffs_(),  // Initialized to all false
+      partCount_(1),       // Klasický režim (hlas = MIDI nota)
+      parts_(),
+      voicePart_(),
+      voiceNoteOnOrder_(),
+      noteOnCounter_(0),
       panSpeed_(0.0f),
       panSpeedTarget_(0.0f),
       panDepth_(0.0f),
       panDepthTarget_(0.0f),
       panSmoothingTime_(0.5f),  // 500 ms default smoothing for both speed and depth
-      lfoPhase_(0.0f),
-      lfoPanBuffer_(),
+      lfoPhase_(0),
+      scratchLeft_(SUB_BLOCK_SIZE, 0.0f),
+      scratchRight_(SUB_BLOCK_SIZE, 0.0f),
       dspChain_(),
       limiterEffect_(nullptr),
-      previousPanLeft_(1.0f),  // Inicializace předchozích gainů
+      previousPanLeft_(1.0f),  // Střed nastaví resetLfoParameters() po inicializaci tabulek
       previousPanRight_(1.0f) {
 
     // Validate velocity layer count
@@ -64,19 +77,23 @@ VoiceManager::VoiceManager(const std::string& sampleDir, Logger& logger, int vel
     
     // Initialize LFO panning lookup tables
     LfoPanning::initializeLfoTables();
+    resetLfoParameters();
     
     // Initialize voice pool (128 voices for all MIDI notes)
     for (int i = 0; i < 128; ++i) {
         voices_[i] = Voice(static_cast<uint8_t>(i));
+        voices_[i].bindParameters(voiceParams_);
     }
     
-    // Pre-allocate management vectors
-    activeVoices_.reserve(128);
-    voicesToRemove_.reserve(128);
-
     // Initialize delayed note-off flags to false
     delayedNoteOffs_.fill(false);
 
+    // Multi-timbral party ve výchozím stavu, hlasy zatím nepatří žádnému partu
+    voicePart_.fill(NO_PART);
+    for (PartState& part : parts_) {
+        resetPartState(part);
+    }
+
     // Setup error callback for envelope static data
     EnvelopeStaticData::setErrorCallback([&logger](const std::string& component,
                                                    LogSeverity severity,
@@ -84,16 +101,14 @@ VoiceManager::VoiceManager(const std::string& sampleDir, Logger& logger, int vel
         logger.log(component, severity, message);
     });
 
-    // Create and add DSP effects in processing order
+    // DSP effects in processing order (master chain, fixed at compile time)
     // 1. BBE Maximizer (enhancement - must come before limiter)
-    auto bbe = std::make_unique<BBEProcessor>();
-    bbeEffect_ = bbe.get();  // Uložit quick pointer
-    dspChain_.addEffect(std::move(bbe));
-
     // 2. Limiter (protection - must be last!)
-    auto limiter = std::make_unique<Limiter>();
-    limiterEffect_ = limiter.get();  // Uložit quick pointer
-    dspChain_.addEffect(std::move(limiter));
+    bbeEffect_ = &masterChain_.get<BBEProcessor>();  // Uložit quick pointer
+    limiterEffect_ = &masterChain_.get<Limiter>();   // Uložit quick pointer
+
+    logger.log("VoiceManager/constructor", LogSeverity::Info,
+               std::string("SIMD kernels: ") + SimdDispatch::kernels().name);
 
     logger.log("VoiceManager/constructor", LogSeverity::Info,
            "VoiceManager created with sampleDir '" + sampleDir_ + "', " +
@@ -108,27 +123,33 @@ VoiceManager::VoiceManager(const std::string& sampleDir, Logger& logger, int vel
  * @param sampleRate Initial sample rate (44100 or 48000)
  */
 VoiceManager::VoiceManager(Logger& logger, int velocityLayerCount, int sampleRate)
-    : samplerIO_(),
-      instrumentLoader_(),
+    : sampleBank_(),
       envelope_(),
       currentSampleRate_(0),
       sampleDir_(""),  // Empty - no sample directory initially
       systemInitialized_(false),
       velocityLayerCount_(velocityLayerCount),
       voices_(128),
-      activeVoices_(),
-      voicesToRemove_(),
+      activeVoiceMask_(),
+      sustainingVoiceMask_(),
+      releasingVoiceMask_(),
       activeVoicesCount_(0),
       rtMode_(false),
       sustainPedalActive_(false),
       delayedNoteOffs_(),
+      partCount_(1),
+      parts_(),
+      voicePart_(),
+      voiceNoteOnOrder_(),
+      noteOnCounter_(0),
       panSpeed_(0.0f),
       panSpeedTarget_(0.0f),
       panDepth_(0.0f),
       panDepthTarget_(0.0f),
       panSmoothingTime_(0.5f),
-      lfoPhase_(0.0f),
-      lfoPanBuffer_(),
+      lfoPhase_(0),
+      scratchLeft_(SUB_BLOCK_SIZE, 0.0f),
+      scratchRight_(SUB_BLOCK_SIZE, 0.0f),
       dspChain_(),
       limiterEffect_(nullptr),
       previousPanLeft_(1.0f),
@@ -157,19 +178,23 @@ VoiceManager::VoiceManager(Logger& logger, int velocityLayerCount, int sampleRat
 
     // Initialize LFO panning lookup tables
     LfoPanning::initializeLfoTables();
+    resetLfoParameters();
 
     // Initialize voice pool (128 voices for all MIDI notes)
     for (int i = 0; i < 128; ++i) {
         voices_[i] = Voice(static_cast<uint8_t>(i));
+        voices_[i].bindParameters(voiceParams_);
     }
 
-    // Pre-allocate management vectors
-    activeVoices_.reserve(128);
-    voicesToRemove_.reserve(128);
-
     // Initialize delayed note-off flags to false
     delayedNoteOffs_.fill(false);
 
+    // Multi-timbral party ve výchozím stavu, hlasy zatím nepatří žádnému partu
+    voicePart_.fill(NO_PART);
+    for (PartState& part : parts_) {
+        resetPartState(part);
+    }
+
     // Setup error callback for envelope static data
     EnvelopeStaticData::setErrorCallback([&logger](const std::string& component,
                                                    LogSeverity severity,
@@ -177,29 +202,23 @@ VoiceManager::VoiceManager(Logger& logger, int velocityLayerCount, int sampleRat
         logger.log(component, severity, message);
     });
 
-    // Create and add DSP effects
-    auto bbe = std::make_unique<BBEProcessor>();
-    bbeEffect_ = bbe.get();
-    dspChain_.addEffect(std::move(bbe));
-
-    auto limiter = std::make_unique<Limiter>();
-    limiterEffect_ = limiter.get();
-    dspChain_.addEffect(std::move(limiter));
+    // DSP effects (master chain BBE → Limiter)
+    bbeEffect_ = &masterChain_.get<BBEProcessor>();
+    limiterEffect_ = &masterChain_.get<Limiter>();
 
     logger.log("VoiceManager/constructor_sine", LogSeverity::Info,
               "VoiceManager base initialization completed, loading sine waves...");
 
-    // Load sine wave data instead of samples
-    instrumentLoader_.setVelocityLayerCount(velocityLayerCount_);
-    instrumentLoader_.loadSineWaveData(sampleRate, logger);
+    // Load sine wave data instead of samples (shared by all sine-mode instances)
+    sampleBank_ = SampleBankRegistry::acquire(std::string(), sampleRate, velocityLayerCount_, logger);
 
     // Set sample rate
     currentSampleRate_ = sampleRate;
 
     // Initialize all voices with sine wave instrument references
     for (int midiNote = 0; midiNote < 128; ++midiNote) {
-        const Instrument& inst = instrumentLoader_.getInstrumentNote(static_cast<uint8_t>(midiNote));
-        voices_[midiNote].initialize(inst, currentSampleRate_, envelope_, logger, &instrumentLoader_);
+        const Instrument& inst = sampleBank_->getInstrumentNote(static_cast<uint8_t>(midiNote));
+        voices_[midiNote].initialize(inst, currentSampleRate_, envelope_, logger, &sampleBank_->getInstrumentLoader());
         voices_[midiNote].prepareToPlay(512);  // Use default block size
     }
 
@@ -224,26 +243,22 @@ void VoiceManager::getPanGains(float pan, float& leftGain, float& rightGain) noe
 
 void VoiceManager::initializeSystem(Logger& logger) {
     logger.log("VoiceManager/initializeSystem", LogSeverity::Info,
-            "=== INIT PHASE 1: System initialization and directory scanning ===");
+            "=== INIT PHASE 1: System initialization and directory validation ===");
 
     try {
-        samplerIO_.scanSampleDirectory(sampleDir_, logger);
-
-        // Check if samples were loaded by checking if we can find at least one valid sample
-        const auto& sampleList = samplerIO_.getLoadedSampleList();
-        if (sampleList.empty()) {
-            const std::string errorMsg = "[VoiceManager/initializeSystem] error: No valid samples found in directory '" + sampleDir_ + "'";
+        // Skenování proběhne při načtení banky (SampleBankRegistry) - sdílená
+        // banka se stejným klíčem se pak neskenuje ani nenačítá znovu
+        std::error_code ec;
+        if (!std::filesystem::is_directory(sampleDir_, ec)) {
+            const std::string errorMsg = "[VoiceManager/initializeSystem] error: Sample directory '" + sampleDir_ + "' does not exist";
             logger.log("VoiceManager/initializeSystem", LogSeverity::Error, errorMsg);
             std::exit(1);
         }
 
-        // Set velocity layer count in InstrumentLoader
-        instrumentLoader_.setVelocityLayerCount(velocityLayerCount_);
-
         systemInitialized_ = true;
 
         logger.log("VoiceManager/initializeSystem", LogSeverity::Info,
-                "=== INIT PHASE 1 COMPLETED: Sample directory scanned successfully ===");
+                "=== INIT PHASE 1 COMPLETED: Sample directory validated ===");
         
     } catch (...) {
         const std::string errorMsg = "[VoiceManager/initializeSystem] error: INIT PHASE 1: System initialization failed";
@@ -263,15 +278,11 @@ void VoiceManager::loadForSampleRate(int sampleRate, Logger& logger) {
             "=== INIT PHASE 2: Loading sample data for " + std::to_string(sampleRate) + " Hz ===");
     
     try {
-        instrumentLoader_.loadInstrumentData(samplerIO_, sampleRate, logger);
-        
-        // Check if any samples were actually loaded
-        if (instrumentLoader_.getTotalLoadedSamples() == 0) {
-            const std::string errorMsg = "[VoiceManager/loadForSampleRate] error: Failed to load any instrument data";
-            logger.log("VoiceManager/loadForSampleRate", LogSeverity::Error, errorMsg);
-            std::exit(1);
-        }
-        
+        // Předchozí banka zůstane držena, dokud hlasy neukazují do nové
+        // (při stejném klíči registr vrátí tutéž banku bez načítání)
+        std::shared_ptr<const SampleBank> previousBank = std::move(sampleBank_);
+        sampleBank_ = SampleBankRegistry::acquire(sampleDir_, sampleRate, velocityLayerCount_, logger);
+
         currentSampleRate_ = sampleRate;
         initializeVoicesWithInstruments(logger);
         
@@ -323,7 +334,7 @@ void VoiceManager::loadSampleBank(const std::string& sampleDir, int sampleRate,
         logger.log("VoiceManager/loadSampleBank", LogSeverity::Info,
                   "=== SAMPLE BANK LOADED SUCCESSFULLY ===");
         logger.log("VoiceManager/loadSampleBank", LogSeverity::Info,
-                  "Total samples loaded: " + std::to_string(instrumentLoader_.getTotalLoadedSamples()));
+                  "Total samples loaded: " + std::to_string(sampleBank_->getInstrumentLoader().getTotalLoadedSamples()));
 
     } catch (const std::exception& e) {
         logger.log("VoiceManager/loadSampleBank", LogSeverity::Error,
@@ -360,19 +371,26 @@ void VoiceManager::changeSampleRate(int newSampleRate, Logger& logger) {
 }
 
 void VoiceManager::prepareToPlay(int maxBlockSize) noexcept {
+    // Hlasy, mix lanes i scratch mají pevnou velikost sub-bloku - libovolná
+    // velikost bloku hostitele bez alokací (viz renderSegment())
     for (int i = 0; i < 128; ++i) {
         voices_[i].prepareToPlay(maxBlockSize);
     }
 
-    // Prepare DSP chain
+    // Prepare DSP chains (dynamic effects + master BBE → Limiter)
     if (currentSampleRate_ > 0) {
         dspChain_.prepare(currentSampleRate_, maxBlockSize);
+        masterChain_.prepare(currentSampleRate_, maxBlockSize);
     }
 }
 
 // ===== CORE AUDIO API =====
 
 void VoiceManager::setNoteStateMIDI(uint8_t midiNote, bool isOn, uint8_t velocity) noexcept {
+    if (partCount_ > 1) {
+        setPartNoteStateMIDI(0, midiNote, isOn, velocity);
+        return;
+    }
     if (!isValidMidiNote(midiNote)) return;
     
     Voice& voice = voices_[midiNote];
@@ -382,10 +400,8 @@ void VoiceManager::setNoteStateMIDI(uint8_t midiNote, bool isOn, uint8_t velocit
         // Don't touch delayed flag - if it's set, the voice will handle
         // the retrigger via damping buffer, and pedal release will still work correctly
         
-        // Add to active voices if not already active
-        if (!voice.isActive()) {
-            addActiveVoice(&voice);
-        }
+        // Add to active voices (no-op if already active)
+        addActiveVoice(midiNote);
         
         // Start the note (voice handles retrigger internally if already playing)
         voice.setNoteState(true, velocity);
@@ -403,9 +419,15 @@ void VoiceManager::setNoteStateMIDI(uint8_t midiNote, bool isOn, uint8_t velocit
             voice.setNoteState(false, velocity);
         }
     }
+
+    updateVoiceStateMask(midiNote);
 }
 
 void VoiceManager::setNoteStateMIDI(uint8_t midiNote, bool isOn) noexcept {
+    if (partCount_ > 1) {
+        setPartNoteStateMIDI(0, midiNote, isOn, ITHACA_DEFAULT_VELOCITY);
+        return;
+    }
     if (!isValidMidiNote(midiNote)) return;
     
     Voice& voice = voices_[midiNote];
@@ -415,10 +437,8 @@ void VoiceManager::setNoteStateMIDI(uint8_t midiNote, bool isOn) noexcept {
         // Don't touch delayed flag - if it's set, the voice will handle
         // the retrigger via damping buffer, and pedal release will still work correctly
         
-        // Add to active voices if not already active
-        if (!voice.isActive()) {
-            addActiveVoice(&voice);
-        }
+        // Add to active voices (no-op if already active)
+        addActiveVoice(midiNote);
         
         // Start the note with default velocity (voice handles retrigger internally)
         voice.setNoteState(true);
@@ -436,11 +456,18 @@ void VoiceManager::setNoteStateMIDI(uint8_t midiNote, bool isOn) noexcept {
             voice.setNoteState(false);
         }
     }
+
+    updateVoiceStateMask(midiNote);
 }
 
 // ===== SUSTAIN PEDAL API =====
 
 void VoiceManager::setSustainPedalMIDI(bool pedalDown) noexcept {
+    if (partCount_ > 1) {
+        setPartSustainPedalMIDI(0, pedalDown);
+        return;
+    }
+
     // Get previous state before updating
     bool wasActive = sustainPedalActive_.load();
     
@@ -464,6 +491,7 @@ void VoiceManager::processDelayedNoteOffs() noexcept {
             // Send note-off to this voice
             Voice& voice = voices_[midiNote];
             voice.setNoteState(false, 0);
+            updateVoiceStateMask(midiNote);
             
             // Clear the delayed note-off flag
             delayedNoteOffs_[midiNote] = false;
@@ -471,164 +499,517 @@ void VoiceManager::processDelayedNoteOffs() noexcept {
     }
 }
 
+// ===== MULTI-TIMBRAL PARTS =====
+
+void VoiceManager::setPartCount(int partCount, Logger& logger) {
+    const int requested = partCount;
+    partCount = std::max(1, std::min(partCount, ITHACA_MAX_PARTS));
+    if (partCount != requested) {
+        logger.log("VoiceManager/setPartCount", LogSeverity::Warning,
+                   "Requested " + std::to_string(requested) + " parts, clamped to " +
+                   std::to_string(partCount) + " (ITHACA_MAX_PARTS = " + std::to_string(ITHACA_MAX_PARTS) + ")");
+    }
+
+    // Hlasy mění vlastníka - nic nesmí dohrávat se starou vazbou
+    for (int i = 0; i < 128; ++i) {
+        voices_[i].cleanup(logger);
+    }
+    activeVoiceMask_.clear();
+    sustainingVoiceMask_.clear();
+    releasingVoiceMask_.clear();
+    activeVoicesCount_.store(0);
+
+    sustainPedalActive_.store(false);
+    delayedNoteOffs_.fill(false);
+
+    partCount_ = partCount;
+    voicePart_.fill(NO_PART);
+    voiceNoteOnOrder_.fill(0);
+    noteOnCounter_ = 0;
+    for (PartState& part : parts_) {
+        resetPartState(part);
+    }
+
+    // Klasická vazba hlas = nota (multi-timbral režim si hlasy přiváže při note-on)
+    if (sampleBank_) {
+        for (int i = 0; i < 128; ++i) {
+            const uint8_t midiNote = static_cast<uint8_t>(i);
+            voices_[i].retarget(midiNote, sampleBank_->getInstrumentNote(midiNote), envelope_, voiceParams_);
+        }
+    }
+
+    if (partCount_ > 1) {
+        logger.log("VoiceManager/setPartCount", LogSeverity::Info,
+                   "Multi-timbral mode: " + std::to_string(partCount_) +
+                   " parts sharing one 128-voice pool, LFO and DSP chain");
+    } else {
+        logger.log("VoiceManager/setPartCount", LogSeverity::Info,
+                   "Classic single-timbral mode (one voice per MIDI note, channel ignored)");
+    }
+}
+
+void VoiceManager::setPartNoteStateMIDI(uint8_t part, uint8_t midiNote, bool isOn, uint8_t velocity) noexcept {
+    if (partCount_ <= 1) {
+        setNoteStateMIDI(midiNote, isOn, velocity);
+        return;
+    }
+    if (part >= partCount_ || !isValidMidiNote(midiNote)) return;
+
+    PartState& state = parts_[part];
+    int index = findPartVoice(part, midiNote);
+
+    if (isOn) {
+        // Nota partu už hlas má → retrigger přes damping buffer jako v klasickém režimu
+        if (index < 0) index = allocatePartVoice(part, midiNote);
+        if (index < 0) return;
+
+        voiceNoteOnOrder_[index] = ++noteOnCounter_;
+        addActiveVoice(index);
+        voices_[index].setNoteState(true, velocity);
+
+    } else {
+        // Hlas mohl být mezitím ukraden jiným partem - pak už note-off nepatří nikomu
+        if (index < 0 || !voices_[index].isActive()) return;
+
+        if (state.sustainPedalActive) {
+            state.delayedNoteOffs[midiNote] = true;
+        } else {
+            voices_[index].setNoteState(false, velocity);
+        }
+    }
+
+    updateVoiceStateMask(index);
+}
+
+void VoiceManager::setPartSustainPedalMIDI(uint8_t part, bool pedalDown) noexcept {
+    if (partCount_ <= 1) {
+        setSustainPedalMIDI(pedalDown);
+        return;
+    }
+    if (part >= partCount_) return;
+
+    PartState& state = parts_[part];
+    const bool wasActive = state.sustainPedalActive;
+    state.sustainPedalActive = pedalDown;
+
+    if (wasActive && !pedalDown) {
+        processPartDelayedNoteOffs(part);
+    }
+}
+
+void VoiceManager::setPartMasterGainMIDI(uint8_t part, uint8_t midi_gain) noexcept {
+    if (midi_gain > 127) return;
+    if (partCount_ <= 1) {
+        applyMasterGainMIDI(midi_gain);
+        return;
+    }
+    if (part >= partCount_) return;
+
+    parts_[part].params.setMasterGain(midi_gain / 127.0f);
+}
+
+void VoiceManager::setPartPanMIDI(uint8_t part, uint8_t midi_pan) noexcept {
+    if (midi_pan > 127) return;
+    if (partCount_ <= 1) {
+        setAllVoicesPanMIDI(midi_pan);
+        return;
+    }
+    if (part >= partCount_) return;
+
+    // Static pan is overridden by LFO panning if active
+    if (isLfoPanningActive()) return;
+
+    parts_[part].params.setPan((midi_pan - 64.0f) / 63.0f);
+}
+
+void VoiceManager::setPartAttackMIDI(uint8_t part, uint8_t midi_attack) noexcept {
+    if (midi_attack > 127) return;
+    if (partCount_ <= 1) {
+        setAllVoicesAttackMIDI(midi_attack);
+        return;
+    }
+    if (part >= partCount_) return;
+
+    parts_[part].params.setAttackMIDI(midi_attack);
+}
+
+void VoiceManager::setPartReleaseMIDI(uint8_t part, uint8_t midi_release) noexcept {
+    if (midi_release > 127) return;
+    if (partCount_ <= 1) {
+        setAllVoicesReleaseMIDI(midi_release);
+        return;
+    }
+    if (part >= partCount_) return;
+
+    parts_[part].params.setReleaseMIDI(midi_release);
+}
+
+void VoiceManager::setPartSustainLevelMIDI(uint8_t part, uint8_t midi_sustain) noexcept {
+    if (midi_sustain > 127) return;
+    if (partCount_ <= 1) {
+        setAllVoicesSustainLevelMIDI(midi_sustain);
+        return;
+    }
+    if (part >= partCount_) return;
+
+    parts_[part].params.setSustainLevelMIDI(midi_sustain);
+}
+
+void VoiceManager::setPartStereoFieldAmountMIDI(uint8_t part, uint8_t midi_stereo) noexcept {
+    if (midi_stereo > 127) return;
+    if (partCount_ <= 1) {
+        setAllVoicesStereoFieldAmountMIDI(midi_stereo);
+        return;
+    }
+    if (part >= partCount_) return;
+
+    parts_[part].params.setStereoFieldAmountMIDI(midi_stereo);
+}
+
+void VoiceManager::setPartPolyphony(uint8_t part, int maxVoices) noexcept {
+    if (part >= ITHACA_MAX_PARTS) return;
+
+    parts_[part].maxVoices = std::max(0, std::min(maxVoices, static_cast<int>(voices_.size())));
+}
+
+int VoiceManager::getPartPolyphony(uint8_t part) const noexcept {
+    return part < ITHACA_MAX_PARTS ? parts_[part].maxVoices : 0;
+}
+
+int VoiceManager::getPartActiveVoicesCount(uint8_t part) const noexcept {
+    if (partCount_ <= 1) return getActiveVoicesCount();
+    if (part >= partCount_) return 0;
+
+    int count = 0;
+    activeVoiceMask_.forEach([&](int index) {
+        if (voicePart_[index] == part) ++count;
+    });
+    return count;
+}
+
 // ===== AUDIO PROCESSING =====
 
 bool VoiceManager::processBlockSegment(float* outputLeft, float* outputRight, int samplesPerBlock) noexcept {
     if (!outputLeft || !outputRight || samplesPerBlock <= 0) return false;
 
-    if (activeVoices_.empty()) return false;
+    ScopedDenormalProtection denormalGuard;
 
+    // Gain buffery hlasů a mix lanes pojmou jeden sub-blok - delší segmenty po částech
     bool anyActive = false;
 
-    for (Voice* voice : activeVoices_) {
-        if (voice && voice->isActive()) {
-            if (voice->processBlock(outputLeft, outputRight, samplesPerBlock)) {
-                anyActive = true;
-            } else {
-                voicesToRemove_.push_back(voice);
-            }
-        } else {
-            voicesToRemove_.push_back(voice);
+    for (int offset = 0; offset < samplesPerBlock; offset += SUB_BLOCK_SIZE) {
+        const int chunk = std::min(SUB_BLOCK_SIZE, samplesPerBlock - offset);
+        if (renderVoices(outputLeft + offset, outputRight + offset, chunk)) {
+            anyActive = true;
+        }
+    }
+
+    return anyActive;
+}
+
+bool VoiceManager::renderVoices(float* outputLeft, float* outputRight, int samplesPerBlock) noexcept {
+    if (!activeVoiceMask_.any()) return false;
+
+    // Parametry obálek jednou za sub-blok (zapisují je jiné thready přes VoiceParams)
+    if (partCount_ > 1) {
+        for (int part = 0; part < partCount_; ++part) {
+            syncEnvelope(parts_[part].envelope, parts_[part].params);
         }
+    } else {
+        syncEnvelope(envelope_, voiceParams_);
     }
 
-    if (!voicesToRemove_.empty()) {
-        cleanupInactiveVoices();
+    const bool profiling = cpuProfilingEnabled_.load(std::memory_order_relaxed);
+    const uint64_t startTicks = profiling ? CpuMeter::now() : 0;
+
+    bool anyActive = false;
+
+    // Fáze 1: krok obálek všech aktivních hlasů → SoA batch (+ damping tails)
+    renderBatch_.clear();
+    activeVoiceMask_.forEach([&](int index) {
+        Voice& voice = voices_[index];
+        voice.mixDampingBlock(outputLeft, outputRight, samplesPerBlock);
+
+        if (voice.isActive() && voice.prepareRenderBlock(samplesPerBlock, renderBatch_)) {
+            anyActive = true;
+            updateVoiceStateMask(index);
+        } else {
+            removeActiveVoice(index);
+        }
+    });
+
+    // Fáze 2: mix souvislých polí bez přístupu k Voice objektům (deterministické lanes)
+    renderPool_.render(renderBatch_, outputLeft, outputRight, samplesPerBlock);
+
+    if (profiling) {
+        voiceRenderMeter_.addSample(CpuMeter::now() - startTicks);
     }
 
     return anyActive;
 }
 
 void VoiceManager::finalizeBlock(float* outputLeft, float* outputRight, int samplesPerBlock) noexcept {
-    // LFO runs continuously even at zero speed/depth (prevents phase discontinuities)
-    applyLfoPanningPerSample(samplesPerBlock);
+    ScopedDenormalProtection denormalGuard;
+
     applyLfoPanToFinalMix(outputLeft, outputRight, samplesPerBlock);
 
     dspChain_.process(outputLeft, outputRight, samplesPerBlock);
+    masterChain_.process(outputLeft, outputRight, samplesPerBlock);
+}
+
+bool VoiceManager::renderSegment(float* outputLeft, float* outputRight, int samplesPerBlock) noexcept {
+    // Pevné sub-bloky nezávislé na bloku hostitele: hlasy → LFO → DSP nad daty v L1.
+    // Hlas, který skončí uprostřed segmentu, pustí zbytek do idle fast path.
+    bool anyActive = false;
+
+    for (int offset = 0; offset < samplesPerBlock; offset += SUB_BLOCK_SIZE) {
+        const int chunk = std::min(SUB_BLOCK_SIZE, samplesPerBlock - offset);
+        if (renderSubBlock(outputLeft + offset, outputRight + offset, chunk)) {
+            anyActive = true;
+        }
+    }
+
+    return anyActive;
+}
+
+bool VoiceManager::renderSubBlock(float* outputLeft, float* outputRight, int samplesPerBlock) noexcept {
+    if (activeVoiceMask_.any()) {
+        const bool anyActive = renderVoices(outputLeft, outputRight, samplesPerBlock);
+        finalizeBlock(outputLeft, outputRight, samplesPerBlock);
+        return anyActive;
+    }
+
+    // Idle fast path: bez hlasů zůstává vynulovaný buffer nulový. LFO jen posune
+    // stav (gain × 0 = 0) a DSP chain běží pouze, dokud některý efekt doznívá.
+    // Další nota se vykreslí hned v segmentu, kde přišla - stav je jako bez přeskočení.
+    advanceLfoPan(samplesPerBlock);
+
+    // Doznívající dynamický efekt posílá signál dál - master pak běží také
+    if (!dspChain_.isTailSilent()) {
+        dspChain_.process(outputLeft, outputRight, samplesPerBlock);
+        masterChain_.process(outputLeft, outputRight, samplesPerBlock);
+    } else if (!masterChain_.isTailSilent()) {
+        masterChain_.process(outputLeft, outputRight, samplesPerBlock);
+    }
+    return false;
 }
 
 bool VoiceManager::processBlockUninterleaved(float* outputLeft, float* outputRight, int samplesPerBlock) noexcept {
     if (!outputLeft || !outputRight || samplesPerBlock <= 0) return false;
 
+    ScopedDenormalProtection denormalGuard;
+
+    drainCommandQueue();
+
     std::fill(outputLeft, outputLeft + samplesPerBlock, 0.0f);
     std::fill(outputRight, outputRight + samplesPerBlock, 0.0f);
 
-    bool anyActive = processBlockSegment(outputLeft, outputRight, samplesPerBlock);
-    finalizeBlock(outputLeft, outputRight, samplesPerBlock);
-
-    return anyActive;
+    return renderSegment(outputLeft, outputRight, samplesPerBlock);
 }
 
 bool VoiceManager::processBlockInterleaved(AudioData* outputBuffer, int samplesPerBlock) noexcept {
     // Ověření vstupů
     if (!outputBuffer || samplesPerBlock <= 0) return false;
 
-    // Vynulování výstupního bufferu
-    for (int i = 0; i < samplesPerBlock; ++i) {
-        outputBuffer[i].left = 0.0f;
-        outputBuffer[i].right = 0.0f;
+    ScopedDenormalProtection denormalGuard;
+
+    drainCommandQueue();
+
+    // Render do planárního scratche velikosti sub-bloku (vlastní VoiceManager, bez alokací),
+    // stejný řetězec jako neprokládaná cesta (hlasy → LFO pan → DSP) a prokládání
+    // každého sub-bloku, dokud je v L1. LFO i DSP jsou přes sub-bloky spojité.
+    float* interleaved = reinterpret_cast<float*>(outputBuffer);
+    bool anyActive = false;
+
+    for (int offset = 0; offset < samplesPerBlock; offset += SUB_BLOCK_SIZE) {
+        const int chunk = std::min(SUB_BLOCK_SIZE, samplesPerBlock - offset);
+
+        std::fill(scratchLeft_.begin(), scratchLeft_.begin() + chunk, 0.0f);
+        std::fill(scratchRight_.begin(), scratchRight_.begin() + chunk, 0.0f);
+
+        if (renderSubBlock(scratchLeft_.data(), scratchRight_.data(), chunk)) {
+            anyActive = true;
+        }
+
+        interleaveStereo(scratchLeft_.data(), scratchRight_.data(),
+                         interleaved + static_cast<size_t>(offset) * 2, chunk);
     }
 
-    if (activeVoices_.empty()) return false;
+    return anyActive;
+}
 
-    // Předalokované dočasné buffery pro RT bezpečnost
-    static thread_local std::vector<float> tempLeft(16384);
-    static thread_local std::vector<float> tempRight(16384);
+void VoiceManager::interleaveStereo(const float* left, const float* right, float* interleaved,
+                                    int numSamples) noexcept {
+    SimdDispatch::kernels().interleaveStereo(left, right, interleaved, numSamples);
+}
 
-    bool anyActive = false;
+bool VoiceManager::processBlock(const MidiEvent* eventsBegin, const MidiEvent* eventsEnd,
+                                float* outputLeft, float* outputRight, int samplesPerBlock) noexcept {
+    if (!outputLeft || !outputRight || samplesPerBlock <= 0) return false;
 
-    // Zpracování všech aktivních hlasů bez LFO panningu
-    for (Voice* voice : activeVoices_) {
-        if (voice && voice->isActive()) {
-            // Ověření kapacity bufferu
-            if (tempLeft.size() < static_cast<size_t>(samplesPerBlock)) {
-                std::cerr << "[VoiceManager/processBlockInterleaved] error: Temp buffer too small - need "
-                          << samplesPerBlock << " samples, have " << tempLeft.size() << std::endl;
-                continue;
-            }
+    ScopedDenormalProtection denormalGuard;
 
-            // Vynulování dočasných bufferů
-            std::fill(tempLeft.begin(), tempLeft.begin() + samplesPerBlock, 0.0f);
-            std::fill(tempRight.begin(), tempRight.begin() + samplesPerBlock, 0.0f);
+    drainCommandQueue();
 
-            // Zpracování hlasu a mix do výstupu
-            if (voice->processBlock(tempLeft.data(), tempRight.data(), samplesPerBlock)) {
-                anyActive = true;
+    std::fill(outputLeft, outputLeft + samplesPerBlock, 0.0f);
+    std::fill(outputRight, outputRight + samplesPerBlock, 0.0f);
 
-                for (int i = 0; i < samplesPerBlock; ++i) {
-                    outputBuffer[i].left += tempLeft[i];
-                    outputBuffer[i].right += tempRight[i];
-                }
-            } else {
-                voicesToRemove_.push_back(voice);
-            }
-        } else {
-            voicesToRemove_.push_back(voice);
+    bool anyActive = false;
+    int position = 0;
+    const MidiEvent* event = eventsBegin;
+
+    while (position < samplesPerBlock) {
+        // Aplikace všech událostí, které patří na aktuální pozici
+        // (offset ořezán do bloku, opožděné události padnou na aktuální pozici)
+        while (event && event != eventsEnd &&
+               std::min(event->sampleOffset, samplesPerBlock - 1) <= position) {
+            handleMidiEvent(*event);
+            ++event;
         }
-    }
 
-    // Vyčištění neaktivních hlasů
-    if (!voicesToRemove_.empty()) {
-        cleanupInactiveVoices();
-    }
+        // Segment končí u další události nebo na konci bloku
+        int segmentEnd = samplesPerBlock;
+        if (event && event != eventsEnd) {
+            segmentEnd = std::min(event->sampleOffset, samplesPerBlock - 1);
+        }
 
-    // Aplikace LFO panningu na finální mix
-    // Always process LFO (runs continuously, even when speed/depth are 0)
-    applyLfoPanningPerSample(samplesPerBlock);
+        const int segmentLength = segmentEnd - position;
+        if (renderSegment(outputLeft + position, outputRight + position, segmentLength)) {
+            anyActive = true;
+        }
 
-    // Převod prokládaného bufferu na neprokládaný pro LFO panning
-    std::vector<float> tempLeftOut(samplesPerBlock);
-    std::vector<float> tempRightOut(samplesPerBlock);
-    for (int i = 0; i < samplesPerBlock; ++i) {
-        tempLeftOut[i] = outputBuffer[i].left;
-        tempRightOut[i] = outputBuffer[i].right;
-    }
-    applyLfoPanToFinalMix(tempLeftOut.data(), tempRightOut.data(), samplesPerBlock);
-    for (int i = 0; i < samplesPerBlock; ++i) {
-        outputBuffer[i].left = tempLeftOut[i];
-        outputBuffer[i].right = tempRightOut[i];
+        position = segmentEnd;
     }
 
     return anyActive;
 }
 
+void VoiceManager::drainCommandQueue() noexcept {
+    if (commandQueue_.empty()) return;
+
+    // Počet je omezen kapacitou - producenti nemohou audio thread zablokovat
+    MidiEvent event;
+    for (size_t i = 0; i < COMMAND_QUEUE_SIZE && commandQueue_.pop(event); ++i) {
+        handleMidiEvent(event);
+    }
+}
+
+void VoiceManager::handleMidiEvent(const MidiEvent& event) noexcept {
+    switch (event.type) {
+        // Události partu: v klasickém režimu setPart* delegují na globální settery
+        case MidiEventType::NoteOn:
+            // Velocity 0 je podle MIDI specifikace note-off
+            setPartNoteStateMIDI(event.channel, event.data1, event.data2 > 0, event.data2);
+            break;
+        case MidiEventType::NoteOff:
+            setPartNoteStateMIDI(event.channel, event.data1, false, event.data2);
+            break;
+        case MidiEventType::SustainPedal:
+            setPartSustainPedalMIDI(event.channel, event.data1 >= 64);
+            break;
+        case MidiEventType::MasterGain:
+            setPartMasterGainMIDI(event.channel, event.data1);
+            break;
+        case MidiEventType::Pan:
+            setPartPanMIDI(event.channel, event.data1);
+            break;
+        case MidiEventType::Attack:
+            setPartAttackMIDI(event.channel, event.data1);
+            break;
+        case MidiEventType::Release:
+            setPartReleaseMIDI(event.channel, event.data1);
+            break;
+        case MidiEventType::SustainLevel:
+            setPartSustainLevelMIDI(event.channel, event.data1);
+            break;
+        case MidiEventType::StereoField:
+            setPartStereoFieldAmountMIDI(event.channel, event.data1);
+            break;
+        // Globální události (sdílené LFO a DSP chain)
+        case MidiEventType::PanSpeed:
+            setAllVoicesPanSpeedMIDI(event.data1);
+            break;
+        case MidiEventType::PanDepth:
+            setAllVoicesPanDepthMIDI(event.data1);
+            break;
+        case MidiEventType::LimiterThreshold:
+            setLimiterThresholdMIDI(event.data1);
+            break;
+        case MidiEventType::LimiterRelease:
+            setLimiterReleaseMIDI(event.data1);
+            break;
+        case MidiEventType::LimiterEnabled:
+            setLimiterEnabledMIDI(event.data1);
+            break;
+        case MidiEventType::BBEDefinition:
+            setBBEDefinitionMIDI(event.data1);
+            break;
+        case MidiEventType::BBEBassBoost:
+            setBBEBassBoostMIDI(event.data1);
+            break;
+    }
+}
+
 void VoiceManager::applyLfoPanToFinalMix(float* leftOut, float* rightOut, int numSamples) noexcept {
-    // Aplikace LFO panningu na finální mix s vyhlazováním gainu
-    // Always update previousPan state to prevent discontinuities when depth changes from 0
+    if (numSamples <= 0) return;
+
+    // Bypass: depth ustálená na nule a rampa dojela do středu - oscilátor ani
+    // rampy se nepočítají, zbývá jen konstantní gain středu panoramy
+    float centerLeft, centerRight;
+    if (isLfoPanBypassed(centerLeft, centerRight)) {
+        advanceLfoPhase(numSamples);
+
+        const SimdDispatch::Kernels& simd = SimdDispatch::kernels();
+        simd.applyGain(leftOut, numSamples, centerLeft);
+        simd.applyGain(rightOut, numSamples, centerRight);
+        return;
+    }
+
+    // Aktivní LFO: parametry a oscilátor v block-rate krocích po LFO_RAMP_SAMPLES,
+    // mezi body lineární rampa gainů aplikovaná v jediném průchodu
+    const SimdDispatch::Kernels& simd = SimdDispatch::kernels();
+    float gainLeft = previousPanLeft_;
+    float gainRight = previousPanRight_;
 
-    float currentPanLeft = previousPanLeft_;
-    float currentPanRight = previousPanRight_;
+    for (int offset = 0; offset < numSamples; offset += LFO_RAMP_SAMPLES) {
+        const int count = std::min(LFO_RAMP_SAMPLES, numSamples - offset);
 
-    for (int i = 0; i < numSamples; ++i) {
-        // Získání panning gainů z lookup tabulky (již obsahuje interpolovaný depth)
-        float panLeft, panRight;
-        Panning::getPanGains(lfoPanBuffer_[i], panLeft, panRight);
+        float targetLeft, targetRight;
+        stepLfoSegment(count, targetLeft, targetRight);
 
-        // Exponenciální vyhlazování gainů pro eliminaci zip noise
-        currentPanLeft = (LFO_SMOOTHING * currentPanLeft) + ((1.0f - LFO_SMOOTHING) * panLeft);
-        currentPanRight = (LFO_SMOOTHING * currentPanRight) + ((1.0f - LFO_SMOOTHING) * panRight);
+        const float invCount = 1.0f / static_cast<float>(count);
+        const float slopeLeft = (targetLeft - gainLeft) * invCount;
+        const float slopeRight = (targetRight - gainRight) * invCount;
 
-        // Aplikace gainů na výstupní vzorky
-        leftOut[i] *= currentPanLeft;
-        rightOut[i] *= currentPanRight;
+        // gain[i] = start + slope · (i + 1)
+        simd.applyGainRamp(leftOut + offset, count, gainLeft, slopeLeft);
+        simd.applyGainRamp(rightOut + offset, count, gainRight, slopeRight);
+
+        gainLeft = targetLeft;
+        gainRight = targetRight;
     }
 
-    // Uložení aktuálních gainů pro další blok
-    previousPanLeft_ = currentPanLeft;
-    previousPanRight_ = currentPanRight;
+    // Gainy na konci bloku = začátek rampy dalšího bloku
+    previousPanLeft_ = gainLeft;
+    previousPanRight_ = gainRight;
 }
 
 // ===== VOICE CONTROL =====
 
 void VoiceManager::stopAllVoices() noexcept {
-    for (Voice* voice : activeVoices_) {
-        if (voice && voice->isActive()) {
-            voice->setNoteState(false, 0);
+    activeVoiceMask_.forEach([&](int index) {
+        Voice& voice = voices_[index];
+        if (voice.isActive()) {
+            voice.setNoteState(false, 0);
         }
-    }
+        updateVoiceStateMask(index);
+    });
     
     // Clear all delayed note-offs
     delayedNoteOffs_.fill(false);
+    for (PartState& part : parts_) {
+        part.delayedNoteOffs.fill(false);
+    }
 }
 
 void VoiceManager::resetAllVoices(Logger& logger) {
@@ -636,13 +1017,22 @@ void VoiceManager::resetAllVoices(Logger& logger) {
         voices_[i].cleanup(logger);
     }
     
-    activeVoices_.clear();
-    voicesToRemove_.clear();
+    activeVoiceMask_.clear();
+    sustainingVoiceMask_.clear();
+    releasingVoiceMask_.clear();
     activeVoicesCount_.store(0);
     
     // Reset sustain pedal state
     sustainPedalActive_.store(false);
     delayedNoteOffs_.fill(false);
+
+    // cleanup() vrátil gainy hlasů na výchozí - hlasy se partům přidělí znovu
+    voicePart_.fill(NO_PART);
+    for (PartState& part : parts_) {
+        part.sustainPedalActive = false;
+        part.delayedNoteOffs.fill(false);
+        part.noteVoice.fill(NO_VOICE);
+    }
     
     // Reset LFO parameters
     resetLfoParameters();
@@ -661,59 +1051,79 @@ void VoiceManager::setAllVoicesMasterGainMIDI(uint8_t midi_gain, Logger& logger)
         return;
     }
     
-    float gain = midi_gain / 127.0f;
-
-    for (int i = 0; i < 128; ++i) {
-        voices_[i].setMasterGain(gain);
-    }
+    applyMasterGainMIDI(midi_gain);
     
     logger.log("VoiceManager/setAllVoicesMasterGain", LogSeverity::Info, 
-           "Master gain set to " + std::to_string(gain) + " for all voices");
+           "Master gain set to " + std::to_string(midi_gain / 127.0f) + " for all voices");
 }
 
 void VoiceManager::setAllVoicesPanMIDI(uint8_t midi_pan) noexcept {
     if (midi_pan > 127) return;
     
-    float pan = (midi_pan - 64.0f) / 63.0f;
-    
+    if (partCount_ > 1) {
+        for (int part = 0; part < partCount_; ++part) {
+            setPartPanMIDI(static_cast<uint8_t>(part), midi_pan);
+        }
+        return;
+    }
+
     // Static pan is overridden by LFO panning if active
     if (!isLfoPanningActive()) {
-        for (int i = 0; i < 128; ++i) {
-            voices_[i].setPan(pan);
-        }
+        voiceParams_.setPan((midi_pan - 64.0f) / 63.0f);
     }
 }
 
 void VoiceManager::setAllVoicesAttackMIDI(uint8_t midi_attack) noexcept {
     if (midi_attack > 127) return;
-    
-    for (int i = 0; i < 128; ++i) {
-        voices_[i].setAttackMIDI(midi_attack);
+
+    if (partCount_ > 1) {
+        for (int part = 0; part < partCount_; ++part) {
+            setPartAttackMIDI(static_cast<uint8_t>(part), midi_attack);
+        }
+        return;
     }
+    
+    // Obálka je sdílená všemi hlasy - převezme hodnotu na začátku sub-bloku
+    voiceParams_.setAttackMIDI(midi_attack);
 }
 
 void VoiceManager::setAllVoicesReleaseMIDI(uint8_t midi_release) noexcept {
     if (midi_release > 127) return;
-    
-    for (int i = 0; i < 128; ++i) {
-        voices_[i].setReleaseMIDI(midi_release);
+
+    if (partCount_ > 1) {
+        for (int part = 0; part < partCount_; ++part) {
+            setPartReleaseMIDI(static_cast<uint8_t>(part), midi_release);
+        }
+        return;
     }
+    
+    voiceParams_.setReleaseMIDI(midi_release);
 }
 
 void VoiceManager::setAllVoicesSustainLevelMIDI(uint8_t midi_sustain) noexcept {
     if (midi_sustain > 127) return;
-    
-    for (int i = 0; i < 128; ++i) {
-        voices_[i].setSustainLevelMIDI(midi_sustain);
+
+    if (partCount_ > 1) {
+        for (int part = 0; part < partCount_; ++part) {
+            setPartSustainLevelMIDI(static_cast<uint8_t>(part), midi_sustain);
+        }
+        return;
     }
+    
+    voiceParams_.setSustainLevelMIDI(midi_sustain);
 }
 
 void VoiceManager::setAllVoicesStereoFieldAmountMIDI(uint8_t midi_stereo) noexcept {
     if (midi_stereo > 127) return;
-    
-    for (int i = 0; i < 128; ++i) {
-        voices_[i].setStereoFieldAmountMIDI(midi_stereo);
+
+    if (partCount_ > 1) {
+        for (int part = 0; part < partCount_; ++part) {
+            setPartStereoFieldAmountMIDI(static_cast<uint8_t>(part), midi_stereo);
+        }
+        return;
     }
+    
+    voiceParams_.setStereoFieldAmountMIDI(midi_stereo);
 }
 
 // ===== LFO PANNING CONTROL =====
@@ -722,7 +1132,7 @@ void VoiceManager::setAllVoicesPanSpeedMIDI(uint8_t midi_speed) noexcept {
     if (midi_speed > 127) return;
 
     panSpeedTarget_ = LfoPanning::getFrequencyFromMIDI(midi_speed);
-    // panSpeed_ will be smoothly interpolated to panSpeedTarget_ in applyLfoPanningPerSample()
+    // panSpeed_ will be smoothly interpolated to panSpeedTarget_ in applyLfoPanToFinalMix()
     // No special handling needed - LFO runs continuously regardless of speed value
 }
 
@@ -730,7 +1140,7 @@ void VoiceManager::setAllVoicesPanDepthMIDI(uint8_t midi_depth) noexcept {
     if (midi_depth > 127) return;
 
     panDepthTarget_ = LfoPanning::getDepthFromMIDI(midi_depth);
-    // panDepth_ will be smoothly interpolated to panDepthTarget_ in applyLfoPanningPerSample()
+    // panDepth_ will be smoothly interpolated to panDepthTarget_ in applyLfoPanToFinalMix()
 }
 
 bool VoiceManager::isLfoPanningActive() const noexcept {
@@ -739,6 +1149,12 @@ bool VoiceManager::isLfoPanningActive() const noexcept {
     return (panSpeed_ > 0.0f) && ((panDepth_ > 0.0f) || (panDepthTarget_ > 0.0f));
 }
 
+// ===== MULTI-CORE RENDERING =====
+
+void VoiceManager::setRenderThreadCount(int numThreads, Logger& logger) {
+    renderPool_.start(numThreads, logger);
+}
+
 // ===== VOICE ACCESS =====
 
 Voice& VoiceManager::getVoiceMIDI(uint8_t midiNote) noexcept {
@@ -751,23 +1167,11 @@ Voice& VoiceManager::getVoiceMIDI(uint8_t midiNote) noexcept {
 // ===== STATISTICS =====
 
 int VoiceManager::getSustainingVoicesCount() const noexcept {
-    int count = 0;
-    for (const Voice* voice : activeVoices_) {
-        if (voice && voice->getState() == VoiceState::Sustaining) {
-            ++count;
-        }
-    }
-    return count;
+    return sustainingVoiceMask_.count();
 }
 
 int VoiceManager::getReleasingVoicesCount() const noexcept {
-    int count = 0;
-    for (const Voice* voice : activeVoices_) {
-        if (voice && voice->getState() == VoiceState::Releasing) {
-            ++count;
-        }
-    }
-    return count;
+    return releasingVoiceMask_.count();
 }
 
 // ===== REAL-TIME MODE =====
@@ -804,6 +1208,16 @@ void VoiceManager::logSystemStatistics(Logger& logger) {
            "Sustaining Voices: " + std::to_string(getSustainingVoicesCount()));
     logger.log("VoiceManager/statistics", LogSeverity::Info, 
            "Releasing Voices: " + std::to_string(getReleasingVoicesCount()));
+    logger.log("VoiceManager/statistics", LogSeverity::Info, 
+           "Parts: " + std::to_string(partCount_) + (partCount_ > 1 ? " (multi-timbral)" : " (classic)"));
+    if (partCount_ > 1) {
+        for (int part = 0; part < partCount_; ++part) {
+            logger.log("VoiceManager/statistics", LogSeverity::Info, 
+                   "  Part " + std::to_string(part) + ": " +
+                   std::to_string(getPartActiveVoicesCount(static_cast<uint8_t>(part))) + " active voices" +
+                   (parts_[part].sustainPedalActive ? ", pedal down" : ""));
+        }
+    }
     
     logger.log("VoiceManager/statistics", LogSeverity::Info, "------------------------");
     logger.log("VoiceManager/statistics", LogSeverity::Info, "Sustain Pedal Status:");
@@ -831,9 +1245,39 @@ void VoiceManager::logSystemStatistics(Logger& logger) {
     logger.log("VoiceManager/statistics", LogSeverity::Info, 
            "LFO Depth: " + std::to_string(panDepth_));
     logger.log("VoiceManager/statistics", LogSeverity::Info, 
-           "LFO Phase: " + std::to_string(lfoPhase_) + " radians");
+           "LFO Phase: " + std::to_string(static_cast<double>(lfoPhase_) / LfoPanning::PHASE_FIXED_SCALE *
+                                         LfoPanning::TWO_PI) + " radians");
     logger.log("VoiceManager/statistics", LogSeverity::Info, 
            "LFO Active: " + std::string(isLfoPanningActive() ? "Yes" : "No"));
+
+    if (isCpuProfilingEnabled()) {
+        logger.log("VoiceManager/statistics", LogSeverity::Info, "------------------------");
+        logger.log("VoiceManager/statistics", LogSeverity::Info, "CPU per sub-block (min/avg/max us):");
+        logger.log("VoiceManager/statistics", LogSeverity::Info, "------------------------");
+
+        auto logMeter = [&logger](const std::string& name, const CpuMeter& meter) {
+            const CpuMeterSnapshot snapshot = meter.getSnapshot();
+            if (snapshot.windows == 0) {
+                logger.log("VoiceManager/statistics", LogSeverity::Info, name + ": no data");
+                return;
+            }
+            logger.log("VoiceManager/statistics", LogSeverity::Info,
+                   name + ": " + std::to_string(CpuMeter::ticksToMicroseconds(snapshot.minTicks)) + " / " +
+                   std::to_string(CpuMeter::ticksToMicroseconds(snapshot.avgTicks)) + " / " +
+                   std::to_string(CpuMeter::ticksToMicroseconds(snapshot.maxTicks)));
+        };
+
+        logMeter("Voice Render", voiceRenderMeter_);
+        for (size_t i = 0; i < dspChain_.getEffectCount(); ++i) {
+            const DspEffect* effect = dspChain_.getEffect(i);
+            const auto meter = dspChain_.getEffectCpuMeter(i);
+            if (effect && meter) {
+                logMeter(effect->getName(), *meter);
+            }
+        }
+        logMeter("BBE", getBBECpuMeter());
+        logMeter("Limiter", getLimiterCpuMeter());
+    }
     
     logger.log("VoiceManager/statistics", LogSeverity::Info, "========================");
 }
@@ -846,15 +1290,23 @@ void VoiceManager::initializeVoicesWithInstruments(Logger& logger) {
     
     for (int i = 0; i < 128; ++i) {
         uint8_t midiNote = static_cast<uint8_t>(i);
-        const Instrument& inst = instrumentLoader_.getInstrumentNote(midiNote);
+        const Instrument& inst = sampleBank_->getInstrumentNote(midiNote);
         Voice& voice = voices_[i];
 
-        // Initialize voice with per-instance envelope wrapper and InstrumentLoader reference
+        // Initialize voice with per-instance envelope wrapper and shared InstrumentLoader reference
         // InstrumentLoader pointer enables dynamic velocity layer size calculation (1-8 layers)
-        voice.initialize(inst, currentSampleRate_, envelope_, logger, &instrumentLoader_);
+        voice.initialize(inst, currentSampleRate_, envelope_, logger, &sampleBank_->getInstrumentLoader());
+        voice.bindParameters(voiceParams_);
         voice.prepareToPlay(512);
     }
 
+    // Hlasy jsou opět vázané na svou notu - multi-timbral party si je přidělí znovu
+    // (obálky partů převezmou nový sample rate)
+    voicePart_.fill(NO_PART);
+    for (int part = 0; part < ITHACA_MAX_PARTS; ++part) {
+        resetPartState(parts_[part]);
+    }
+
     // ===== DEFAULT PARAMETER INITIALIZATION (MIDI values 0-127) =====
 
     // Envelope defaults
@@ -883,7 +1335,20 @@ void VoiceManager::initializeVoicesWithInstruments(Logger& logger) {
 
 bool VoiceManager::needsReinitialization(int targetSampleRate) const noexcept {
     return (currentSampleRate_ != targetSampleRate) || 
-           (instrumentLoader_.getActualSampleRate() != targetSampleRate);
+           !sampleBank_ || (sampleBank_->getSampleRate() != targetSampleRate);
+}
+
+void VoiceManager::applyMasterGainMIDI(uint8_t midi_gain) noexcept {
+    if (midi_gain > 127) return;
+
+    if (partCount_ > 1) {
+        for (int part = 0; part < partCount_; ++part) {
+            setPartMasterGainMIDI(static_cast<uint8_t>(part), midi_gain);
+        }
+        return;
+    }
+
+    voiceParams_.setMasterGain(midi_gain / 127.0f);
 }
 
 void VoiceManager::reinitializeIfNeeded(int targetSampleRate, Logger& logger) {
@@ -892,104 +1357,178 @@ void VoiceManager::reinitializeIfNeeded(int targetSampleRate, Logger& logger) {
     }
 }
 
-// ===== LFO PANNING HELPERS =====
+// ===== MULTI-TIMBRAL HELPERS =====
+
+void VoiceManager::syncEnvelope(Envelope& envelope, const VoiceParams& params) noexcept {
+    envelope.setAttackMIDI(params.getAttackMIDI());
+    envelope.setReleaseMIDI(params.getReleaseMIDI());
+    envelope.setSustainLevelMIDI(params.getSustainLevelMIDI());
+}
+
+void VoiceManager::resetPartState(PartState& state) noexcept {
+    state.envelope.setSampleRate(currentSampleRate_);
+
+    // Výchozí parametry partu (kratší release než klasický režim)
+    state.params.reset();
+    state.params.setReleaseMIDI(4);
+    syncEnvelope(state.envelope, state.params);
+    state.sustainPedalActive = false;
+    state.delayedNoteOffs.fill(false);
+    state.noteVoice.fill(NO_VOICE);
+    state.maxVoices = 0;
+}
+
+int VoiceManager::findPartVoice(uint8_t part, uint8_t midiNote) const noexcept {
+    const int index = parts_[part].noteVoice[midiNote];
+    if (index == NO_VOICE) return -1;
+
+    // Mapa je jen nápověda - hlas mohl mezitím připadnout jinému partu nebo notě
+    if (voicePart_[index] != part || voices_[index].getMidiNote() != midiNote) return -1;
 
-void VoiceManager::applyLfoPanningPerSample(int samplesPerBlock) noexcept {
-    // Generování hodnot LFO panningu pro každý vzorek
-    if (lfoPanBuffer_.size() < static_cast<size_t>(samplesPerBlock)) {
-        lfoPanBuffer_.resize(samplesPerBlock);
+    return index;
+}
+
+int VoiceManager::allocatePartVoice(uint8_t part, uint8_t midiNote) noexcept {
+    if (!sampleBank_) return -1;
+
+    PartState& state = parts_[part];
+    int index = -1;
+
+    if (state.maxVoices > 0 && getPartActiveVoicesCount(part) >= state.maxVoices) {
+        // Part na limitu polyfonie krade jen své hlasy - nejstarší releasing, pak nejstarší
+        index = findOldestVoice(releasingVoiceMask_, part);
+        if (index < 0) index = findOldestVoice(activeVoiceMask_, part);
+    } else {
+        // Volný hlas, jinak krádež nejstaršího v pořadí releasing → sustaining → libovolný aktivní
+        index = activeVoiceMask_.findFirstClear();
+        if (index < 0) index = findOldestVoice(releasingVoiceMask_, NO_PART);
+        if (index < 0) index = findOldestVoice(sustainingVoiceMask_, NO_PART);
+        if (index < 0) index = findOldestVoice(activeVoiceMask_, NO_PART);
     }
+    if (index < 0 || index >= static_cast<int>(voices_.size())) return -1;
 
-    // Výpočet interpolačního kroku pro plynulé přechody (stejný pro speed i depth)
-    const float deltaPerSample = (currentSampleRate_ > 0)
-        ? (1.0f / (panSmoothingTime_ * currentSampleRate_))
-        : 0.0f;
+    Voice& voice = voices_[index];
 
-    for (int sample = 0; sample < samplesPerBlock; ++sample) {
-        // Plynulá interpolace speed k cílové hodnotě (stejně jako depth)
-        if (panSpeed_ < panSpeedTarget_) {
-            panSpeed_ += deltaPerSample;
-            if (panSpeed_ > panSpeedTarget_) {
-                panSpeed_ = panSpeedTarget_;
-            }
-        } else if (panSpeed_ > panSpeedTarget_) {
-            panSpeed_ -= deltaPerSample;
-            if (panSpeed_ < panSpeedTarget_) {
-                panSpeed_ = panSpeedTarget_;
-            }
-        }
+    // Ukradený hlas dozní přes damping buffer, parametry převezme od nového partu
+    voice.retarget(midiNote, sampleBank_->getInstrumentNote(midiNote), state.envelope, state.params);
 
-        // Plynulá interpolace depth k cílové hodnotě
-        if (panDepth_ < panDepthTarget_) {
-            panDepth_ += deltaPerSample;
-            if (panDepth_ > panDepthTarget_) {
-                panDepth_ = panDepthTarget_;
-            }
-        } else if (panDepth_ > panDepthTarget_) {
-            panDepth_ -= deltaPerSample;
-            if (panDepth_ < panDepthTarget_) {
-                panDepth_ = panDepthTarget_;
-            }
+    voicePart_[index] = part;
+    state.noteVoice[midiNote] = static_cast<int16_t>(index);
+    return index;
+}
+
+int VoiceManager::findOldestVoice(const VoiceBitmask& candidates, uint8_t part) const noexcept {
+    // Krádež je řídká (plný pool / limit partu) - lineární průchod kandidátů stačí
+    int oldest = -1;
+    candidates.forEach([&](int index) {
+        if (part != NO_PART && voicePart_[index] != part) return;
+        if (oldest < 0 || voiceNoteOnOrder_[index] < voiceNoteOnOrder_[oldest]) oldest = index;
+    });
+    return oldest;
+}
+
+void VoiceManager::processPartDelayedNoteOffs(uint8_t part) noexcept {
+    PartState& state = parts_[part];
+
+    for (int i = 0; i < 128; ++i) {
+        if (!state.delayedNoteOffs[i]) continue;
+        state.delayedNoteOffs[i] = false;
+
+        const int index = findPartVoice(part, static_cast<uint8_t>(i));
+        if (index >= 0 && voices_[index].isActive()) {
+            voices_[index].setNoteState(false, 0);
+            updateVoiceStateMask(index);
         }
+    }
+}
+
+// ===== LFO PANNING HELPERS =====
+
+bool VoiceManager::isLfoPanBypassed(float& centerLeft, float& centerRight) const noexcept {
+    LfoPanning::getConstantPowerGains(0.0f, centerLeft, centerRight);
+
+    return panDepth_ == 0.0f && panDepthTarget_ == 0.0f &&
+           previousPanLeft_ == centerLeft && previousPanRight_ == centerRight;
+}
+
+void VoiceManager::advanceLfoPhase(int numSamples) noexcept {
+    // Fáze běží dál i bez hloubky - po návratu depth LFO naváže bez skoku
+    panSpeed_ = stepTowards(panSpeed_, panSpeedTarget_, lfoSmoothingStep() * static_cast<float>(numSamples));
+    lfoPhase_ += LfoPanning::calculatePhaseIncrementFixed(panSpeed_, currentSampleRate_) *
+                 static_cast<uint32_t>(numSamples);
+}
+
+void VoiceManager::stepLfoSegment(int count, float& targetLeft, float& targetRight) noexcept {
+    const float step = lfoSmoothingStep() * static_cast<float>(count);
+
+    panSpeed_ = stepTowards(panSpeed_, panSpeedTarget_, step);
+    panDepth_ = stepTowards(panDepth_, panDepthTarget_, step);
+
+    // Fixed-point akumulátor: přetečení uint32_t = wrap přes 2π
+    lfoPhase_ += LfoPanning::calculatePhaseIncrementFixed(panSpeed_, currentSampleRate_) *
+                 static_cast<uint32_t>(count);
 
-        // Výpočet phase increment z interpolovaného speed (per-sample)
-        const float phaseIncrement = (currentSampleRate_ > 0)
-            ? LfoPanning::calculatePhaseIncrement(panSpeed_, currentSampleRate_)
-            : 0.0f;
+    LfoPanning::getConstantPowerGains(LfoPanning::getSineValueFixed(lfoPhase_) * panDepth_,
+                                      targetLeft, targetRight);
+}
 
-        // Výpočet LFO hodnoty z předpočítané sinusové tabulky s interpolovaným depth
-        float lfoValue = LfoPanning::getSineValue(lfoPhase_);
-        lfoPanBuffer_[sample] = lfoValue * panDepth_;
+void VoiceManager::advanceLfoPan(int numSamples) noexcept {
+    if (numSamples <= 0) return;
 
-        // Posun fáze LFO o jeden vzorek (s per-sample vypočítaným phase increment)
-        lfoPhase_ += phaseIncrement;
+    // Stejná trajektorie stavu jako applyLfoPanToFinalMix(), jen bez zápisu do bufferu
+    float centerLeft, centerRight;
+    if (isLfoPanBypassed(centerLeft, centerRight)) {
+        advanceLfoPhase(numSamples);
+        return;
+    }
 
-        // Ořezání fáze do platného rozsahu (0.0-2π)
-        lfoPhase_ = LfoPanning::wrapPhase(lfoPhase_);
+    for (int offset = 0; offset < numSamples; offset += LFO_RAMP_SAMPLES) {
+        stepLfoSegment(std::min(LFO_RAMP_SAMPLES, numSamples - offset), previousPanLeft_, previousPanRight_);
     }
 }
 
+float VoiceManager::stepTowards(float current, float target, float step) noexcept {
+    if (current < target) return std::min(current + step, target);
+    if (current > target) return std::max(current - step, target);
+    return current;
+}
+
 void VoiceManager::resetLfoParameters() noexcept {
     panSpeed_ = 0.0f;
     panSpeedTarget_ = 0.0f;
     panDepth_ = 0.0f;
     panDepthTarget_ = 0.0f;
-    lfoPhase_ = 0.0f;
-    previousPanLeft_ = 1.0f;  // Reset předchozích gainů
-    previousPanRight_ = 1.0f;
+    lfoPhase_ = 0;
+    // Rampa startuje ve středu panoramy - LFO stage je hned v bypassu
+    LfoPanning::getConstantPowerGains(0.0f, previousPanLeft_, previousPanRight_);
 }
 
 // ===== VOICE POOL MANAGEMENT =====
 
-void VoiceManager::addActiveVoice(Voice* voice) noexcept {
-    if (!voice) return;
-    
-    auto it = std::find(activeVoices_.begin(), activeVoices_.end(), voice);
-    if (it == activeVoices_.end()) {
-        activeVoices_.push_back(voice);
-        activeVoicesCount_.fetch_add(1);
-    }
+void VoiceManager::addActiveVoice(int index) noexcept {
+    if (activeVoiceMask_.test(index)) return;
+
+    activeVoiceMask_.set(index);
+    activeVoicesCount_.fetch_add(1);
 }
 
-void VoiceManager::removeActiveVoice(Voice* voice) noexcept {
-    if (!voice) return;
-    
-    auto it = std::find(activeVoices_.begin(), activeVoices_.end(), voice);
-    if (it != activeVoices_.end()) {
-        // Swap-and-pop optimization: O(1) instead of O(n)
-        if (it != activeVoices_.end() - 1) {
-            *it = activeVoices_.back();  // Swap with last element
-        }
-        activeVoices_.pop_back();        // Remove last element
-        activeVoicesCount_.fetch_sub(1);
-    }
+void VoiceManager::removeActiveVoice(int index) noexcept {
+    if (!activeVoiceMask_.test(index)) return;
+
+    activeVoiceMask_.reset(index);
+    sustainingVoiceMask_.reset(index);
+    releasingVoiceMask_.reset(index);
+    activeVoicesCount_.fetch_sub(1);
 }
 
-void VoiceManager::cleanupInactiveVoices() noexcept {
-    for (Voice* voice : voicesToRemove_) {
-        removeActiveVoice(voice);
-    }
-    voicesToRemove_.clear();
+void VoiceManager::updateVoiceStateMask(int index) noexcept {
+    const VoiceState state = voices_[index].getState();
+
+    if (state == VoiceState::Sustaining) sustainingVoiceMask_.set(index);
+    else sustainingVoiceMask_.reset(index);
+
+    if (state == VoiceState::Releasing) releasingVoiceMask_.set(index);
+    else releasingVoiceMask_.reset(index);
 }
 
 // ========================================================================
@@ -1046,3 +1585,13 @@ void VoiceManager::setBBEBassBoostMIDI(uint8_t midiValue) noexcept {
     }
 }
 
+
+// ═════════════════════════════════════════════════════════════════════
+// CPU PROFILING
+// ═════════════════════════════════════════════════════════════════════
+
+void VoiceManager::setCpuProfilingEnabled(bool enabled) noexcept {
+    cpuProfilingEnabled_.store(enabled, std::memory_order_relaxed);
+    masterChain_.setProfilingEnabled(enabled);
+    dspChain_.setProfilingEnabled(enabled);
+}
@@ -2,12 +2,18 @@
 #define VOICE_MANAGER_H
 
 #include "voice.h"
+#include "midi_event.h"
+#include "command_queue.h"
+#include "voice_bitmask.h"
+#include "voice_render_pool.h"
 #include "envelopes/envelope.h"
 #include "envelopes/envelope_static_data.h"
 #include "instrument_loader.h"
+#include "sample_bank_registry.h"
 #include "sampler.h"
 #include "lfopan.h"
 #include "dsp/dsp_chain.h"
+#include "dsp/static_dsp_chain.h"
 #include "dsp/bbe/bbe_processor.h"
 #include "dsp/limiter/limiter.h"
 
@@ -17,6 +23,12 @@
 #include <memory>
 #include <array>
 
+// ===== MULTI-TIMBRAL CONFIGURATION =====
+// Fallback pro nadřazený IthacaConfig.h bez této volby
+#ifndef ITHACA_MAX_PARTS
+#define ITHACA_MAX_PARTS 16
+#endif
+
 /**
  * @class VoiceManager
  * @brief Správce polyfonního audio systému s optimalizovaným využitím zdrojů a LFO panningem
@@ -28,8 +40,12 @@
  * - Konstantní panning s předpočítanými tabulkami
  * - Automatický LFO panning pro efekty elektrického piana
  * - RT-safe zpracování audia s předem alokovanými buffery
- * - Swap-and-pop optimalizace pro O(1) výkon
+ * - Ochrana proti denormálům (FTZ/DAZ) po dobu každého process*() / finalizeBlock() volání
+ * - Hot kernely (mix hlasů, rampy gainů, interleave) vybrané za běhu podle CPU (SimdDispatch)
+ * - Bitové množiny aktivních/sustaining/releasing hlasů (O(1) dotazy, ctz iterace)
  * - Podpora sustain pedálu (MIDI CC64) s odloženým note-off
+ * - Multi-timbral režim: až ITHACA_MAX_PARTS partů (MIDI kanálů) nad jedním
+ *   voice poolem, render batchí, LFO a DSP chain
  */
 class VoiceManager {
 public:
@@ -89,8 +105,10 @@ public:
     // ===== INITIALIZATION PIPELINE =====
     
     /**
-     * @brief Phase 1: System initialization and directory scanning
+     * @brief Phase 1: System initialization and sample directory validation
      * @param logger Reference to Logger
+     * @note Directory scanning itself happens in phase 2 via SampleBankRegistry
+     *       (bank is keyed by directory, sample rate and velocity layer count)
      * @note Non-RT: may allocate and log
      */
     void initializeSystem(Logger& logger);
@@ -99,6 +117,9 @@ public:
      * @brief Phase 2: Load sample data for specific sample rate
      * @param sampleRate Target sample rate (44100 or 48000 Hz)
      * @param logger Reference to Logger
+     * @note Bank is acquired from SampleBankRegistry - instances with the same
+     *       directory, rate and layer count share one read-only copy in RAM.
+     *       The previous bank is released only after voices are re-pointed.
      * @note Non-RT: may allocate and log
      */
     void loadForSampleRate(int sampleRate, Logger& logger);
@@ -155,6 +176,7 @@ public:
      * @param velocity MIDI velocity (0-127) affecting volume
      * @note RT-safe: no allocations, automatic voice pool management
      * @note Sustain pedal: if pedal is pressed, note-off events are delayed
+     * @note Multi-timbral mode: targets part 0
      */
     void setNoteStateMIDI(uint8_t midiNote, bool isOn, uint8_t velocity) noexcept;
 
@@ -164,6 +186,7 @@ public:
      * @param isOn true for note-on, false for note-off
      * @note RT-safe: uses ITHACA_DEFAULT_VELOCITY for note-on
      * @note Sustain pedal: if pedal is pressed, note-off events are delayed
+     * @note Multi-timbral mode: targets part 0
      */
     void setNoteStateMIDI(uint8_t midiNote, bool isOn) noexcept;
 
@@ -182,6 +205,7 @@ public:
      * Complexity: O(1) for pedal down, O(n) for pedal up where n = number of delayed notes
      * 
      * @note RT-safe: no allocations, only flag operations and voice method calls
+     * @note Multi-timbral mode: targets part 0 (each part has its own pedal)
      */
     void setSustainPedalMIDI(bool pedalDown) noexcept;
     
@@ -194,6 +218,110 @@ public:
         return sustainPedalActive_.load(); 
     }
 
+    // ===== MULTI-TIMBRAL PARTS =====
+
+    /**
+     * @brief Nastaví počet partů (MIDI kanálů) sdílejících tento engine
+     * @param partCount 1 = klasický režim (hlas = MIDI nota, kanál se ignoruje),
+     *                  2-ITHACA_MAX_PARTS = multi-timbral režim
+     * @param logger Reference to Logger
+     *
+     * V multi-timbral režimu má každý part vlastní obálku (attack/release/sustain),
+     * master gain, pan, stereo field, sustain pedál a volitelný limit polyfonie.
+     * Hlasy se přidělují dynamicky ze společného 128hlasého poolu: volný hlas,
+     * jinak se ukradne nejstarší releasing, pak sustaining, pak libovolný aktivní
+     * hlas (podle pořadí note-on, dozvuk přes damping buffer).
+     * Render, LFO panning, DSP chain i scratch buffery zůstávají jediné pro všechny
+     * party - part stojí jen svou sadu parametrů a mapu nota → hlas (< 1 KB).
+     *
+     * @note Non-RT: zastaví všechny hlasy a nastaví party na výchozí hodnoty.
+     *       Po návratu do klasického režimu mají hlasy výchozí gain, pan a stereo field.
+     */
+    void setPartCount(int partCount, Logger& logger);
+
+    /**
+     * @brief Get number of parts (1 = classic single-timbral mode)
+     */
+    int getPartCount() const noexcept { return partCount_; }
+
+    /**
+     * @brief Note-on/off pro notu daného partu
+     * @param part Part (MIDI kanál 0-15)
+     * @param midiNote MIDI note number (0-127)
+     * @param isOn true for note-on, false for note-off
+     * @param velocity MIDI velocity (0-127)
+     * @note RT-safe. V klasickém režimu deleguje na setNoteStateMIDI() (part se ignoruje),
+     *       v multi-timbral režimu se part mimo getPartCount() zahodí.
+     */
+    void setPartNoteStateMIDI(uint8_t part, uint8_t midiNote, bool isOn, uint8_t velocity) noexcept;
+
+    /**
+     * @brief Sustain pedál (CC64) daného partu
+     * @note RT-safe. V klasickém režimu deleguje na setSustainPedalMIDI().
+     */
+    void setPartSustainPedalMIDI(uint8_t part, bool pedalDown) noexcept;
+
+    /**
+     * @brief Master gain partu (0-127)
+     * @note RT-safe. V klasickém režimu platí pro všechny hlasy (bez logování).
+     */
+    void setPartMasterGainMIDI(uint8_t part, uint8_t midi_gain) noexcept;
+
+    /**
+     * @brief Statický pan partu (0-127, 64 = střed)
+     * @note RT-safe. Stejně jako setAllVoicesPanMIDI() se ignoruje při aktivním LFO panningu.
+     */
+    void setPartPanMIDI(uint8_t part, uint8_t midi_pan) noexcept;
+
+    /**
+     * @brief Attack obálky partu (0-127)
+     * @note RT-safe: atomický zápis do parametrů partu, hlasy ho převezmou od dalšího sub-bloku
+     */
+    void setPartAttackMIDI(uint8_t part, uint8_t midi_attack) noexcept;
+
+    /**
+     * @brief Release obálky partu (0-127)
+     * @note RT-safe: atomický zápis do parametrů partu, hlasy ho převezmou od dalšího sub-bloku
+     */
+    void setPartReleaseMIDI(uint8_t part, uint8_t midi_release) noexcept;
+
+    /**
+     * @brief Sustain level obálky partu (0-127)
+     * @note RT-safe: atomický zápis do parametrů partu, hlasy ho převezmou od dalšího sub-bloku
+     */
+    void setPartSustainLevelMIDI(uint8_t part, uint8_t midi_sustain) noexcept;
+
+    /**
+     * @brief Stereo field partu (0-127)
+     * @note RT-safe
+     */
+    void setPartStereoFieldAmountMIDI(uint8_t part, uint8_t midi_stereo) noexcept;
+
+    /**
+     * @brief Limit polyfonie partu
+     * @param part Part (MIDI kanál 0-15)
+     * @param maxVoices Max. počet současně znějících hlasů partu (0 = bez limitu, celý pool)
+     *
+     * Part na limitu při note-on ukradne svůj nejstarší hlas (nejdřív releasing,
+     * pak libovolný), hlasy ostatních partů nechá být.
+     *
+     * @note RT-safe. V klasickém režimu se ignoruje (hlas = MIDI nota).
+     *       setPartCount() limity vrací na 0.
+     */
+    void setPartPolyphony(uint8_t part, int maxVoices) noexcept;
+
+    /**
+     * @brief Limit polyfonie partu (0 = bez limitu)
+     */
+    int getPartPolyphony(uint8_t part) const noexcept;
+
+    /**
+     * @brief Počet aktivních hlasů vlastněných partem
+     * @return V klasickém režimu počet všech aktivních hlasů
+     * @note O(aktivní hlasy), pro diagnostiku a metering
+     */
+    int getPartActiveVoicesCount(uint8_t part) const noexcept;
+
     // ===== AUDIO PROCESSING =====
     
     /**
@@ -213,7 +341,8 @@ public:
      *        Po všech segmentech musí být zavolána finalizeBlock().
      * @param outputLeft Výstupní buffer levého kanálu (pointer na začátek segmentu)
      * @param outputRight Výstupní buffer pravého kanálu (pointer na začátek segmentu)
-     * @param samplesPerBlock Počet vzorků segmentu
+     * @param samplesPerBlock Počet vzorků segmentu (libovolný, hlasy se renderují
+     *        po sub-blocích ITHACA_INTERNAL_BLOCK_SIZE)
      * @return true pokud je nějaký hlas aktivní
      * @note RT-safe, buffer NENÍ nulován
      */
@@ -231,19 +360,78 @@ public:
 
     /**
      * @brief Zpracuje audio blok v prokládaném formátu
+     *
+     * Renderuje do planárního scratche VoiceManageru stejným řetězcem jako
+     * processBlockUninterleaved() (hlasy, LFO panning, DSP chain) a na konci
+     * jednou proloží do výstupu (SimdDispatch: SSE2/AVX2/AVX-512/NEON).
+     *
      * @param outputBuffer Výstupní buffer (prokládaný stereo)
      * @param samplesPerBlock Počet vzorků v bloku
      * @return true pokud je nějaký hlas aktivní
-     * @note RT-safe
+     * @note RT-safe, bez alokací (bloky delší než scratch se zpracují po částech)
      */
     bool processBlockInterleaved(AudioData* outputBuffer, int samplesPerBlock) noexcept;
-    
+
+    /**
+     * @brief Zpracuje audio blok se seznamem časově označených MIDI událostí
+     * @param eventsBegin Začátek pole událostí (seřazeno podle sampleOffset)
+     * @param eventsEnd Konec pole událostí (one-past-last)
+     * @param outputLeft Výstupní buffer levého kanálu
+     * @param outputRight Výstupní buffer pravého kanálu
+     * @param samplesPerBlock Počet vzorků v bloku
+     * @return true pokud je nějaký hlas aktivní
+     *
+     * Blok je interně rozdělen v místech událostí. Každý segment prochází
+     * hlasy, LFO panningem i DSP chain, takže i změny parametrů efektů
+     * (např. limiter threshold) platí přesně od vzorku události.
+     * Události se stejným offsetem se aplikují najednou bez prázdných segmentů.
+     *
+     * @note RT-safe, buffer JE nulován
+     * @note Nesetříděné události se nezahodí - offset menší než aktuální pozice
+     *       se aplikuje na aktuální pozici
+     */
+    bool processBlock(const MidiEvent* eventsBegin, const MidiEvent* eventsEnd,
+                      float* outputLeft, float* outputRight, int samplesPerBlock) noexcept;
+
+    /**
+     * @brief Okamžitě aplikuje jednu MIDI událost (bez ohledu na sampleOffset)
+     * @param event Událost k aplikaci
+     * @note RT-safe: deleguje na odpovídající *MIDI setter
+     */
+    void handleMidiEvent(const MidiEvent& event) noexcept;
+
+    // ===== CROSS-THREAD COMMAND QUEUE =====
+
+    /**
+     * @brief Pošle MIDI událost z libovolného vlákna do audio threadu
+     * @param event Událost (sampleOffset se ignoruje - aplikuje se na začátku bloku)
+     * @return false pokud je fronta plná (událost zahozena)
+     *
+     * MIDI a GUI vlákna by měla používat tuto cestu místo přímého volání
+     * setNoteStateMIDI()/setAllVoices*MIDI(), které mění voice pool a
+     * stav hlasů bez synchronizace s rendererem.
+     *
+     * @note Thread-safe, lock-free, O(1)
+     */
+    bool postMidiEvent(const MidiEvent& event) noexcept { return commandQueue_.push(event); }
+
+    /**
+     * @brief Aplikuje všechny čekající události z fronty (POUZE audio thread)
+     * @note Voláno automaticky na začátku processBlock(), processBlockUninterleaved()
+     *       a processBlockInterleaved(). Při ručním použití processBlockSegment()
+     *       zavolat jednou na začátku bloku.
+     * @note RT-safe
+     */
+    void drainCommandQueue() noexcept;
+
     /**
      * @brief Aplikuje LFO panning na finální mix
      * @param leftOut Výstupní buffer levého kanálu
      * @param rightOut Výstupní buffer pravého kanálu
      * @param numSamples Počet vzorků ke zpracování
-     * @note RT-safe: aplikuje LFO panning s vyhlazováním gainu
+     * @note RT-safe: jediný průchod - speed/depth a fixed-point oscilátor se
+     *       počítají po LFO_RAMP_SAMPLES vzorcích, mezi nimi lineární rampa gainů.
+     *       Při ustálené nulové hloubce se oscilátor přeskočí (bypass).
      */
     void applyLfoPanToFinalMix(float* leftOut, float* rightOut, int numSamples) noexcept;
 
@@ -263,12 +451,15 @@ public:
     void resetAllVoices(Logger& logger);
 
     // ===== GLOBAL VOICE PARAMETERS =====
+    // Master gain, pan a stereo field se zapisují do sdíleného bloku (VoiceParams),
+    // obálka je sdílená - změna je O(1), hlasy ji převezmou na začátku sub-bloku
 
     /**
      * @brief Set master gain for all voices via MIDI value
      * @param midi_gain Master gain as MIDI value (0-127)
      * @param logger Reference to Logger
      * @note Non-RT: may log parameter changes
+     * @note Multi-timbral mode: applies to all parts
      */
     void setAllVoicesMasterGainMIDI(uint8_t midi_gain, Logger& logger);
 
@@ -276,27 +467,31 @@ public:
      * @brief Set static pan for all voices via MIDI value
      * @param midi_pan Pan as MIDI value (0-127, 64=center)
      * @note RT-safe: converts MIDI to -1.0/+1.0 range
+     * @note Multi-timbral mode: applies to all parts
      */
     void setAllVoicesPanMIDI(uint8_t midi_pan) noexcept;
 
     /**
      * @brief Set attack time for all voices via MIDI value
      * @param midi_attack Attack as MIDI value (0-127)
-     * @note RT-safe: delegates to envelope system
+     * @note RT-safe: atomic store to VoiceParams, picked up at the next sub-block
+     * @note Multi-timbral mode: applies to all parts
      */
     void setAllVoicesAttackMIDI(uint8_t midi_attack) noexcept;
 
     /**
      * @brief Set release time for all voices via MIDI value
      * @param midi_release Release as MIDI value (0-127)
-     * @note RT-safe: delegates to envelope system
+     * @note RT-safe: atomic store to VoiceParams, picked up at the next sub-block
+     * @note Multi-timbral mode: applies to all parts
      */
     void setAllVoicesReleaseMIDI(uint8_t midi_release) noexcept;
 
     /**
      * @brief Set sustain level for all voices via MIDI value
      * @param midi_sustain Sustain level as MIDI value (0-127)
-     * @note RT-safe: delegates to envelope system
+     * @note RT-safe: atomic store to VoiceParams, picked up at the next sub-block
+     * @note Multi-timbral mode: applies to all parts
      */
     void setAllVoicesSustainLevelMIDI(uint8_t midi_sustain) noexcept;
 
@@ -304,6 +499,7 @@ public:
      * @brief Set stereo field amount for all voices via MIDI value
      * @param midi_stereo Stereo field as MIDI value (0-127)
      * @note RT-safe: calculates physical piano string position simulation
+     * @note Multi-timbral mode: applies to all parts
      */
     void setAllVoicesStereoFieldAmountMIDI(uint8_t midi_stereo) noexcept;
 
@@ -330,6 +526,25 @@ public:
      */
     bool isLfoPanningActive() const noexcept;
 
+    // ===== MULTI-CORE RENDERING =====
+
+    /**
+     * @brief Nastaví počet vláken pro mix hlasů (včetně audio threadu)
+     * @param numThreads 1 = jednovláknový režim, max ITHACA_RENDER_LANES
+     * @param logger Reference to Logger
+     *
+     * Výstup je bitově shodný pro libovolný počet vláken - hlasy se sčítají
+     * v pevných lanes a lanes v pevném pořadí (viz VoiceRenderPool).
+     *
+     * @note Non-RT: vytváří/ukončuje vlákna, nevolat během processBlock*
+     */
+    void setRenderThreadCount(int numThreads, Logger& logger);
+
+    /**
+     * @brief Get current number of render threads (including audio thread)
+     */
+    int getRenderThreadCount() const noexcept { return renderPool_.getThreadCount(); }
+
     // ===== VOICE ACCESS =====
 
     /**
@@ -337,6 +552,7 @@ public:
      * @param midiNote MIDI note number (0-127)
      * @return Reference to voice
      * @note Non-RT: for parameter setup and inspection
+     * @note V multi-timbral režimu index poolu neodpovídá hrané notě (viz Voice::getMidiNote())
      */
     Voice& getVoiceMIDI(uint8_t midiNote) noexcept;
 
@@ -480,20 +696,50 @@ public:
     // ========================================================================
 
     /**
-     * @brief Získá ukazatel na DspChain pro pokročilý přístup k efektům
+     * @brief Získá ukazatel na dynamický DspChain pro vlastní efekty
      * @return Pointer na DspChain (nikdy nullptr)
      *
-     * @note Pro pokročilé použití - přímý přístup k DSP chain
-     * @note Umožňuje volat settery/gettery přímo na efektech
+     * @note Pro pokročilé použití - efekty přidané addEffect() běží před
+     *       pevným master řetězcem BBE → Limiter (limiter zůstává poslední)
+     * @note Ve výchozím stavu prázdný; BBE a limiter se ovládají přes settery výše
+     * @note Efekty lze přidávat/odebírat i za běhu audia z řídicího threadu
+     *       (graf se publikuje atomicky, viz DspChain)
      */
     DspChain* getDspChain() { return &dspChain_; }
 
+    // ========================================================================
+    // DSP EFFECTS API - CPU Profiling (monitor/GUI)
+    // ========================================================================
+
+    /**
+     * @brief Zapne/vypne měření CPU času renderu hlasů a všech efektů
+     * @param enabled true = render hlasů, master řetězec i DspChain se měří
+     *
+     * @note RT-safe - libovolný thread, projeví se od dalšího sub-bloku
+     * @note Hodnoty jsou na jeden sub-blok ITHACA_INTERNAL_BLOCK_SIZE (viz CpuMeter)
+     */
+    void setCpuProfilingEnabled(bool enabled) noexcept;
+
+    /**
+     * @brief Zjistí, zda je měření CPU zapnuté
+     * @note RT-safe
+     */
+    bool isCpuProfilingEnabled() const noexcept { return cpuProfilingEnabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Měřiče CPU času (min/avg/max) - getSnapshot() lock-free z libovolného threadu
+     * @note Efekty dynamického řetězce: getDspChain()->getEffectCpuMeter(index)
+     */
+    const CpuMeter& getVoiceRenderCpuMeter() const noexcept { return voiceRenderMeter_; }
+    const CpuMeter& getBBECpuMeter() const noexcept { return masterChain_.getCpuMeter<BBEProcessor>(); }
+    const CpuMeter& getLimiterCpuMeter() const noexcept { return masterChain_.getCpuMeter<Limiter>(); }
+
 private:
     // ===== CORE COMPONENTS =====
     
-    SamplerIO samplerIO_;               // Sample directory scanner and file manager
-    InstrumentLoader instrumentLoader_; // Sample loading and instrument creation
+    std::shared_ptr<const SampleBank> sampleBank_;  // Sdílená read-only banka (SampleBankRegistry)
     Envelope envelope_;                 // Per-instance envelope state wrapper
+    VoiceParams voiceParams_;           // Sdílený blok parametrů hlasů (klasický režim)
     
     // ===== SYSTEM STATE =====
 
@@ -505,12 +751,20 @@ private:
     // ===== VOICE MANAGEMENT =====
     
     std::vector<Voice> voices_;        // Fixed pool of 128 voices (one per MIDI note)
-    std::vector<Voice*> activeVoices_; // Pointers to currently active voices
-    std::vector<Voice*> voicesToRemove_; // Cleanup buffer for RT processing
+    VoiceBitmask activeVoiceMask_;     // Voices in any non-idle state (bit = MIDI note)
+    VoiceBitmask sustainingVoiceMask_; // Subset of active voices in Sustaining state
+    VoiceBitmask releasingVoiceMask_;  // Subset of active voices in Releasing state
+    VoiceRenderBatch renderBatch_;     // SoA hot state of active voices for current segment
+    VoiceRenderPool renderPool_;       // Deterministic (optionally multi-core) batch mixer
     
     mutable std::atomic<int> activeVoicesCount_{0}; // Thread-safe active voice counter
     std::atomic<bool> rtMode_{false};               // RT mode flag
 
+    // ===== CROSS-THREAD COMMANDS =====
+
+    static constexpr size_t COMMAND_QUEUE_SIZE = 1024;
+    CommandQueue<MidiEvent, COMMAND_QUEUE_SIZE> commandQueue_; // Řídicí vlákna → audio thread
+
     // ===== SUSTAIN PEDAL STATE =====
     
     /**
@@ -532,6 +786,33 @@ private:
      */
     std::array<bool, 128> delayedNoteOffs_{};
 
+    // ===== MULTI-TIMBRAL STATE =====
+
+    static constexpr int16_t NO_VOICE = -1;   // Nota partu nemá přidělený hlas
+    static constexpr uint8_t NO_PART = 0xFF;  // Hlas nepatří žádnému partu
+
+    /**
+     * @brief Parametry a vlastnictví hlasů jednoho partu
+     *
+     * noteVoice je jen nápověda - platí, pokud hlas stále patří partu a hraje
+     * stejnou notu (voicePart_ + Voice::getMidiNote()). Ukradený hlas tak
+     * mapu původního partu zneplatní bez dalšího úklidu.
+     */
+    struct PartState {
+        Envelope envelope;                       // Obálka sdílená hlasy partu
+        VoiceParams params;                      // Master gain, pan, stereo field partu
+        bool sustainPedalActive = false;         // CC64 partu (pouze audio thread)
+        std::array<bool, 128> delayedNoteOffs{}; // Odložené note-off partu
+        std::array<int16_t, 128> noteVoice{};    // MIDI nota → index hlasu (NO_VOICE = žádný)
+        int maxVoices = 0;                       // Polyfonie partu (0 = bez limitu, celý pool)
+    };
+
+    int partCount_;                                 // 1 = klasický režim
+    std::array<PartState, ITHACA_MAX_PARTS> parts_; // Sady parametrů partů
+    std::array<uint8_t, 128> voicePart_{};          // Vlastník hlasu (NO_PART = klasický/volný)
+    std::array<uint64_t, 128> voiceNoteOnOrder_{};  // Pořadí posledního note-on hlasu (krádež nejstaršího)
+    uint64_t noteOnCounter_;                        // Čítač note-on v multi-timbral režimu
+
     // ===== LFO PANNING STATE =====
 
     float panSpeed_;                   // Current interpolated LFO frequency in Hz (0.0-2.0)
@@ -539,20 +820,30 @@ private:
     float panDepth_;                   // Current interpolated LFO depth (0.0-1.0)
     float panDepthTarget_;             // Target LFO depth from MIDI (0.0-1.0)
     float panSmoothingTime_;           // Smoothing time for both speed and depth (default: 0.5s)
-    float lfoPhase_;                   // Current LFO phase (0.0-2π)
-    std::vector<float> lfoPanBuffer_;  // Pre-calculated per-sample pan values
+    uint32_t lfoPhase_;                // Current LFO phase, fixed-point (2^32 = 2π)
+
+    // ===== INTERNAL SUB-BLOCKS =====
+
+    static constexpr int SUB_BLOCK_SIZE = ITHACA_INTERNAL_BLOCK_SIZE;  // Pevný vnitřní blok renderu
+
+    std::vector<float> scratchLeft_;   // Planární scratch jednoho sub-bloku pro processBlockInterleaved (L)
+    std::vector<float> scratchRight_;  // Planární scratch jednoho sub-bloku pro processBlockInterleaved (R)
 
-    // Členy pro vyhlazování LFO panningu
-    float previousPanLeft_ = 1.0f;      // Předchozí gain levého kanálu
-    float previousPanRight_ = 1.0f;     // Předchozí gain pravého kanálu
-    static constexpr float LFO_SMOOTHING = 0.995f; // Konstanta pro exponenciální vyhlazování
+    // Členy pro rampy LFO panningu
+    float previousPanLeft_ = 1.0f;      // Gain levého kanálu na konci posledního bloku
+    float previousPanRight_ = 1.0f;     // Gain pravého kanálu na konci posledního bloku
+    static constexpr int LFO_RAMP_SAMPLES = 64;  // Délka lineární rampy gainů (block-rate krok LFO)
 
     // ===== DSP EFFECTS CHAIN =====
 
-    DspChain dspChain_;                // DSP effects chain (serial processing)
+    StaticDspChain<BBEProcessor, Limiter> masterChain_;  // Pevný master řetězec BBE → Limiter (bez virtual dispatch)
+    DspChain dspChain_;                // Dynamické efekty za běhu (před master řetězcem)
     BBEProcessor* bbeEffect_;          // Quick pointer k BBE procesoru (convenience)
     Limiter* limiterEffect_;           // Quick pointer k limiteru (convenience)
 
+    CpuMeter voiceRenderMeter_;                        // CPU čas renderVoices() (obálky + mix)
+    std::atomic<bool> cpuProfilingEnabled_{false};     // Měření CPU zapnuto
+
     // ===== PRIVATE HELPER METHODS =====
     
     /**
@@ -567,6 +858,45 @@ private:
      * @return true if reinitialization required
      */
     bool needsReinitialization(int targetSampleRate) const noexcept;
+
+    /**
+     * @brief Set shared master gain without validation logging (O(1))
+     * @param midi_gain Master gain as MIDI value (0-127)
+     * @note RT-safe: shared by setAllVoicesMasterGainMIDI and MIDI event dispatch
+     */
+    void applyMasterGainMIDI(uint8_t midi_gain) noexcept;
+
+    /**
+     * @brief Render vynulovaného segmentu libovolné délky po sub-blocích
+     *        SUB_BLOCK_SIZE (viz renderSubBlock())
+     * @return true pokud je nějaký hlas aktivní
+     * @note RT-safe, buffer musí být vynulován
+     */
+    bool renderSegment(float* outputLeft, float* outputRight, int samplesPerBlock) noexcept;
+
+    /**
+     * @brief Hlasy + finalizeBlock() nad jedním sub-blokem s idle fast path
+     *        (bez hlasů: jen posun LFO, DSP jen dokud doznívá)
+     * @param samplesPerBlock Délka sub-bloku (≤ SUB_BLOCK_SIZE)
+     * @return true pokud je nějaký hlas aktivní
+     * @note RT-safe, buffer musí být vynulován
+     */
+    bool renderSubBlock(float* outputLeft, float* outputRight, int samplesPerBlock) noexcept;
+
+    /**
+     * @brief Akumuluje aktivní hlasy do jednoho sub-bloku (batch prepare → render)
+     * @param samplesPerBlock Délka sub-bloku (≤ SUB_BLOCK_SIZE - gain buffer hlasu)
+     * @return true pokud je nějaký hlas aktivní
+     * @note RT-safe, buffer NENÍ nulován
+     */
+    bool renderVoices(float* outputLeft, float* outputRight, int samplesPerBlock) noexcept;
+
+    /**
+     * @brief Proloží planární L/R do [L0,R0,L1,R1,...]
+     * @note RT-safe, kernel vybraný SimdDispatch podle CPU
+     */
+    static void interleaveStereo(const float* left, const float* right, float* interleaved,
+                                 int numSamples) noexcept;
     
     /**
      * @brief Reinitialize system if sample rate changed
@@ -609,15 +939,86 @@ private:
         return (midiNote <= 127) && delayedNoteOffs_[midiNote];
     }
 
+    // ===== MULTI-TIMBRAL HELPERS =====
+
+    /**
+     * @brief Nastaví part na výchozí parametry a zruší jeho mapu not
+     * @note RT-safe, obálku naváže na currentSampleRate_
+     */
+    void resetPartState(PartState& state) noexcept;
+
+    /**
+     * @brief Převezme attack/release/sustain z bloku parametrů do obálky
+     * @note RT-safe, volá audio thread na začátku sub-bloku (renderVoices())
+     */
+    static void syncEnvelope(Envelope& envelope, const VoiceParams& params) noexcept;
+
+    /**
+     * @brief Hlas přidělený notě partu, -1 pokud žádný (nebo byl mezitím ukraden)
+     */
+    int findPartVoice(uint8_t part, uint8_t midiNote) const noexcept;
+
+    /**
+     * @brief Přidělí notě partu hlas ze sdíleného poolu a naváže jej na part
+     * @return Index hlasu, -1 pokud není načtena banka
+     * @note RT-safe: volný hlas, jinak nejstarší releasing → sustaining → libovolný
+     *       aktivní; part na limitu polyfonie krade jen své hlasy
+     */
+    int allocatePartVoice(uint8_t part, uint8_t midiNote) noexcept;
+
+    /**
+     * @brief Nejstarší hlas z množiny podle pořadí note-on
+     * @param candidates Kandidáti (maska hlasů)
+     * @param part Jen hlasy tohoto partu (NO_PART = libovolný vlastník)
+     * @return Index hlasu, -1 pokud žádný kandidát nevyhovuje
+     */
+    int findOldestVoice(const VoiceBitmask& candidates, uint8_t part) const noexcept;
+
+    /**
+     * @brief Odešle odložené note-off partu po uvolnění jeho pedálu
+     */
+    void processPartDelayedNoteOffs(uint8_t part) noexcept;
+
     // ===== LFO PANNING HELPERS =====
 
     /**
-     * @brief Apply LFO panning per-sample to eliminate zipper noise
-     * @param samplesPerBlock Number of samples in current block
-     * @note RT-safe: updates LFO phase and pan for each sample independently
-     * @note Per-sample processing ensures smooth panning at high depth/speed values
+     * @brief Zjistí, zda je LFO stage v bypassu (nulová depth, rampa ve středu)
+     * @param centerLeft Výstup: gain levého kanálu ve středu panoramy
+     * @param centerRight Výstup: gain pravého kanálu ve středu panoramy
+     */
+    bool isLfoPanBypassed(float& centerLeft, float& centerRight) const noexcept;
+
+    /**
+     * @brief V bypassu posune jen speed a fázi LFO o numSamples vzorků
+     */
+    void advanceLfoPhase(int numSamples) noexcept;
+
+    /**
+     * @brief Jeden block-rate krok LFO: vyhlazení speed/depth, posun fáze a gainy na konci segmentu
+     * @param count Délka segmentu (nejvýše LFO_RAMP_SAMPLES)
+     * @param targetLeft Výstup: gain levého kanálu na konci segmentu
+     * @param targetRight Výstup: gain pravého kanálu na konci segmentu
+     */
+    void stepLfoSegment(int count, float& targetLeft, float& targetRight) noexcept;
+
+    /**
+     * @brief Posune stav LFO panningu bez zápisu do bufferu (tichý blok)
+     * @param numSamples Počet vzorků
+     * @note Stav je shodný, jako by applyLfoPanToFinalMix() zpracoval nulový blok
+     */
+    void advanceLfoPan(int numSamples) noexcept;
+
+    /**
+     * @brief Krok vyhlazení speed/depth na vzorek (stejný pro oba parametry)
+     */
+    float lfoSmoothingStep() const noexcept {
+        return (currentSampleRate_ > 0) ? (1.0f / (panSmoothingTime_ * currentSampleRate_)) : 0.0f;
+    }
+
+    /**
+     * @brief Posune hodnotu k cíli o nejvýše step (lineární vyhlazení speed/depth)
      */
-    void applyLfoPanningPerSample(int samplesPerBlock) noexcept;
+    static float stepTowards(float current, float target, float step) noexcept;
 
     /**
      * @brief Reset LFO parameters to default values
@@ -629,23 +1030,24 @@ private:
     
     /**
      * @brief Add voice to active pool
-     * @param voice Pointer to voice to add
-     * @note RT-safe: updates atomic counter
+     * @param index Voice index (= MIDI note)
+     * @note RT-safe: O(1) bit set, updates atomic counter
      */
-    void addActiveVoice(Voice* voice) noexcept;
+    void addActiveVoice(int index) noexcept;
     
     /**
-     * @brief Remove voice from active pool using swap-and-pop optimization
-     * @param voice Pointer to voice to remove
-     * @note RT-safe: O(1) operation, updates atomic counter
+     * @brief Remove voice from active, sustaining and releasing sets
+     * @param index Voice index (= MIDI note)
+     * @note RT-safe: O(1) bit clear, updates atomic counter
      */
-    void removeActiveVoice(Voice* voice) noexcept;
+    void removeActiveVoice(int index) noexcept;
     
     /**
-     * @brief Clean up voices marked for removal
-     * @note RT-safe: processes voicesToRemove_ buffer
+     * @brief Sync sustaining/releasing bits with current voice state
+     * @param index Voice index (= MIDI note)
+     * @note RT-safe: called after note events and after each processed voice
      */
-    void cleanupInactiveVoices() noexcept;
+    void updateVoiceStateMask(int index) noexcept;
 
     /**
      * @brief Validate MIDI note range
@@ -0,0 +1,63 @@
+#ifndef VOICE_PARAMS_H
+#define VOICE_PARAMS_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @file voice_params.h
+ * @brief Sdílený blok parametrů hlasů (master gain, statický pan, stereo field, obálka)
+ *
+ * Jeden blok drží VoiceManager pro celý voice pool (klasický režim) a jeden
+ * každý part (multi-timbral režim). Hlasy jsou na blok navázané ukazatelem
+ * (Voice::bindParameters()) a čtou ho na začátku každého sub-bloku:
+ * - změna parametru = jeden atomický zápis, O(1) bez ohledu na počet hlasů
+ * - hlas se k nové hodnotě dostane vyhlazeně (ITHACA_VOICE_PARAM_SMOOTHING_MS),
+ *   nová nota ji převezme okamžitě
+ * - per-voice override (Voice::setPan() apod.) má přednost před blokem
+ * - attack/release/sustain převezme VoiceManager na začátku sub-bloku do obálky
+ *   (Envelope), kterou hlasy bloku sdílejí
+ *
+ * Hodnoty jsou na sobě nezávislé - každá se publikuje samostatně (relaxed),
+ * zapisovat lze z libovolného threadu.
+ */
+struct VoiceParams {
+    std::atomic<float> masterGain{1.0f};          // Master gain (0.0-1.0)
+    std::atomic<float> pan{0.0f};                 // Statický pan (-1.0 až +1.0)
+    std::atomic<uint8_t> stereoFieldAmount{0};    // Stereo field (MIDI 0-127)
+    std::atomic<uint8_t> attackMIDI{0};           // Attack obálky (MIDI 0-127)
+    std::atomic<uint8_t> releaseMIDI{16};         // Release obálky (MIDI 0-127)
+    std::atomic<uint8_t> sustainMIDI{127};        // Sustain úroveň obálky (MIDI 0-127)
+
+    void setMasterGain(float gain) noexcept { masterGain.store(gain, std::memory_order_relaxed); }
+    void setPan(float value) noexcept { pan.store(value, std::memory_order_relaxed); }
+    void setStereoFieldAmountMIDI(uint8_t midiValue) noexcept {
+        stereoFieldAmount.store(midiValue, std::memory_order_relaxed);
+    }
+    void setAttackMIDI(uint8_t midiValue) noexcept { attackMIDI.store(midiValue, std::memory_order_relaxed); }
+    void setReleaseMIDI(uint8_t midiValue) noexcept { releaseMIDI.store(midiValue, std::memory_order_relaxed); }
+    void setSustainLevelMIDI(uint8_t midiValue) noexcept { sustainMIDI.store(midiValue, std::memory_order_relaxed); }
+
+    float getMasterGain() const noexcept { return masterGain.load(std::memory_order_relaxed); }
+    float getPan() const noexcept { return pan.load(std::memory_order_relaxed); }
+    uint8_t getStereoFieldAmountMIDI() const noexcept {
+        return stereoFieldAmount.load(std::memory_order_relaxed);
+    }
+    uint8_t getAttackMIDI() const noexcept { return attackMIDI.load(std::memory_order_relaxed); }
+    uint8_t getReleaseMIDI() const noexcept { return releaseMIDI.load(std::memory_order_relaxed); }
+    uint8_t getSustainLevelMIDI() const noexcept { return sustainMIDI.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Výchozí hodnoty (gain 1.0, střed, stereo field vypnutý, obálka dle Voice::initialize())
+     */
+    void reset() noexcept {
+        setMasterGain(1.0f);
+        setPan(0.0f);
+        setStereoFieldAmountMIDI(0);
+        setAttackMIDI(0);
+        setReleaseMIDI(16);
+        setSustainLevelMIDI(127);
+    }
+};
+
+#endif // VOICE_PARAMS_H
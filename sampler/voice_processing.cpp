@@ -8,6 +8,7 @@
 
 #include "IthacaConfig.h"
 #include "voice.h"
+#include "common/simd_dispatch.h"
 
 // ===== DEBUG CONTROL =====
 #define VOICE_DEBUG_ENABLED 0
@@ -31,74 +32,132 @@ bool Voice::processBlock(float* outputLeft, float* outputRight, int samplesPerBl
     // Zpracovává damping buffer (pokud je aktivní) a hlavní hlas.
     // =====================================================================
     
-    // FÁZE 1: ZPRACOVÁNÍ DAMPING BUFFERU (pokud je retrigger aktivní)
-    if (dampingActive_) {
-        const int dampingSamplesRemaining = dampingLength_ - dampingPosition_;
-        const int dampingSamplesToProcess = std::min(samplesPerBlock, dampingSamplesRemaining);
-        
-        for (int i = 0; i < dampingSamplesToProcess; ++i) {
-            const int bufferIndex = dampingPosition_ + i;
-            outputLeft[i] += dampingBufferLeft_[bufferIndex];
-            outputRight[i] += dampingBufferRight_[bufferIndex];
-        }
-        
-        dampingPosition_ += dampingSamplesToProcess;
-        
-        if (dampingPosition_ >= dampingLength_) {
-            dampingActive_ = false;
-            dampingPosition_ = 0;
+    if (!outputLeft || !outputRight) {
+        return false;
+    }
+
+    // Gain buffer pojme jeden sub-blok - delší bloky po částech (libovolná délka)
+    bool voiceActive = false;
+
+    for (int offset = 0; offset < samplesPerBlock; offset += ITHACA_INTERNAL_BLOCK_SIZE) {
+        const int chunk = std::min(ITHACA_INTERNAL_BLOCK_SIZE, samplesPerBlock - offset);
+        float* left = outputLeft + offset;
+        float* right = outputRight + offset;
+
+        // FÁZE 1: ZPRACOVÁNÍ DAMPING BUFFERU (pokud je retrigger aktivní)
+        mixDampingBlock(left, right, chunk);
+
+        // FÁZE 2: ZPRACOVÁNÍ HLAVNÍHO HLASU
+        const float* stereoBuffer = nullptr;
+        int samplesToProcess = 0;
+        voiceActive = advanceEnvelopeBlock(chunk, stereoBuffer, samplesToProcess);
+
+        if (stereoBuffer) {
+            // Aplikace gainů na audio bez LFO panningu
+            processAudioWithGains(left, right, stereoBuffer, samplesToProcess);
         }
     }
+
+    return voiceActive;
+}
+
+// =====================================================================
+// BATCH RENDERING (SoA)
+// =====================================================================
+
+void Voice::mixDampingBlock(float* outputLeft, float* outputRight, int samplesPerBlock) noexcept {
+    if (!dampingActive_) return;
+
+    const int dampingSamplesRemaining = dampingLength_ - dampingPosition_;
+    const int dampingSamplesToProcess = std::min(samplesPerBlock, dampingSamplesRemaining);
     
-    // FÁZE 2: ZPRACOVÁNÍ HLAVNÍHO HLASU
-    if (!isVoiceReady() || state_ == VoiceState::Idle) {
-        return false;
+    for (int i = 0; i < dampingSamplesToProcess; ++i) {
+        const int bufferIndex = dampingPosition_ + i;
+        outputLeft[i] += dampingBufferLeft_[bufferIndex];
+        outputRight[i] += dampingBufferRight_[bufferIndex];
     }
     
-    if (!outputLeft || !outputRight || samplesPerBlock <= 0) {
+    dampingPosition_ += dampingSamplesToProcess;
+    
+    if (dampingPosition_ >= dampingLength_) {
+        dampingActive_ = false;
+        dampingPosition_ = 0;
+    }
+}
+
+bool Voice::prepareRenderBlock(int samplesPerBlock, VoiceRenderBatch& batch) noexcept {
+    const float* stereoBuffer = nullptr;
+    int samplesToProcess = 0;
+    const bool voiceActive = advanceEnvelopeBlock(samplesPerBlock, stereoBuffer, samplesToProcess);
+
+    if (stereoBuffer && batch.count < ITHACA_MAX_VOICES) {
+        const int slot = batch.count++;
+        batch.source[slot] = stereoBuffer;
+        batch.envelopeGains[slot] = gainBuffer_.data();
+        batch.frames[slot] = samplesToProcess;
+        batch.gainLeft[slot] = channelGainStartLeft_;
+        batch.gainRight[slot] = channelGainStartRight_;
+        batch.gainStepLeft[slot] = channelGainStepLeft_;
+        batch.gainStepRight[slot] = channelGainStepRight_;
+    }
+
+    return voiceActive;
+}
+
+bool Voice::advanceEnvelopeBlock(int samplesPerBlock, const float*& stereoBuffer,
+                                 int& samplesToProcess) noexcept {
+    stereoBuffer = nullptr;
+    samplesToProcess = 0;
+
+    if (!isVoiceReady() || state_ == VoiceState::Idle || samplesPerBlock <= 0) {
         return false;
     }
     
-    const float* stereoBuffer = instrument_->get_sample_begin_pointer(currentVelocityLayer_);
+    const float* sampleData = instrument_->get_sample_begin_pointer(currentVelocityLayer_);
     const int maxFrames = instrument_->get_frame_count(currentVelocityLayer_);
 
-    if (!stereoBuffer || maxFrames == 0) {
+    if (!sampleData || maxFrames == 0) {
         state_ = VoiceState::Idle;
         return false;
     }
     
+    // Volající dělí bloky na sub-bloky (gain buffer má pevnou velikost)
     const int samplesUntilEnd = maxFrames - position_;
-    const int samplesToProcess = std::min(samplesPerBlock, samplesUntilEnd);
-    
-    // Zajištění kapacity gain bufferu
-    if (gainBuffer_.size() < static_cast<size_t>(samplesToProcess)) {
-        gainBuffer_.resize(samplesToProcess);
-    }
+    const int frames = std::min(std::min(samplesPerBlock, ITHACA_INTERNAL_BLOCK_SIZE), samplesUntilEnd);
+
+    // Sdílené parametry jednou za sub-blok, kanálové gainy jako rampa po vzorcích
+    syncParameters(frames);
 
     bool voiceActive = false;
 
     // Zpracování podle stavu obálky
     switch (state_) {
         case VoiceState::Attacking:
-            voiceActive = processAttackPhase(gainBuffer_.data(), samplesToProcess);
+            voiceActive = processAttackPhase(gainBuffer_.data(), frames);
             break;
         case VoiceState::Sustaining:
-            voiceActive = processSustainPhase(gainBuffer_.data(), samplesToProcess);
+            voiceActive = processSustainPhase(gainBuffer_.data(), frames);
             break;
         case VoiceState::Releasing:
-            voiceActive = processReleasePhase(gainBuffer_.data(), samplesToProcess);
+            voiceActive = processReleasePhase(gainBuffer_.data(), frames);
             break;
         case VoiceState::Idle:
             return false;
     }
 
+    int framesToMix = frames;
+    bool audible = true;
+
     if (voiceActive) {
-        // Aplikace gainů na audio bez LFO panningu
-        processAudioWithGains(outputLeft, outputRight, stereoBuffer, samplesToProcess);
-        position_ += samplesToProcess;
+        // Odhad úrovně, případně micro-fade neslyšitelného hlasu (může zkrátit blok)
+        audible = processAudibility(gainBuffer_.data(), framesToMix);
+
+        stereoBuffer = sampleData + position_ * 2; // Konverze na stereo frame index
+        samplesToProcess = framesToMix;
+        position_ += framesToMix;
     }
 
-    if (position_ >= maxFrames) {
+    if (!audible || position_ >= maxFrames) {
         state_ = VoiceState::Idle;
         return false;
     }
@@ -106,6 +165,51 @@ bool Voice::processBlock(float* outputLeft, float* outputRight, int samplesPerBl
     return voiceActive;
 }
 
+bool Voice::processAudibility(float* gainBuffer, int& frames) noexcept {
+#if ITHACA_ENABLE_VOICE_AUDIBILITY_CULLING
+    // ===== ESTIMATE OUTPUT LEVEL =====
+
+    // Horní mez obálky v bloku: release klesá (první vzorek), sustain je konstantní.
+    // Master gain (a jeho vyhlazení) se nezapočítává - dočasné ztlumení přes 0
+    // nesmí ukončit držené noty, po návratu gainu by zůstaly umlčené.
+    const float envelopePeak = std::max(gainBuffer[0], envelope_gain_);
+    outputLevelEstimate_ = instrument_->get_tail_peak(currentVelocityLayer_, position_) *
+                           envelopePeak * velocity_gain_;
+
+    // ===== START RETIREMENT =====
+
+    // Attack nikdy - obálka ještě roste
+    if (!retiring_ && state_ != VoiceState::Attacking &&
+        outputLevelEstimate_ < audibilityThreshold_) {
+        retiring_ = true;
+        retireFadePosition_ = 0;
+    }
+
+    if (!retiring_) {
+        return true;
+    }
+
+    // ===== APPLY MICRO-FADE =====
+
+    const int fadeRemaining = retireFadeLength_ - retireFadePosition_;
+    const int fadeFrames = std::min(frames, fadeRemaining);
+    const float invLength = 1.0f / static_cast<float>(retireFadeLength_);
+
+    for (int i = 0; i < fadeFrames; ++i) {
+        gainBuffer[i] *= 1.0f - static_cast<float>(retireFadePosition_ + i + 1) * invLength;
+    }
+
+    retireFadePosition_ += fadeFrames;
+    frames = fadeFrames;
+
+    return retireFadePosition_ < retireFadeLength_;
+#else
+    (void)gainBuffer;
+    (void)frames;
+    return true;
+#endif
+}
+
 // =====================================================================
 // ENVELOPE GAIN CALCULATION
 // =====================================================================
@@ -120,9 +224,9 @@ bool Voice::calculateBlockGains(float* gainBuffer, int numSamples) noexcept {
     // ===== BUFFER OVERFLOW PROTECTION =====
 
     // Critical error must be visible even in RT context
-    if (static_cast<size_t>(numSamples) > gainBuffer_.capacity()) {
+    if (static_cast<size_t>(numSamples) > gainBuffer_.size()) {
         std::cerr << "[Voice/calculateBlockGains] error: Buffer overflow - requested "
-                  << numSamples << " samples, capacity " << gainBuffer_.capacity() << std::endl;
+                  << numSamples << " samples, size " << gainBuffer_.size() << std::endl;
         return false; // Fail gracefully but visibly
     }
     
@@ -152,8 +256,8 @@ bool Voice::processAttackPhase(float* gainBuffer, int numSamples) noexcept {
     
     // ===== GET ATTACK GAINS FROM ENVELOPE =====
     
-    bool attackContinues = envelope_->getAttackGains(gainBuffer, numSamples, 
-                                                   envelope_attack_position_, sampleRate_);
+    bool attackContinues = envelope_->getAttackGains(gainBuffer, numSamples,
+                                                   envelope_attack_position_);
     
     envelope_attack_position_ += numSamples;
     
@@ -209,8 +313,8 @@ bool Voice::processReleasePhase(float* gainBuffer, int numSamples) noexcept {
     
     // ===== GET RELEASE GAINS FROM ENVELOPE =====
     
-    bool releaseContinues = envelope_->getReleaseGains(gainBuffer, numSamples, 
-                                                     envelope_release_position_, sampleRate_);
+    bool releaseContinues = envelope_->getReleaseGains(gainBuffer, numSamples,
+                                                     envelope_release_position_);
 
     // ===== SCALE RELEASE GAINS TO MATCH START LEVEL =====
     
@@ -247,37 +351,49 @@ void Voice::processAudioWithGains(float* outputLeft, float* outputRight,
     // =====================================================================
     // Aplikuje gainy (envelope, velocity, statický panning, stereo field, master)
     // na stereo vzorky a mixuje je do výstupních bufferů.
+    // stereoBuffer už ukazuje na začátek bloku (viz advanceEnvelopeBlock()),
+    // kanálové gainy připravil syncParameters() jako rampu sub-bloku.
     // =====================================================================
 
-    const int startIndex = position_ * 2; // Konverze na stereo frame index
-    const float* srcPtr = stereoBuffer + startIndex;
+    mixSamples(outputLeft, outputRight, stereoBuffer, gainBuffer_.data(),
+               channelGainStartLeft_, channelGainStartRight_,
+               channelGainStepLeft_, channelGainStepRight_, samplesToProcess);
+}
 
-    // =====================================================================
+void Voice::calculateChannelGains(float& leftGain, float& rightGain) noexcept {
     // Výpočet statických panning gainů
-    // =====================================================================
     float pan_left_gain, pan_right_gain;
     calculatePanGains(pan_, pan_left_gain, pan_right_gain);
 
-    // =====================================================================
-    // Zpracování každého vzorku
-    // =====================================================================
-    for (int i = 0; i < samplesToProcess; ++i) {
-        const int srcIndex = i * 2;
-    
-        // =====================================================================    
-        // Kombinace všech gainů: envelope * velocity * panning * master * stereo field
-        // =====================================================================
-        outputLeft[i] += srcPtr[srcIndex] * gainBuffer_[i] * velocity_gain_ *
-                         pan_left_gain * master_gain_ * stereoFieldGainLeft_;
-        
-        #if DEBUG_ENVELOPE_TO_RIGHT_CHANNEL
-        outputRight[i] += gainBuffer_[i] * velocity_gain_ *
-                         pan_left_gain * master_gain_ * stereoFieldGainLeft_;
-        #else
-        outputRight[i] += srcPtr[srcIndex + 1] * gainBuffer_[i] * velocity_gain_ *
-                          pan_right_gain * master_gain_ * stereoFieldGainRight_;
-        #endif
+    // Kombinace blokově konstantních gainů: velocity * panning * master * stereo field
+    leftGain = velocity_gain_ * pan_left_gain * master_gain_ * stereoFieldGainLeft_;
+    rightGain = velocity_gain_ * pan_right_gain * master_gain_ * stereoFieldGainRight_;
+}
+
+void Voice::mixSamples(float* outputLeft, float* outputRight, const float* stereoSource,
+                       const float* envelopeGains, float leftGain, float rightGain,
+                       float leftStep, float rightStep, int numSamples) noexcept {
+    #if DEBUG_ENVELOPE_TO_RIGHT_CHANNEL
+    (void)rightGain;
+    (void)rightStep;
+    for (int i = 0; i < numSamples; ++i) {
+        const float gain = envelopeGains[i];
+        const float channelGain = leftGain + leftStep * static_cast<float>(i + 1);
+        outputLeft[i] += stereoSource[i * 2] * gain * channelGain;
+        outputRight[i] += gain * channelGain;
+    }
+    #else
+    // SIMD varianta vybraná podle CPU (SSE2 / AVX2 / AVX-512 / NEON);
+    // rampa jen během změny parametrů, ustálený hlas mixuje konstantním gainem
+    const SimdDispatch::Kernels& kernels = SimdDispatch::kernels();
+    if (leftStep == 0.0f && rightStep == 0.0f) {
+        kernels.mixStereo(outputLeft, outputRight, stereoSource, envelopeGains,
+                          leftGain, rightGain, numSamples);
+    } else {
+        kernels.mixStereoRamp(outputLeft, outputRight, stereoSource, envelopeGains,
+                              leftGain, rightGain, leftStep, rightStep, numSamples);
     }
+    #endif
 }
 
 // =====================================================================
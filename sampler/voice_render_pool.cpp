@@ -0,0 +1,214 @@
+#include "voice_render_pool.h"
+#include "common/denormal_guard.h"
+#include "common/thread_wait.h"
+
+#include <algorithm>
+#include <string>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// ===== CONSTRUCTION =====
+
+VoiceRenderPool::VoiceRenderPool()
+    : laneLeft_(static_cast<size_t>(LANES) * LANE_SAMPLES, 0.0f),
+      laneRight_(static_cast<size_t>(LANES) * LANE_SAMPLES, 0.0f),
+      jobBatch_(nullptr),
+      jobOffset_(0),
+      jobSamples_(0),
+      jobLaneCount_(0),
+      workers_(),
+      threadCount_(1),
+      generation_(0),
+      workersDone_(0),
+      sleepingWorkers_(0),
+      running_(false) {
+}
+
+VoiceRenderPool::~VoiceRenderPool() {
+    stop();
+}
+
+// ===== THREAD MANAGEMENT =====
+
+void VoiceRenderPool::start(int numThreads, Logger& logger) {
+    stop();
+
+    const int requested = numThreads;
+    numThreads = std::max(1, std::min(numThreads, LANES));
+    if (numThreads != requested) {
+        logger.log("VoiceRenderPool/start", LogSeverity::Warning,
+                   "Requested " + std::to_string(requested) + " render threads, clamped to " +
+                   std::to_string(numThreads) + " (ITHACA_RENDER_LANES = " + std::to_string(LANES) + ")");
+    }
+
+    threadCount_ = numThreads;
+    if (threadCount_ == 1) {
+        logger.log("VoiceRenderPool/start", LogSeverity::Info,
+                   "Voice rendering in single-threaded mode");
+        return;
+    }
+
+    // Výchozí generace se předá workerům předem - vlákno se může rozběhnout až po
+    // prvním render(), ten by jinak považovalo za už viděný a nikdy ho nepotvrdilo
+    running_.store(true, std::memory_order_release);
+    const uint32_t startGeneration = generation_.load(std::memory_order_acquire);
+    workers_.reserve(threadCount_ - 1);
+    for (int i = 1; i < threadCount_; ++i) {
+        workers_.emplace_back(&VoiceRenderPool::workerLoop, this, i, startGeneration);
+        configureWorkerThread(workers_.back(), i);
+    }
+
+    logger.log("VoiceRenderPool/start", LogSeverity::Info,
+               "Voice rendering on " + std::to_string(threadCount_) + " threads (" +
+               std::to_string(LANES) + " deterministic mix lanes)");
+}
+
+void VoiceRenderPool::stop() noexcept {
+    if (!workers_.empty()) {
+        running_.store(false, std::memory_order_release);
+        generation_.fetch_add(1, std::memory_order_seq_cst);  // Probudit čekající workery
+        wakeAll(generation_);
+
+        for (std::thread& worker : workers_) {
+            if (worker.joinable()) worker.join();
+        }
+        workers_.clear();
+    }
+    threadCount_ = 1;
+}
+
+void VoiceRenderPool::configureWorkerThread(std::thread& thread, int workerIndex) noexcept {
+#if defined(__linux__)
+    const unsigned hardwareThreads = std::thread::hardware_concurrency();
+    if (hardwareThreads > 1) {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(static_cast<int>(workerIndex % hardwareThreads), &cpuSet);
+        pthread_setaffinity_np(thread.native_handle(), sizeof(cpuSet), &cpuSet);
+    }
+
+    // SCHED_FIFO vyžaduje oprávnění - bez nich zůstane výchozí plánování
+    sched_param param{};
+    param.sched_priority = sched_get_priority_min(SCHED_FIFO) + 1;
+    pthread_setschedparam(thread.native_handle(), SCHED_FIFO, &param);
+#else
+    (void)thread;
+    (void)workerIndex;
+#endif
+}
+
+// ===== RENDERING =====
+
+void VoiceRenderPool::render(const VoiceRenderBatch& batch, float* outputLeft, float* outputRight,
+                             int numSamples) noexcept {
+    if (batch.count == 0 || numSamples <= 0) return;
+
+    const int laneCount = std::min(batch.count, LANES);
+    const bool parallel = threadCount_ > 1 && batch.count >= VOICE_RENDER_POOL_MIN_PARALLEL_VOICES;
+
+    for (int offset = 0; offset < numSamples; offset += LANE_SAMPLES) {
+        const int chunk = std::min(LANE_SAMPLES, numSamples - offset);
+
+        jobBatch_ = &batch;
+        jobOffset_ = offset;
+        jobSamples_ = chunk;
+        jobLaneCount_ = laneCount;
+
+        if (parallel) {
+            // Každý worker potvrdí každou generaci - žádný nemůže úlohu přeskočit
+            workersDone_.store(0, std::memory_order_relaxed);
+            generation_.fetch_add(1, std::memory_order_seq_cst);
+
+            // Syscall jen pokud některý worker už usnul (jinak stále spinuje)
+            if (sleepingWorkers_.load(std::memory_order_seq_cst) > 0) {
+                wakeAll(generation_);
+            }
+
+            renderAssignedLanes(0);
+
+            const int otherWorkers = threadCount_ - 1;
+            int spins = 0;
+            while (workersDone_.load(std::memory_order_acquire) < otherWorkers) {
+                if (++spins > VOICE_RENDER_POOL_SPIN_COUNT) {
+                    std::this_thread::yield();
+                    spins = 0;
+                }
+            }
+        } else {
+            for (int lane = 0; lane < laneCount; ++lane) {
+                renderLane(lane);
+            }
+        }
+
+        // Redukce v pevném pořadí lanes (nezávislé na počtu vláken)
+        float* outL = outputLeft + offset;
+        float* outR = outputRight + offset;
+        for (int lane = 0; lane < laneCount; ++lane) {
+            const float* laneL = laneLeft_.data() + static_cast<size_t>(lane) * LANE_SAMPLES;
+            const float* laneR = laneRight_.data() + static_cast<size_t>(lane) * LANE_SAMPLES;
+            for (int i = 0; i < chunk; ++i) {
+                outL[i] += laneL[i];
+                outR[i] += laneR[i];
+            }
+        }
+    }
+}
+
+void VoiceRenderPool::workerLoop(int workerIndex, uint32_t startGeneration) noexcept {
+    // FTZ/DAZ je stav vlákna - worker si ho nastaví jednou na celou dobu života
+    ScopedDenormalProtection denormalGuard;
+
+    uint32_t seenGeneration = startGeneration;
+
+    while (true) {
+        // Čekání na novou úlohu: krátký spin, pak spánek na futexu
+        int spins = 0;
+        uint32_t current;
+        while ((current = generation_.load(std::memory_order_acquire)) == seenGeneration) {
+            if (++spins > VOICE_RENDER_POOL_SPIN_COUNT) {
+                sleepingWorkers_.fetch_add(1, std::memory_order_seq_cst);
+                waitWhileEqual(generation_, seenGeneration);
+                sleepingWorkers_.fetch_sub(1, std::memory_order_relaxed);
+                spins = 0;
+            }
+        }
+        seenGeneration = current;
+
+        if (!running_.load(std::memory_order_acquire)) return;
+
+        renderAssignedLanes(workerIndex);
+        workersDone_.fetch_add(1, std::memory_order_acq_rel);
+    }
+}
+
+void VoiceRenderPool::renderAssignedLanes(int workerIndex) noexcept {
+    for (int lane = workerIndex; lane < jobLaneCount_; lane += threadCount_) {
+        renderLane(lane);
+    }
+}
+
+void VoiceRenderPool::renderLane(int lane) noexcept {
+    float* laneL = laneLeft_.data() + static_cast<size_t>(lane) * LANE_SAMPLES;
+    float* laneR = laneRight_.data() + static_cast<size_t>(lane) * LANE_SAMPLES;
+    const VoiceRenderBatch& batch = *jobBatch_;
+
+    std::fill(laneL, laneL + jobSamples_, 0.0f);
+    std::fill(laneR, laneR + jobSamples_, 0.0f);
+
+    for (int slot = lane; slot < batch.count; slot += LANES) {
+        const int frames = std::min(batch.frames[slot] - jobOffset_, jobSamples_);
+        if (frames <= 0) continue;
+
+        // Rampa gainů pokračuje od jobOffset_ (sloty jsou nejvýše sub-blok, offset 0)
+        const float offset = static_cast<float>(jobOffset_);
+        Voice::mixSamples(laneL, laneR,
+                          batch.source[slot] + static_cast<size_t>(jobOffset_) * 2,
+                          batch.envelopeGains[slot] + jobOffset_,
+                          batch.gainLeft[slot] + batch.gainStepLeft[slot] * offset,
+                          batch.gainRight[slot] + batch.gainStepRight[slot] * offset,
+                          batch.gainStepLeft[slot], batch.gainStepRight[slot], frames);
+    }
+}
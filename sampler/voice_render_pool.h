@@ -0,0 +1,133 @@
+#ifndef VOICE_RENDER_POOL_H
+#define VOICE_RENDER_POOL_H
+
+#include "IthacaConfig.h"
+#include "voice.h"
+#include "core_logger.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// ===== RENDER POOL CONFIGURATION =====
+// Fallback pro nadřazený IthacaConfig.h bez této volby
+#ifndef ITHACA_RENDER_LANES
+#define ITHACA_RENDER_LANES 4
+#endif
+
+// Minimální počet slotů v batchi, od kterého se vyplatí budit worker vlákna
+#ifndef VOICE_RENDER_POOL_MIN_PARALLEL_VOICES
+#define VOICE_RENDER_POOL_MIN_PARALLEL_VOICES 8
+#endif
+
+// Počet spin iterací před uspáním workeru / yield audio threadu
+#ifndef VOICE_RENDER_POOL_SPIN_COUNT
+#define VOICE_RENDER_POOL_SPIN_COUNT 4096
+#endif
+
+/**
+ * @class VoiceRenderPool
+ * @brief Mix fáze SoA batche s volitelným rozložením na více jader
+ *
+ * Determinismus:
+ * Sloty batche jsou rozděleny do pevného počtu lanes (ITHACA_RENDER_LANES),
+ * slot s → lane (s % ITHACA_RENDER_LANES). Každá lane akumuluje své sloty
+ * od nuly do vlastního bufferu, poté se lanes sečtou do výstupu v pevném
+ * pořadí 0, 1, 2, ... Přiřazení ani pořadí nezávisí na počtu vláken, takže
+ * výstup je bitově shodný v jednovláknovém i vícevláknovém režimu
+ * (a pro jediný hlas shodný s přímým mixem, protože 0 + x == x).
+ *
+ * Vlákna:
+ * - audio thread je vždy "worker 0" a zpracuje svůj podíl lanes
+ * - workers 1..N-1 čekají na nové generation krátkým spinem, pak spí na futexu
+ *   (Linux futex / Windows WaitOnAddress); audio thread budí syscallem jen spící
+ * - každý worker potvrdí každou generaci, audio thread čeká na potvrzení všech
+ * - synchronizace pouze přes atomiky, žádné zámky ani alokace v render()
+ * - na Linuxu best-effort pinning na jádro a SCHED_FIFO (selže-li, ignoruje se)
+ *
+ * @note start()/stop() jsou non-RT (alokace, vytváření vláken)
+ */
+class VoiceRenderPool {
+public:
+    VoiceRenderPool();
+    ~VoiceRenderPool();
+
+    VoiceRenderPool(const VoiceRenderPool&) = delete;
+    VoiceRenderPool& operator=(const VoiceRenderPool&) = delete;
+
+    /**
+     * @brief Spustí worker vlákna
+     * @param numThreads Celkový počet renderovacích vláken včetně audio threadu
+     *                   (1 = jednovláknový režim, max ITHACA_RENDER_LANES)
+     * @param logger Reference na Logger
+     * @note Non-RT: vytváří vlákna. Nevolat souběžně s render().
+     */
+    void start(int numThreads, Logger& logger);
+
+    /**
+     * @brief Zastaví a uvolní worker vlákna (návrat do jednovláknového režimu)
+     * @note Non-RT: join vláken. Nevolat souběžně s render().
+     */
+    void stop() noexcept;
+
+    /**
+     * @brief Přimixuje všechny sloty batche do výstupu (deterministicky)
+     * @param batch Naplněný batch
+     * @param outputLeft Levý výstupní buffer (aditivně)
+     * @param outputRight Pravý výstupní buffer (aditivně)
+     * @param numSamples Délka segmentu
+     * @note RT-safe: bez alokací a zámků
+     */
+    void render(const VoiceRenderBatch& batch, float* outputLeft, float* outputRight,
+                int numSamples) noexcept;
+
+    /**
+     * @brief Počet renderovacích vláken včetně audio threadu
+     */
+    int getThreadCount() const noexcept { return threadCount_; }
+
+private:
+    static constexpr int LANES = ITHACA_RENDER_LANES;
+    static constexpr int LANE_SAMPLES = ITHACA_INTERNAL_BLOCK_SIZE;  // Delší segmenty se zpracují po částech
+
+    // Lane buffery: [lane][sample], levý a pravý kanál zvlášť
+    std::vector<float> laneLeft_;
+    std::vector<float> laneRight_;
+
+    // Aktuální úloha (zapisuje audio thread před zvýšením generation_)
+    const VoiceRenderBatch* jobBatch_;
+    int jobOffset_;
+    int jobSamples_;
+    int jobLaneCount_;
+
+    std::vector<std::thread> workers_;
+    int threadCount_;
+
+    alignas(64) std::atomic<uint32_t> generation_;
+    alignas(64) std::atomic<int> workersDone_;
+    std::atomic<int> sleepingWorkers_;
+    std::atomic<bool> running_;
+
+    /**
+     * @brief Smyčka worker vlákna
+     * @param startGeneration Hodnota generation_ při start() - úlohy od ní dál se potvrzují
+     */
+    void workerLoop(int workerIndex, uint32_t startGeneration) noexcept;
+
+    /**
+     * @brief Zpracuje lanes přidělené danému vláknu (lane % threadCount_ == workerIndex)
+     */
+    void renderAssignedLanes(int workerIndex) noexcept;
+
+    /**
+     * @brief Akumuluje sloty jedné lane do jejího bufferu od nuly
+     */
+    void renderLane(int lane) noexcept;
+
+    /**
+     * @brief Best-effort pinning a RT priorita pro worker vlákno
+     */
+    static void configureWorkerThread(std::thread& thread, int workerIndex) noexcept;
+};
+
+#endif // VOICE_RENDER_POOL_H